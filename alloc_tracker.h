@@ -0,0 +1,160 @@
+/*
+ * Heap allocation tracking
+ * Replaces the global operator new and delete so that, while tracking is on,
+ * every C++ heap allocation made by the tracked (render) thread is counted
+ * against the profiler phase running there. Work on the simulation, epidemic,
+ * steering and loader threads is not charged to the frame that happens to be
+ * open. Warmed-up frames are expected to allocate nothing:
+ * endAllocationFrame() reports one that did, and aborts in debug builds.
+ * Plain malloc calls (libc, the GL driver) are not seen.
+ *
+ * Defines the replacement operators, so include it from one translation unit.
+ */
+
+#ifndef DENGUE_ALLOC_TRACKER_H
+#define DENGUE_ALLOC_TRACKER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+
+#include "profiler.h"
+
+const int ALLOCATION_SLOTS = PHASE_COUNT + 1; // The last one counts allocations outside every phase
+
+// Zero-initialized before any constructor runs, so allocations made during
+// static initialization are safe to count
+struct AllocationTracker {
+    std::atomic<bool> enabled;
+    std::atomic<uint64_t> counts[ALLOCATION_SLOTS]; // Since the frame began
+    std::atomic<uint64_t> bytes[ALLOCATION_SLOTS];
+};
+
+inline AllocationTracker& allocationTracker() {
+    static AllocationTracker tracker;
+    return tracker;
+}
+
+// Whether allocations on this thread are counted; set on the render thread only
+inline bool& allocationTrackedThread() {
+    static thread_local bool tracked = false;
+    return tracked;
+}
+
+// Allocations of one finished frame
+struct AllocationFrame {
+    uint64_t counts[ALLOCATION_SLOTS];
+    uint64_t total, bytes;
+};
+
+inline void noteAllocation(size_t size) {
+    if(!allocationTrackedThread()) return;
+    AllocationTracker& tracker = allocationTracker();
+    if(!tracker.enabled.load(std::memory_order_relaxed)) return;
+    int slot = currentProfilePhase();
+    tracker.counts[slot].fetch_add(1, std::memory_order_relaxed);
+    tracker.bytes[slot].fetch_add(size, std::memory_order_relaxed);
+}
+
+inline const char* allocationSlotName(int slot) {
+    return slot < PHASE_COUNT ? PROFILE_PHASE_NAMES[slot] : "outside phases";
+}
+
+inline void beginAllocationFrame() {
+    AllocationTracker& tracker = allocationTracker();
+    for(int slot = 0; slot < ALLOCATION_SLOTS; slot++) {
+        tracker.counts[slot].store(0, std::memory_order_relaxed);
+        tracker.bytes[slot].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Collect the allocations since beginAllocationFrame(). A steady frame (warmed
+// up, nothing resized) that allocated is printed by phase, then aborts the
+// process in debug builds; returns the allocation count.
+inline uint64_t endAllocationFrame(AllocationFrame& frame, bool steady) {
+    AllocationTracker& tracker = allocationTracker();
+    frame.total = frame.bytes = 0;
+    for(int slot = 0; slot < ALLOCATION_SLOTS; slot++) {
+        frame.counts[slot] = tracker.counts[slot].load(std::memory_order_relaxed);
+        frame.total += frame.counts[slot];
+        frame.bytes += tracker.bytes[slot].load(std::memory_order_relaxed);
+    }
+    if(frame.total == 0 || !steady) return frame.total;
+
+    static unsigned long long reports = 0;
+    if(reports++ < 10) {
+        fprintf(stderr, "allocations: steady frame allocated %llu times (%llu bytes):",
+                static_cast<unsigned long long>(frame.total), static_cast<unsigned long long>(frame.bytes));
+        for(int slot = 0; slot < ALLOCATION_SLOTS; slot++) {
+            if(frame.counts[slot] == 0) continue;
+            fprintf(stderr, " %s %llu", allocationSlotName(slot), static_cast<unsigned long long>(frame.counts[slot]));
+        }
+        fprintf(stderr, "\n");
+    }
+#ifndef NDEBUG
+    abort();
+#endif
+    return frame.total;
+}
+
+void* operator new(size_t size) {
+    noteAllocation(size);
+    void* p = malloc(size ? size : 1);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    noteAllocation(size);
+    void* p = malloc(size ? size : 1);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    noteAllocation(size);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    noteAllocation(size);
+    return malloc(size ? size : 1);
+}
+
+// Every delete frees through here. Kept out of line so GCC does not see
+// free() right after an operator new and warn -Wmismatched-new-delete; the
+// replacement new above allocates with malloc, so the pair is correct.
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void releaseAllocation(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p) noexcept {
+    releaseAllocation(p);
+}
+
+void operator delete[](void* p) noexcept {
+    releaseAllocation(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    releaseAllocation(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    releaseAllocation(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    releaseAllocation(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    releaseAllocation(p);
+}
+
+#endif
@@ -0,0 +1,346 @@
+/*
+ * Packed asset archive
+ * Illustrations are converted offline (tools/asset_packer) into one file of
+ * textures that are already decoded: every image is stored with its whole
+ * mipmap chain, as RGBA8 or as BC1 (DXT1) blocks, ready to hand to OpenGL
+ * straight from a memory mapping. The archive also keeps each image's
+ * average color, drawn in its place until the texture is uploaded.
+ */
+
+#ifndef DENGUE_ASSET_ARCHIVE_H
+#define DENGUE_ASSET_ARCHIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+// The file layout is the in-memory layout of a little-endian machine
+const char ASSET_ARCHIVE_MAGIC[8] = {'D', 'A', 'S', 'S', 'E', 'T', '0', '1'};
+const uint64_t ASSET_ARCHIVE_ALIGN = 64;
+const size_t ASSET_NAME_SIZE = 64;
+
+enum AssetFormat {
+    ASSET_RGBA8 = 0,
+    ASSET_BC1          // 4x4 blocks of two RGB565 colors and 2-bit indices, opaque images only
+};
+
+struct AssetArchiveHeader {
+    char magic[8];
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t entriesOffset; // AssetEntry[count]
+};
+
+struct AssetEntry {
+    char name[ASSET_NAME_SIZE]; // Null-terminated
+    uint32_t format;
+    uint32_t width, height;     // Of the first level, powers of two
+    uint32_t levels;            // Down to 1x1
+    uint8_t average[4];         // RGBA placeholder color
+    uint32_t reserved;
+    uint64_t offset;            // Levels one after another, from the largest, aligned to ASSET_ARCHIVE_ALIGN
+    uint64_t size;
+};
+
+// An image being packed
+struct AssetImage {
+    std::string name;
+    int width, height;
+    std::vector<unsigned char> rgba;
+};
+
+// Mapped archive; the entries point straight into the file
+struct AssetArchive {
+    MappedFile file;
+    uint32_t count;
+    const AssetEntry* entries;
+};
+
+inline bool isPowerOfTwo(uint32_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+inline size_t assetLevelSize(uint32_t format, uint32_t width, uint32_t height) {
+    if(format == ASSET_BC1) return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 8;
+    return static_cast<size_t>(width) * height * 4;
+}
+
+inline uint32_t assetLevelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    while(width > 1 || height > 1) {
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        levels++;
+    }
+    return levels;
+}
+
+// Size of the whole mipmap chain
+inline size_t assetChainSize(uint32_t format, uint32_t width, uint32_t height, uint32_t levels) {
+    size_t size = 0;
+    for(uint32_t level = 0; level < levels; level++) {
+        size += assetLevelSize(format, width, height);
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    return size;
+}
+
+// Next level down, each texel the average of a 2x2 box (or 2x1 once one side is 1)
+inline void downsampleRGBA(const unsigned char* source, int width, int height, std::vector<unsigned char>& out) {
+    int outWidth = std::max(1, width / 2), outHeight = std::max(1, height / 2);
+    int stepX = width > 1 ? 1 : 0, stepY = height > 1 ? 1 : 0;
+    out.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+    for(int y = 0; y < outHeight; y++) {
+        const unsigned char* row0 = source + static_cast<size_t>(y * 2) * width * 4;
+        const unsigned char* row1 = row0 + static_cast<size_t>(stepY) * width * 4;
+        for(int x = 0; x < outWidth; x++) {
+            for(int c = 0; c < 4; c++) {
+                int a = (x * 2) * 4 + c, b = (x * 2 + stepX) * 4 + c;
+                out[(static_cast<size_t>(y) * outWidth + x) * 4 + c] =
+                    static_cast<unsigned char>((row0[a] + row0[b] + row1[a] + row1[b] + 2) / 4);
+            }
+        }
+    }
+}
+
+inline uint16_t packRGB565(int r, int g, int b) {
+    return static_cast<uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+inline void unpackRGB565(uint16_t color, int rgb[3]) {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Four-color BC1 palette from two endpoints, color0 > color1
+inline void bc1Palette(uint16_t color0, uint16_t color1, int palette[4][3]) {
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for(int c = 0; c < 3; c++) {
+        if(color0 > color1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0; // Transparent black, never written by the encoder
+        }
+    }
+}
+
+// Encode one 4x4 block with the endpoints at the ends of its bounding box
+// diagonal, ordered so the block uses the opaque four-color mode
+inline void encodeBC1Block(const unsigned char texels[16][4], unsigned char out[8]) {
+    int low[3] = {255, 255, 255}, high[3] = {0, 0, 0};
+    for(int i = 0; i < 16; i++) {
+        for(int c = 0; c < 3; c++) {
+            low[c] = std::min(low[c], static_cast<int>(texels[i][c]));
+            high[c] = std::max(high[c], static_cast<int>(texels[i][c]));
+        }
+    }
+    uint16_t color0 = packRGB565(high[0], high[1], high[2]);
+    uint16_t color1 = packRGB565(low[0], low[1], low[2]);
+    if(color0 < color1) std::swap(color0, color1);
+
+    uint32_t indices = 0;
+    if(color0 != color1) {
+        int palette[4][3];
+        bc1Palette(color0, color1, palette);
+        for(int i = 0; i < 16; i++) {
+            int best = 0, bestDistance = 1 << 30;
+            for(int p = 0; p < 4; p++) {
+                int dr = texels[i][0] - palette[p][0], dg = texels[i][1] - palette[p][1];
+                int db = texels[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if(distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+    }
+    out[0] = static_cast<unsigned char>(color0);
+    out[1] = static_cast<unsigned char>(color0 >> 8);
+    out[2] = static_cast<unsigned char>(color1);
+    out[3] = static_cast<unsigned char>(color1 >> 8);
+    for(int i = 0; i < 4; i++) out[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+}
+
+// Append a level as BC1 blocks; texels past the edge of small levels repeat the edge
+inline void encodeBC1(const unsigned char* rgba, int width, int height, std::vector<unsigned char>& out) {
+    unsigned char texels[16][4];
+    unsigned char block[8];
+    for(int by = 0; by < height; by += 4) {
+        for(int bx = 0; bx < width; bx += 4) {
+            for(int i = 0; i < 16; i++) {
+                int x = std::min(bx + i % 4, width - 1), y = std::min(by + i / 4, height - 1);
+                memcpy(texels[i], rgba + (static_cast<size_t>(y) * width + x) * 4, 4);
+            }
+            encodeBC1Block(texels, block);
+            out.insert(out.end(), block, block + 8);
+        }
+    }
+}
+
+// Decode a BC1 level to RGBA, for drivers without S3TC
+inline void decodeBC1(const unsigned char* blocks, int width, int height, unsigned char* rgba) {
+    for(int by = 0; by < height; by += 4) {
+        for(int bx = 0; bx < width; bx += 4, blocks += 8) {
+            uint16_t color0 = static_cast<uint16_t>(blocks[0] | blocks[1] << 8);
+            uint16_t color1 = static_cast<uint16_t>(blocks[2] | blocks[3] << 8);
+            uint32_t indices = blocks[4] | blocks[5] << 8 | blocks[6] << 16 | static_cast<uint32_t>(blocks[7]) << 24;
+            int palette[4][3];
+            bc1Palette(color0, color1, palette);
+            for(int i = 0; i < 16; i++) {
+                int x = bx + i % 4, y = by + i / 4;
+                if(x >= width || y >= height) continue;
+                int p = (indices >> (i * 2)) & 3;
+                unsigned char* texel = rgba + (static_cast<size_t>(y) * width + x) * 4;
+                texel[0] = static_cast<unsigned char>(palette[p][0]);
+                texel[1] = static_cast<unsigned char>(palette[p][1]);
+                texel[2] = static_cast<unsigned char>(palette[p][2]);
+                texel[3] = color0 <= color1 && p == 3 ? 0 : 255;
+            }
+        }
+    }
+}
+
+// Write the images with their mipmap chains to `path`, through a temporary
+// file so a failed run leaves no partial archive. Images with any
+// transparency stay RGBA8 even when `compress` asks for BC1.
+inline bool writeAssetArchive(const char* path, const std::vector<AssetImage>& images, bool compress) {
+    std::vector<AssetEntry> entries(images.size());
+    std::vector<std::vector<unsigned char> > blobs(images.size());
+    uint64_t offset = sizeof(AssetArchiveHeader) + images.size() * sizeof(AssetEntry);
+    for(size_t i = 0; i < images.size(); i++) {
+        const AssetImage& image = images[i];
+        AssetEntry& entry = entries[i];
+        memset(&entry, 0, sizeof(entry));
+        if(image.name.size() >= ASSET_NAME_SIZE || !isPowerOfTwo(image.width) || !isPowerOfTwo(image.height)) {
+            fprintf(stderr, "assets: %s must have a name under %zu characters and power-of-two sides (%dx%d)\n",
+                    image.name.c_str(), ASSET_NAME_SIZE, image.width, image.height);
+            return false;
+        }
+        memcpy(entry.name, image.name.c_str(), image.name.size());
+        entry.width = image.width;
+        entry.height = image.height;
+        entry.levels = assetLevelCount(image.width, image.height);
+
+        bool opaque = true;
+        unsigned long long sum[4] = {0, 0, 0, 0};
+        size_t texels = static_cast<size_t>(image.width) * image.height;
+        for(size_t t = 0; t < texels; t++) {
+            for(int c = 0; c < 4; c++) sum[c] += image.rgba[t * 4 + c];
+            opaque = opaque && image.rgba[t * 4 + 3] == 255;
+        }
+        for(int c = 0; c < 4; c++) entry.average[c] = static_cast<uint8_t>(sum[c] / texels);
+        entry.format = compress && opaque ? ASSET_BC1 : ASSET_RGBA8;
+
+        std::vector<unsigned char>& blob = blobs[i];
+        std::vector<unsigned char> level = image.rgba, next;
+        int width = image.width, height = image.height;
+        for(uint32_t l = 0; l < entry.levels; l++) {
+            if(entry.format == ASSET_BC1) encodeBC1(level.data(), width, height, blob);
+            else blob.insert(blob.end(), level.begin(), level.end());
+            if(l + 1 < entry.levels) {
+                downsampleRGBA(level.data(), width, height, next);
+                level.swap(next);
+                width = std::max(1, width / 2);
+                height = std::max(1, height / 2);
+            }
+        }
+        offset = (offset + ASSET_ARCHIVE_ALIGN - 1) / ASSET_ARCHIVE_ALIGN * ASSET_ARCHIVE_ALIGN;
+        entry.offset = offset;
+        entry.size = blob.size();
+        offset += blob.size();
+    }
+
+    std::string tempPath = std::string(path) + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if(!file) {
+        fprintf(stderr, "assets: cannot write %s\n", tempPath.c_str());
+        return false;
+    }
+    AssetArchiveHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ASSET_ARCHIVE_MAGIC, sizeof(header.magic));
+    header.count = static_cast<uint32_t>(images.size());
+    header.entriesOffset = sizeof(AssetArchiveHeader);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    if(!entries.empty()) ok = ok && fwrite(entries.data(), sizeof(AssetEntry), entries.size(), file) == entries.size();
+    const unsigned char zeros[ASSET_ARCHIVE_ALIGN] = {0};
+    long position = static_cast<long>(sizeof(AssetArchiveHeader) + entries.size() * sizeof(AssetEntry));
+    for(size_t i = 0; ok && i < entries.size(); i++) {
+        size_t padding = static_cast<size_t>(entries[i].offset - position);
+        ok = fwrite(zeros, 1, padding, file) == padding &&
+             fwrite(blobs[i].data(), 1, blobs[i].size(), file) == blobs[i].size();
+        position = static_cast<long>(entries[i].offset + entries[i].size);
+    }
+    ok = fclose(file) == 0 && ok;
+    if(!ok || rename(tempPath.c_str(), path) != 0) {
+        fprintf(stderr, "assets: cannot write %s\n", path);
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+inline void closeAssetArchive(AssetArchive& archive) {
+    unmapFile(archive.file);
+    archive.count = 0;
+    archive.entries = NULL;
+}
+
+// Map an archive and check that every entry lies inside it
+inline bool openAssetArchive(AssetArchive& archive, const char* path) {
+    archive.count = 0;
+    archive.entries = NULL;
+    if(!mapFile(archive.file, path)) {
+        fprintf(stderr, "assets: cannot open %s\n", path);
+        return false;
+    }
+    const MappedFile& file = archive.file;
+    const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(file.data);
+    bool valid = file.size >= sizeof(AssetArchiveHeader) &&
+                 memcmp(header->magic, ASSET_ARCHIVE_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->entriesOffset % 8 == 0 && header->entriesOffset <= file.size &&
+                 header->count <= (file.size - header->entriesOffset) / sizeof(AssetEntry);
+    if(valid) {
+        archive.entries = reinterpret_cast<const AssetEntry*>(file.data + header->entriesOffset);
+        for(uint32_t i = 0; valid && i < header->count; i++) {
+            const AssetEntry& entry = archive.entries[i];
+            valid = memchr(entry.name, '\0', ASSET_NAME_SIZE) != NULL && entry.format <= ASSET_BC1 &&
+                    isPowerOfTwo(entry.width) && isPowerOfTwo(entry.height) &&
+                    entry.levels == assetLevelCount(entry.width, entry.height) &&
+                    entry.offset % ASSET_ARCHIVE_ALIGN == 0 && entry.offset <= file.size &&
+                    entry.size <= file.size - entry.offset &&
+                    entry.size == assetChainSize(entry.format, entry.width, entry.height, entry.levels);
+        }
+    }
+    if(!valid) {
+        fprintf(stderr, "assets: %s is not a valid asset archive\n", path);
+        closeAssetArchive(archive);
+        return false;
+    }
+    archive.count = header->count;
+    return true;
+}
+
+// Index of the named asset, -1 if the archive has none
+inline int findAsset(const AssetArchive& archive, const char* name) {
+    for(uint32_t i = 0; i < archive.count; i++) {
+        if(strcmp(archive.entries[i].name, name) == 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * Background asset loading
+ * The archive is mapped at startup, which reads nothing but its directory.
+ * A loader thread then pages in the texture blobs in the order they were
+ * requested, decoding BC1 to RGBA only where the driver lacks S3TC, and the
+ * render thread uploads the finished ones within a byte budget per frame.
+ * Until an asset is uploaded it is drawn as its average color, kept in the
+ * archive directory.
+ */
+
+#ifndef DENGUE_ASSET_LOADER_H
+#define DENGUE_ASSET_LOADER_H
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <GL/gl.h>
+#elif defined(__APPLE__)
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#include <GL/glx.h>
+#endif
+
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "asset_archive.h"
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+const GLenum ASSET_COMPRESSED_RGB_DXT1 = 0x83F0; // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+const GLint ASSET_CLAMP_TO_EDGE = 0x812F;         // GL_CLAMP_TO_EDGE
+const size_t ASSET_PAGE_SIZE = 4096;
+
+enum AssetState {
+    ASSET_MISSING = 0, // Not in the archive, or no archive
+    ASSET_QUEUED,
+    ASSET_DECODED,     // Paged in and ready to upload
+    ASSET_READY        // Texture uploaded
+};
+
+struct AssetSlot {
+    std::atomic<int> state;
+    int entry;                           // Index in the archive
+    GLuint texture;
+    std::vector<unsigned char> decoded;  // RGBA levels of a BC1 blob the driver cannot take
+    float placeholder[4];
+};
+
+typedef void (APIENTRY *CompressedTexImage2DProc)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint,
+                                                  GLsizei, const void*);
+
+struct AssetLoader {
+    AssetArchive archive;
+    std::vector<AssetSlot> slots;  // One per requested name, in request order
+    std::thread thread;
+    std::atomic<bool> stopping;
+    bool compressed;               // The driver takes BC1 blobs as they are
+    CompressedTexImage2DProc compressedTexImage2D;
+    size_t uploadBudget;           // Bytes uploaded per pumpAssets call, at least one asset
+    size_t uploaded;               // Assets and bytes uploaded so far
+    size_t uploadedBytes;
+
+    AssetLoader() : slots(), stopping(false), compressed(false), compressedTexImage2D(NULL),
+                    uploadBudget(1 << 20), uploaded(0), uploadedBytes(0) {
+        archive.file.data = NULL;
+        archive.file.size = 0;
+        archive.count = 0;
+        archive.entries = NULL;
+    }
+};
+
+inline void* assetProcAddress(const char* name) {
+#if defined(_WIN32)
+    return (void*)wglGetProcAddress(name);
+#elif defined(__APPLE__)
+    (void)name;
+    return NULL;
+#else
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+}
+
+// Whether BC1 textures can be uploaded compressed; needs a current context
+inline bool initCompressedTextures(AssetLoader& loader) {
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    bool hasS3TC = extensions && strstr(extensions, "GL_EXT_texture_compression_s3tc") != NULL;
+#if defined(__APPLE__)
+    loader.compressedTexImage2D = (CompressedTexImage2DProc)glCompressedTexImage2D;
+#else
+    loader.compressedTexImage2D = (CompressedTexImage2DProc)assetProcAddress("glCompressedTexImage2D");
+#endif
+    loader.compressed = hasS3TC && loader.compressedTexImage2D != NULL;
+    return loader.compressed;
+}
+
+// Page in the requested blobs, decoding those the driver cannot take
+inline void assetLoaderThread(AssetLoader* loader) {
+    for(AssetSlot& slot : loader->slots) {
+        if(loader->stopping.load(std::memory_order_relaxed)) return;
+        if(slot.state.load(std::memory_order_relaxed) != ASSET_QUEUED) continue;
+        const AssetEntry& entry = loader->archive.entries[slot.entry];
+        const unsigned char* blob = reinterpret_cast<const unsigned char*>(loader->archive.file.data) + entry.offset;
+        if(entry.format == ASSET_BC1 && !loader->compressed) {
+            slot.decoded.resize(assetChainSize(ASSET_RGBA8, entry.width, entry.height, entry.levels));
+            unsigned char* out = slot.decoded.data();
+            uint32_t width = entry.width, height = entry.height;
+            for(uint32_t level = 0; level < entry.levels; level++) {
+                decodeBC1(blob, width, height, out);
+                blob += assetLevelSize(ASSET_BC1, width, height);
+                out += assetLevelSize(ASSET_RGBA8, width, height);
+                width = std::max(1u, width / 2);
+                height = std::max(1u, height / 2);
+            }
+        } else {
+            // Touch every page, so the upload never waits on the disk
+            volatile unsigned char sink = 0;
+            for(uint64_t offset = 0; offset < entry.size; offset += ASSET_PAGE_SIZE) sink ^= blob[offset];
+            (void)sink;
+        }
+        slot.state.store(ASSET_DECODED, std::memory_order_release);
+    }
+}
+
+// Start paging in the named assets of the archive opened into the loader, in
+// this order of priority; names the archive lacks stay missing. Needs a
+// current context.
+inline void startAssetLoader(AssetLoader& loader, const char* const* names, size_t count) {
+    loader.slots = std::vector<AssetSlot>(count);
+    if(loader.archive.count > 0) initCompressedTextures(loader);
+    bool queued = false;
+    for(size_t i = 0; i < count; i++) {
+        AssetSlot& slot = loader.slots[i];
+        slot.texture = 0;
+        slot.entry = findAsset(loader.archive, names[i]);
+        for(int c = 0; c < 4; c++) {
+            slot.placeholder[c] = slot.entry >= 0 ? loader.archive.entries[slot.entry].average[c] / 255.0f : 0.0f;
+        }
+        slot.state.store(slot.entry >= 0 ? ASSET_QUEUED : ASSET_MISSING, std::memory_order_relaxed);
+        queued = queued || slot.entry >= 0;
+    }
+    if(queued) loader.thread = std::thread(assetLoaderThread, &loader);
+}
+
+inline void stopAssetLoader(AssetLoader& loader) {
+    loader.stopping.store(true);
+    if(loader.thread.joinable()) loader.thread.join();
+}
+
+inline void uploadAsset(AssetLoader& loader, AssetSlot& slot) {
+    const AssetEntry& entry = loader.archive.entries[slot.entry];
+    bool compressed = entry.format == ASSET_BC1 && slot.decoded.empty();
+    const unsigned char* data = slot.decoded.empty()
+        ? reinterpret_cast<const unsigned char*>(loader.archive.file.data) + entry.offset : slot.decoded.data();
+
+    glGenTextures(1, &slot.texture);
+    glBindTexture(GL_TEXTURE_2D, slot.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ASSET_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ASSET_CLAMP_TO_EDGE);
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    uint32_t width = entry.width, height = entry.height;
+    for(uint32_t level = 0; level < entry.levels; level++) {
+        if(compressed) {
+            size_t size = assetLevelSize(ASSET_BC1, width, height);
+            loader.compressedTexImage2D(GL_TEXTURE_2D, level, ASSET_COMPRESSED_RGB_DXT1, width, height, 0,
+                                        static_cast<GLsizei>(size), data);
+            data += size;
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+            data += assetLevelSize(ASSET_RGBA8, width, height);
+        }
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    loader.uploaded++;
+    loader.uploadedBytes += compressed ? entry.size : assetChainSize(ASSET_RGBA8, entry.width, entry.height,
+                                                                     entry.levels);
+    std::vector<unsigned char>().swap(slot.decoded);
+    slot.state.store(ASSET_READY, std::memory_order_relaxed);
+}
+
+// Upload the assets paged in so far, stopping once the frame's budget is
+// spent; returns how many are still on their way
+inline size_t pumpAssets(AssetLoader& loader) {
+    size_t pending = 0, spent = 0;
+    for(AssetSlot& slot : loader.slots) {
+        int state = slot.state.load(std::memory_order_acquire);
+        if(state == ASSET_DECODED && spent < loader.uploadBudget) {
+            size_t before = loader.uploadedBytes;
+            uploadAsset(loader, slot);
+            spent += loader.uploadedBytes - before;
+        } else if(state == ASSET_QUEUED || state == ASSET_DECODED) {
+            pending++;
+        }
+    }
+    if(pending == 0 && loader.thread.joinable()) loader.thread.join();
+    return pending;
+}
+
+// Block until every asset is uploaded, for runs that must not depend on timing
+inline void finishAssets(AssetLoader& loader) {
+    if(loader.thread.joinable()) loader.thread.join();
+    size_t budget = loader.uploadBudget;
+    loader.uploadBudget = static_cast<size_t>(-1);
+    pumpAssets(loader);
+    loader.uploadBudget = budget;
+}
+
+// Whether any asset is still being paged in or waiting for its upload
+inline bool assetsPending(const AssetLoader& loader) {
+    return loader.thread.joinable();
+}
+
+// Texture of an uploaded asset, 0 while it is still a placeholder
+inline GLuint assetTexture(const AssetLoader& loader, size_t slot) {
+    const AssetSlot& asset = loader.slots[slot];
+    return asset.state.load(std::memory_order_relaxed) == ASSET_READY ? asset.texture : 0;
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Case-report store benchmark
+ * Writes a synthetic daily per-district CSV (unless one exists), converts it
+ * to a columnar store, then times reopening the store and one pass over its
+ * columns, and checks the column sums against the stored yearly totals.
+ *
+ * Usage: case_bench [rows] [csv path] [districts]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+
+#include "../case_store.h"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Seasonal counts with a little per-district noise, starting on 2000-01-01
+static bool writeSyntheticCsv(const char* path, unsigned long long rows, unsigned districts) {
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+    fputs("date,district,cases,deaths,prevention\n", file);
+    uint32_t state = 12345;
+    int32_t firstDay = daysFromCivil(2000, 1, 1);
+    for(unsigned long long row = 0; row < rows; row++) {
+        int32_t day = firstDay + static_cast<int32_t>(row / districts);
+        int year, month, dayOfMonth;
+        civilFromDays(day, year, month, dayOfMonth);
+
+        state = state * 1664525u + 1013904223u;
+        unsigned season = month >= 6 && month <= 10 ? 12 : 2;
+        unsigned cases = (state >> 24) % (season + 1);
+        unsigned deaths = cases > 10 && ((state >> 8) & 63) == 0;
+        unsigned prevention = (state >> 16) % 20;
+        fprintf(file, "%04d-%02d-%02d,District %04u,%u,%u,%u\n", year, month, dayOfMonth,
+                static_cast<unsigned>(row % districts), cases, deaths, prevention);
+    }
+    return fclose(file) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long long rows = argc > 1 ? strtoull(argv[1], NULL, 10) : 50000000ULL;
+    const char* csvPath = argc > 2 ? argv[2] : "case_bench.csv";
+    unsigned districts = argc > 3 ? static_cast<unsigned>(atoi(argv[3])) : 4096;
+    if(rows == 0 || districts == 0 || districts > 65536) {
+        fprintf(stderr, "usage: %s [rows] [csv path] [districts]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct stat info;
+    if(stat(csvPath, &info) != 0) {
+        auto start = std::chrono::steady_clock::now();
+        if(!writeSyntheticCsv(csvPath, rows, districts)) {
+            fprintf(stderr, "cannot write %s\n", csvPath);
+            return EXIT_FAILURE;
+        }
+        printf("generate   %10.1f ms\n", millisecondsSince(start));
+    }
+
+    std::string storePath = std::string(csvPath) + ".cols";
+    auto start = std::chrono::steady_clock::now();
+    if(!convertCaseCsv(csvPath, storePath.c_str())) return EXIT_FAILURE;
+    double convertMs = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    CaseStore store;
+    if(!loadCaseStore(store, csvPath)) return EXIT_FAILURE;
+    double openMs = millisecondsSince(start);
+
+    // Touch every row once, as a consumer of the raw columns would
+    start = std::chrono::steady_clock::now();
+    std::map<int, unsigned long long> cases;
+    unsigned long long deaths = 0, prevention = 0;
+    int lastYear = -1;
+    unsigned long long* yearCases = NULL;
+    for(size_t i = 0; i < store.rows; i++) {
+        if(store.year[i] != lastYear) {
+            lastYear = store.year[i];
+            yearCases = &cases[lastYear];
+        }
+        *yearCases += store.cases[i];
+        deaths += store.deaths[i];
+        prevention += store.prevention[i];
+    }
+    double scanMs = millisecondsSince(start);
+
+    printf("rows: %zu (%zu skipped), districts: %zu, years: %zu, days: %zu\n", store.rows,
+           store.skippedRows, store.districtCount, store.yearCount, store.dayCount);
+    printf("convert    %10.1f ms  %7.1f M rows/s\n", convertMs, store.rows / (convertMs * 1000.0));
+    printf("open       %10.3f ms\n", openMs);
+    printf("scan       %10.1f ms  %7.1f M rows/s\n", scanMs, store.rows / (scanMs * 1000.0));
+
+    unsigned long long totalDeaths = 0, totalPrevention = 0;
+    bool match = cases.size() == store.yearCount;
+    for(size_t i = 0; i < store.yearCount; i++) {
+        const CaseTotals& total = store.yearTotals[i];
+        match = match && cases[total.key] == total.cases;
+        totalDeaths += total.deaths;
+        totalPrevention += total.prevention;
+    }
+    match = match && totalDeaths == deaths && totalPrevention == prevention;
+    closeCaseStore(store);
+    if(!match) {
+        printf("MISMATCH between the columns and the yearly totals\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+/*
+ * Epidemic engine benchmark
+ * Steps a seeded city for a number of days on one thread and on the whole
+ * worker pool, reports milliseconds per day and agent updates per second,
+ * and checks both runs produce the same daily reports.
+ *
+ * Usage: epidemic_bench [humans] [mosquitoes] [days] [threads]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "../epidemic.h"
+
+static double runDays(const EpidemicParams& params, int days, unsigned threads,
+                      std::vector<EpidemicReport>& reports) {
+    WorkerPool pool;
+    startWorkerPool(pool, threads - 1);
+    Epidemic epidemic;
+    initEpidemic(epidemic, params, 12345, pool);
+
+    reports.resize(days);
+    auto start = std::chrono::steady_clock::now();
+    for(int d = 0; d < days; d++) {
+        stepEpidemicDay(epidemic, pool, reports[d]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    stopWorkerPool(pool);
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    EpidemicParams params = defaultEpidemicParams();
+    params.humans = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+    params.mosquitoes = argc > 2 ? strtoull(argv[2], NULL, 10) : 10000000;
+    int days = argc > 3 ? atoi(argv[3]) : 30;
+    unsigned threads = argc > 4 ? static_cast<unsigned>(atoi(argv[4])) : defaultWorkerCount() + 1;
+    if(params.humans == 0 || days <= 0 || threads == 0) {
+        fprintf(stderr, "usage: %s [humans] [mosquitoes] [days] [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("humans: %zu, mosquitoes: %zu, days: %d\n", params.humans, params.mosquitoes, days);
+    double agents = static_cast<double>(params.humans) + params.mosquitoes;
+    std::vector<EpidemicReport> serial, parallel;
+    unsigned counts[2] = {1, threads};
+    for(int run = 0; run < (threads > 1 ? 2 : 1); run++) {
+        std::vector<EpidemicReport>& reports = run == 0 ? serial : parallel;
+        double ms = runDays(params, days, counts[run], reports);
+        printf("%2u threads  %9.2f ms/day  %7.1f M agent updates/s\n", counts[run], ms / days,
+               agents * days / (ms * 1000.0));
+    }
+
+    const EpidemicReport& last = serial.back();
+    printf("day %d: %llu susceptible, %llu exposed, %llu infectious, %llu recovered, %llu mosquitoes\n",
+           last.day, last.susceptible, last.exposed, last.infectious, last.recovered, last.mosquitoes);
+    if(!parallel.empty() &&
+       memcmp(serial.data(), parallel.data(), serial.size() * sizeof(EpidemicReport)) != 0) {
+        printf("MISMATCH between 1 and %u threads\n", threads);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
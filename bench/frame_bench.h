@@ -0,0 +1,163 @@
+/*
+ * End-to-end frame benchmark reporting
+ * Collects frame times and peak memory per scene, writes them as JSON and
+ * compares a run against a stored baseline. Linux only, peak RSS comes from
+ * /proc/self/status.
+ */
+
+#ifndef DENGUE_FRAME_BENCH_H
+#define DENGUE_FRAME_BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+struct SceneBenchResult {
+    int scene;            // Numbered 1-9 as on the keyboard
+    std::string name;
+    int frames;
+    double totalMs;
+    double meanMs, minMs, p50Ms, p90Ms, p95Ms, p99Ms, maxMs;
+    double framesPerSecond;
+    long peakRssKb;
+    double retainedVertices;  // Static geometry per frame drawn from GPU buffers
+    double submittedVertices; // Static geometry per frame sent from client memory
+    double drawCalls;         // Draw queue calls per frame
+    double stateChanges;      // Draw queue state changes per frame
+    double allocations;       // Heap allocations per frame
+};
+
+// Reset the peak RSS counter so the next reading covers one scene only.
+// Needs Linux 4.0+, otherwise the reading is the process-wide peak.
+inline void resetPeakRss() {
+    FILE* file = fopen("/proc/self/clear_refs", "w");
+    if(!file) return;
+    fputs("5", file);
+    fclose(file);
+}
+
+// Peak resident set size in kilobytes, -1 if unknown
+inline long readPeakRssKb() {
+    FILE* file = fopen("/proc/self/status", "r");
+    if(!file) return -1;
+    char line[256];
+    long kb = -1;
+    while(fgets(line, sizeof(line), file)) {
+        if(strncmp(line, "VmHWM:", 6) == 0) {
+            kb = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return kb;
+}
+
+inline double percentile(const std::vector<double>& sorted, int pct) {
+    return sorted[(sorted.size() - 1) * pct / 100];
+}
+
+// Summarize the frame times (milliseconds) of one scene
+inline SceneBenchResult summarizeScene(int scene, const char* name, std::vector<double>& frameMs,
+                                       long peakRssKb) {
+    SceneBenchResult result = {};
+    result.scene = scene;
+    result.name = name;
+    result.frames = static_cast<int>(frameMs.size());
+    result.peakRssKb = peakRssKb;
+    if(frameMs.empty()) return result;
+
+    std::sort(frameMs.begin(), frameMs.end());
+    for(double ms : frameMs) result.totalMs += ms;
+    result.meanMs = result.totalMs / frameMs.size();
+    result.minMs = frameMs.front();
+    result.p50Ms = percentile(frameMs, 50);
+    result.p90Ms = percentile(frameMs, 90);
+    result.p95Ms = percentile(frameMs, 95);
+    result.p99Ms = percentile(frameMs, 99);
+    result.maxMs = frameMs.back();
+    result.framesPerSecond = result.totalMs > 0.0 ? frameMs.size() * 1000.0 / result.totalMs : 0.0;
+    return result;
+}
+
+// One scene per line, so baselines can be read back without a JSON library
+inline void writeBenchJson(FILE* file, const std::vector<SceneBenchResult>& results,
+                           int width, int height, int mosquitoes, unsigned long long seed,
+                           const char* renderer) {
+    fprintf(file, "{\n  \"width\": %d, \"height\": %d, \"mosquitoes\": %d, \"seed\": %llu, "
+                  "\"renderer\": \"%s\",\n", width, height, mosquitoes, seed, renderer);
+    fprintf(file, "  \"scenes\": [\n");
+    for(size_t i = 0; i < results.size(); i++) {
+        const SceneBenchResult& r = results[i];
+        fprintf(file, "    {\"scene\": %d, \"name\": \"%s\", \"frames\": %d, \"fps\": %.2f, "
+                      "\"mean_ms\": %.4f, \"min_ms\": %.4f, \"p50_ms\": %.4f, \"p90_ms\": %.4f, "
+                      "\"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f, \"peak_rss_kb\": %ld, "
+                      "\"retained_vertices\": %.0f, \"submitted_vertices\": %.0f, "
+                      "\"draw_calls\": %.1f, \"state_changes\": %.1f, \"allocations\": %.2f}%s\n",
+                r.scene, r.name.c_str(), r.frames, r.framesPerSecond,
+                r.meanMs, r.minMs, r.p50Ms, r.p90Ms, r.p95Ms, r.p99Ms, r.maxMs, r.peakRssKb,
+                r.retainedVertices, r.submittedVertices, r.drawCalls, r.stateChanges, r.allocations,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+// Number following "key": on a line, false if the key is missing
+inline bool readJsonNumber(const char* line, const char* key, double& value) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char* found = strstr(line, pattern);
+    if(!found) return false;
+    value = strtod(found + strlen(pattern), NULL);
+    return true;
+}
+
+// Read the per-scene results of a report written by writeBenchJson
+inline bool readBenchBaseline(const char* path, std::vector<SceneBenchResult>& results) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+    results.clear();
+    char line[1024];
+    while(fgets(line, sizeof(line), file)) {
+        SceneBenchResult r = {};
+        double scene, rss = -1.0;
+        if(!readJsonNumber(line, "scene", scene)) continue;
+        r.scene = static_cast<int>(scene);
+        readJsonNumber(line, "mean_ms", r.meanMs);
+        readJsonNumber(line, "p95_ms", r.p95Ms);
+        readJsonNumber(line, "fps", r.framesPerSecond);
+        readJsonNumber(line, "peak_rss_kb", rss);
+        r.peakRssKb = static_cast<long>(rss);
+        results.push_back(r);
+    }
+    fclose(file);
+    return !results.empty();
+}
+
+// Flag scenes whose mean or p95 frame time grew by more than thresholdPercent
+inline bool compareWithBaseline(const std::vector<SceneBenchResult>& current,
+                                const std::vector<SceneBenchResult>& baseline,
+                                double thresholdPercent) {
+    bool passed = true;
+    double limit = 1.0 + thresholdPercent / 100.0;
+    for(const SceneBenchResult& r : current) {
+        const SceneBenchResult* base = NULL;
+        for(const SceneBenchResult& b : baseline) {
+            if(b.scene == r.scene) base = &b;
+        }
+        if(!base) {
+            fprintf(stderr, "scene %d: not in baseline\n", r.scene);
+            continue;
+        }
+        bool slower = (base->meanMs > 0.0 && r.meanMs > base->meanMs * limit) ||
+                      (base->p95Ms > 0.0 && r.p95Ms > base->p95Ms * limit);
+        fprintf(stderr, "scene %d: mean %.3f ms (baseline %.3f), p95 %.3f ms (baseline %.3f) %s\n",
+                r.scene, r.meanMs, base->meanMs, r.p95Ms, base->p95Ms, slower ? "REGRESSION" : "ok");
+        passed = passed && !slower;
+    }
+    return passed;
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Steering benchmark
+ * Steers and moves swarms of growing size over the app's view, reports
+ * milliseconds per tick and nanoseconds per mosquito for the grid rebuild
+ * and the steering pass, and checks the threaded run matches the serial one.
+ * The view stays the same size, so bigger swarms are also denser ones.
+ *
+ * Usage: steering_bench [max mosquitoes] [ticks] [threads]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "../random.h"
+#include "../steering.h"
+#include "../swarm.h"
+
+// Scattered over the view like the swarm scenes, every 7th mosquito dead
+static void seedSwarm(MosquitoSwarm& swarm, size_t count) {
+    initSwarm(swarm, count);
+    RandomStream random;
+    seedRandomStream(random, 12345, RANDOM_STREAM_BENCH);
+    for(size_t i = 0; i < count; i++) {
+        float x = randomRange(random, -4.5f, 4.5f);
+        float y = randomRange(random, -2.5f, 4.5f);
+        float vx = randomRange(random, -0.03f, 0.03f);
+        float vy = randomRange(random, -0.03f, 0.03f);
+        addMosquito(swarm, x, y, vx, vy);
+        if(i % 7 == 3) killMosquito(swarm, i);
+    }
+}
+
+struct SteeringRun {
+    double buildNs, steerNs; // Summed over every tick
+};
+
+static SteeringRun runSwarm(MosquitoSwarm& swarm, size_t count, int ticks, WorkerPool& pool) {
+    const SteeringTarget hosts[] = {{-3.0f, 0.4f}, {0.0f, 0.4f}, {3.0f, 0.4f}};
+    const SteeringTarget water[] = {{-3.0f, 1.2f}, {0.0f, 1.2f}, {3.0f, 1.2f}};
+
+    SteeringParams steering;
+    steering.step = 1.0f;
+    steering.neighborRadius = 0.5f;
+    steering.separationRadius = 0.2f;
+    steering.maxNeighbors = 8;
+    steering.separation = 0.0002f;
+    steering.alignment = 0.02f;
+    steering.cohesion = 0.0005f;
+    steering.seekHost = 0.01f;
+    steering.seekWater = 0.005f;
+    steering.seekRadius = 2.5f;
+    steering.arriveRadius = 0.5f;
+    steering.cruiseSpeed = 0.02f;
+    steering.maxForce = 0.001f;
+    steering.hosts = hosts;
+    steering.hostCount = 3;
+    steering.breedingSites = water;
+    steering.breedingSiteCount = 3;
+
+    SwarmStepParams params;
+    params.step = 1.0f;
+    params.wingStep = 0.1f;
+    params.minX = -4.5f;
+    params.maxX = 4.5f;
+    params.minY = -2.5f;
+    params.maxY = 4.5f;
+    params.bounceDamping = 0.95f;
+    params.maxSpeed = 0.03f;
+
+    seedSwarm(swarm, count);
+    SteeringGrid grid;
+    initSteeringGrid(grid, -5.0f, -5.0f, 5.0f, 5.0f, steering.neighborRadius, swarm.capacity);
+    SteeringRun run = {};
+    for(int t = 0; t < ticks; t++) {
+        auto start = std::chrono::steady_clock::now();
+        buildSteeringGrid(grid, swarm);
+        auto built = std::chrono::steady_clock::now();
+        applySteering(swarm, grid, steering, pool);
+        auto steered = std::chrono::steady_clock::now();
+        updateSwarm(swarm, params, SWARM_KERNEL_AUTO);
+        run.buildNs += std::chrono::duration<double, std::nano>(built - start).count();
+        run.steerNs += std::chrono::duration<double, std::nano>(steered - built).count();
+    }
+    return run;
+}
+
+static bool sameState(const MosquitoSwarm& a, const MosquitoSwarm& b) {
+    size_t bytes = a.count * sizeof(float);
+    return memcmp(a.x.data(), b.x.data(), bytes) == 0 &&
+           memcmp(a.y.data(), b.y.data(), bytes) == 0 &&
+           memcmp(a.vx.data(), b.vx.data(), bytes) == 0 &&
+           memcmp(a.vy.data(), b.vy.data(), bytes) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    size_t maxCount = argc > 1 ? strtoul(argv[1], NULL, 10) : 256000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 60;
+    int threads = argc > 3 ? atoi(argv[3]) : static_cast<int>(defaultWorkerCount());
+    if(maxCount < 1000 || ticks <= 0 || threads < 0) {
+        fprintf(stderr, "usage: %s [max mosquitoes, at least 1000] [ticks] [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    WorkerPool serial, parallel;
+    startWorkerPool(serial, 0);
+    startWorkerPool(parallel, static_cast<unsigned>(threads));
+    bool allMatch = true;
+
+    printf("ticks: %d, workers: %d (plus the calling thread)\n", ticks, threads);
+    printf("%10s %10s %10s %12s %12s %12s\n", "mosquitoes", "build ms", "steer ms", "serial ns", "threaded ms",
+           "threaded ns");
+    for(size_t count = 1000; count <= maxCount; count *= 2) {
+        MosquitoSwarm serialSwarm, parallelSwarm;
+        SteeringRun one = runSwarm(serialSwarm, count, ticks, serial);
+        SteeringRun all = runSwarm(parallelSwarm, count, ticks, parallel);
+        bool match = sameState(serialSwarm, parallelSwarm);
+        allMatch = allMatch && match;
+
+        // Per tick; per mosquito covers the rebuild and the steering pass together
+        double serialNs = (one.buildNs + one.steerNs) / ticks;
+        double threadedNs = (all.buildNs + all.steerNs) / ticks;
+        printf("%10zu %10.3f %10.3f %12.2f %12.3f %12.2f  %s\n", count, one.buildNs / ticks * 1e-6,
+               one.steerNs / ticks * 1e-6, serialNs / count, threadedNs * 1e-6, threadedNs / count,
+               match ? "matches serial" : "MISMATCH");
+    }
+
+    stopWorkerPool(parallel);
+    stopWorkerPool(serial);
+    return allMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,95 @@
+/*
+ * Swarm update microbenchmark
+ * Times every available swarm kernel on the same seeded swarm, reports
+ * nanoseconds per mosquito per tick and checks the kernels agree bit for bit.
+ *
+ * Usage: swarm_bench [mosquitoes] [ticks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "../random.h"
+#include "../swarm.h"
+
+// Build a swarm with the same layout the app uses, every 7th mosquito dead
+static void seedSwarm(MosquitoSwarm& swarm, size_t count) {
+    initSwarm(swarm, count);
+    RandomStream random;
+    seedRandomStream(random, 12345, RANDOM_STREAM_BENCH);
+    for(size_t i = 0; i < count; i++) {
+        float x = randomRange(random, -4.5f, 4.5f);
+        float y = randomRange(random, -2.5f, 4.5f);
+        float vx = randomRange(random, -0.03f, 0.03f);
+        float vy = randomRange(random, -0.03f, 0.03f);
+        addMosquito(swarm, x, y, vx, vy);
+        swarm.jitterX[i] = randomRange(random, -0.0005f, 0.0005f);
+        swarm.jitterY[i] = randomRange(random, -0.0005f, 0.0005f);
+        if(i % 7 == 3) killMosquito(swarm, i);
+    }
+}
+
+static bool sameState(const MosquitoSwarm& a, const MosquitoSwarm& b) {
+    size_t bytes = a.count * sizeof(float);
+    return memcmp(a.x.data(), b.x.data(), bytes) == 0 &&
+           memcmp(a.y.data(), b.y.data(), bytes) == 0 &&
+           memcmp(a.vx.data(), b.vx.data(), bytes) == 0 &&
+           memcmp(a.vy.data(), b.vy.data(), bytes) == 0 &&
+           memcmp(a.wing.data(), b.wing.data(), bytes) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 200;
+    if(count == 0 || ticks <= 0) {
+        fprintf(stderr, "usage: %s [mosquitoes] [ticks]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    SwarmStepParams params;
+    params.step = 1.0f;
+    params.wingStep = 0.1f;
+    params.minX = -4.5f;
+    params.maxX = 4.5f;
+    params.minY = -2.5f;
+    params.maxY = 4.5f;
+    params.bounceDamping = 0.95f;
+    params.maxSpeed = 0.03f;
+
+    SwarmKernel kernels[] = {SWARM_KERNEL_SCALAR, SWARM_KERNEL_SSE2, SWARM_KERNEL_AVX2};
+    MosquitoSwarm reference;
+    bool haveReference = false;
+    bool allMatch = true;
+
+    printf("mosquitoes: %zu, ticks: %d\n", count, ticks);
+    for(SwarmKernel kernel : kernels) {
+        if(kernel != SWARM_KERNEL_SCALAR && resolveSwarmKernel(kernel) != kernel) {
+            printf("%-8s unavailable\n", swarmKernelName(kernel));
+            continue;
+        }
+
+        MosquitoSwarm swarm;
+        seedSwarm(swarm, count);
+        auto start = std::chrono::steady_clock::now();
+        for(int t = 0; t < ticks; t++) {
+            updateSwarm(swarm, params, kernel);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+        bool match = true;
+        if(!haveReference) {
+            reference = swarm;
+            haveReference = true;
+        } else {
+            match = sameState(reference, swarm);
+            allMatch = allMatch && match;
+        }
+        printf("%-8s %8.3f ns/mosquito/tick  %s\n", swarmKernelName(kernel),
+               ns / (static_cast<double>(count) * ticks), match ? "matches scalar" : "MISMATCH");
+    }
+
+    return allMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
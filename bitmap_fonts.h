@@ -0,0 +1,671 @@
+/*
+ * Embedded bitmap fonts
+ * Helvetica 12 and 18 as 1-bit glyph bitmaps, the same Adobe X11 fonts GLUT
+ * draws with glutBitmapCharacter, so text can be rasterized without GLUT or a
+ * display connection. Each glyph is as wide as its pen advance; its rows run
+ * bottom to top, each padded to whole bytes with the leftmost pixel in the high
+ * bit, and the bitmap sits descent rows below the baseline.
+ *
+ * The glyph data is copied from the fonts compiled into freeglut, which were
+ * generated from the Adobe Helvetica bitmap fonts of X11. freeglut's notice:
+ *
+ *   Copyright (C) 1999-2000 Pawel W. Olszta. All Rights Reserved.
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a
+ *   copy of this software and associated documentation files (the "Software"),
+ *   to deal in the Software without restriction, including without limitation
+ *   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *   and/or sell copies or substantial portions of the Software.
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *   PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ *   OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ *
+ *   Except as contained in this notice, the name of Pawel W. Olszta shall not
+ *   be used in advertising or otherwise to promote the sale, use or other
+ *   dealings in this Software without prior written authorization from Pawel
+ *   W. Olszta.
+ */
+
+#ifndef DENGUE_BITMAP_FONTS_H
+#define DENGUE_BITMAP_FONTS_H
+
+const int BITMAP_GLYPH_FIRST = 32; // Printable ASCII, space to tilde
+const int BITMAP_GLYPH_COUNT = 95;
+
+struct BitmapGlyph {
+    int width;  // Pen advance and bitmap width in pixels
+    int offset; // First byte of the glyph in the font's rows
+};
+
+struct BitmapFont {
+    int height;  // Rows per glyph
+    int descent; // Rows below the baseline
+    const BitmapGlyph* glyphs;
+    const unsigned char* rows;
+};
+
+// Whether pixel (x, y) of a glyph is set, y counted up from the bottom row
+inline bool bitmapGlyphPixel(const BitmapFont& font, const BitmapGlyph& glyph, int x, int y) {
+    int bytesPerRow = (glyph.width + 7) / 8;
+    unsigned char bits = font.rows[glyph.offset + y * bytesPerRow + x / 8];
+    return (bits & (0x80 >> (x % 8))) != 0;
+}
+
+// -adobe-helvetica-medium-r-normal--12-120-75-75-p-67-iso8859-1
+const unsigned char BITMAP_HELVETICA_12_ROWS[] = {
+    // ' '
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '!'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // '"'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x50, 0x50, 0x00, 0x00, 0x00,
+    // '#'
+    0x00, 0x00, 0x00, 0x00, 0x50, 0x50, 0x50, 0xfc, 0x28, 0xfc, 0x28, 0x28, 0x00, 0x00, 0x00, 0x00,
+    // '$'
+    0x00, 0x00, 0x00, 0x10, 0x38, 0x54, 0x54, 0x14, 0x38, 0x50, 0x54, 0x38, 0x10, 0x00, 0x00, 0x00,
+    // '%'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x80, 0x0a, 0x40, 0x0a, 0x40, 0x09, 0x80,
+    0x04, 0x00, 0x34, 0x00, 0x4a, 0x00, 0x4a, 0x00, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '&'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x00, 0x46, 0x00, 0x42, 0x00, 0x45, 0x00,
+    0x28, 0x00, 0x18, 0x00, 0x24, 0x00, 0x24, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '''
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x20, 0x60, 0x00, 0x00, 0x00,
+    // '('
+    0x00, 0x10, 0x20, 0x20, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x10, 0x00, 0x00, 0x00,
+    // ')'
+    0x00, 0x80, 0x40, 0x40, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00,
+    // '*'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x20, 0x50, 0x00, 0x00, 0x00,
+    // '+'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x7c, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ','
+    0x00, 0x00, 0x40, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '-'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '.'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '/'
+    0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x40, 0x40, 0x40, 0x20, 0x20, 0x10, 0x10, 0x00, 0x00, 0x00,
+    // '0'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // '1'
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x70, 0x10, 0x00, 0x00, 0x00,
+    // '2'
+    0x00, 0x00, 0x00, 0x00, 0x7c, 0x40, 0x40, 0x20, 0x10, 0x08, 0x04, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // '3'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x04, 0x04, 0x18, 0x04, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // '4'
+    0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0xfc, 0x88, 0x48, 0x28, 0x28, 0x18, 0x08, 0x00, 0x00, 0x00,
+    // '5'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x04, 0x04, 0x78, 0x40, 0x40, 0x7c, 0x00, 0x00, 0x00,
+    // '6'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x64, 0x58, 0x40, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // '7'
+    0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x10, 0x10, 0x10, 0x08, 0x08, 0x04, 0x7c, 0x00, 0x00, 0x00,
+    // '8'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x38, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // '9'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x04, 0x04, 0x3c, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // ':'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ';'
+    0x00, 0x00, 0x80, 0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '<'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x30, 0xc0, 0x30, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '='
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '>'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x18, 0x06, 0x18, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '?'
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x10, 0x10, 0x08, 0x08, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+    // '@'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x20, 0x00, 0x4d, 0x80, 0x53, 0x40, 0x51, 0x20,
+    0x51, 0x20, 0x49, 0x20, 0x26, 0xa0, 0x30, 0x40, 0x0f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'A'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x3e, 0x00,
+    0x22, 0x00, 0x22, 0x00, 0x14, 0x00, 0x14, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'B'
+    0x00, 0x00, 0x00, 0x00, 0x7c, 0x42, 0x42, 0x42, 0x7c, 0x42, 0x42, 0x42, 0x7c, 0x00, 0x00, 0x00,
+    // 'C'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x21, 0x00, 0x40, 0x00, 0x40, 0x00,
+    0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x21, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'D'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x42, 0x00, 0x41, 0x00, 0x41, 0x00,
+    0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x42, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'E'
+    0x00, 0x00, 0x00, 0x00, 0x7e, 0x40, 0x40, 0x40, 0x7e, 0x40, 0x40, 0x40, 0x7e, 0x00, 0x00, 0x00,
+    // 'F'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x7c, 0x40, 0x40, 0x40, 0x7e, 0x00, 0x00, 0x00,
+    // 'G'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x23, 0x00, 0x41, 0x00, 0x41, 0x00,
+    0x47, 0x00, 0x40, 0x00, 0x40, 0x00, 0x21, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'H'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00,
+    0x7f, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'I'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'J'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00,
+    // 'K'
+    0x00, 0x00, 0x00, 0x00, 0x41, 0x42, 0x44, 0x48, 0x70, 0x50, 0x48, 0x44, 0x42, 0x00, 0x00, 0x00,
+    // 'L'
+    0x00, 0x00, 0x00, 0x00, 0x7c, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'M'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x40, 0x44, 0x40, 0x4a, 0x40, 0x4a, 0x40,
+    0x51, 0x40, 0x51, 0x40, 0x60, 0xc0, 0x60, 0xc0, 0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'N'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x43, 0x00, 0x45, 0x00, 0x45, 0x00,
+    0x49, 0x00, 0x51, 0x00, 0x51, 0x00, 0x61, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'O'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x21, 0x00, 0x40, 0x80, 0x40, 0x80,
+    0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x21, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'P'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x7c, 0x42, 0x42, 0x42, 0x7c, 0x00, 0x00, 0x00,
+    // 'Q'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x80, 0x21, 0x00, 0x42, 0x80, 0x44, 0x80,
+    0x40, 0x80, 0x40, 0x80, 0x40, 0x80, 0x21, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'R'
+    0x00, 0x00, 0x00, 0x00, 0x42, 0x42, 0x42, 0x44, 0x7c, 0x42, 0x42, 0x42, 0x7c, 0x00, 0x00, 0x00,
+    // 'S'
+    0x00, 0x00, 0x00, 0x00, 0x3c, 0x42, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x42, 0x3c, 0x00, 0x00, 0x00,
+    // 'T'
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0xfe, 0x00, 0x00, 0x00,
+    // 'U'
+    0x00, 0x00, 0x00, 0x00, 0x3c, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x00, 0x00, 0x00,
+    // 'V'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x14, 0x00, 0x14, 0x00,
+    0x22, 0x00, 0x22, 0x00, 0x22, 0x00, 0x41, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'W'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x11, 0x00, 0x11, 0x00, 0x2a, 0x80,
+    0x2a, 0x80, 0x24, 0x80, 0x44, 0x40, 0x44, 0x40, 0x44, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'X'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x22, 0x00, 0x22, 0x00, 0x14, 0x00,
+    0x08, 0x00, 0x14, 0x00, 0x22, 0x00, 0x22, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Y'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x08, 0x00, 0x08, 0x00,
+    0x14, 0x00, 0x22, 0x00, 0x22, 0x00, 0x41, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Z'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x40, 0x00, 0x20, 0x00, 0x10, 0x00,
+    0x08, 0x00, 0x04, 0x00, 0x02, 0x00, 0x01, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '['
+    0x00, 0x60, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x60, 0x00, 0x00, 0x00,
+    // '\\'
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x20, 0x20, 0x20, 0x40, 0x40, 0x80, 0x80, 0x00, 0x00, 0x00,
+    // ']'
+    0x00, 0xc0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0xc0, 0x00, 0x00, 0x00,
+    // '^'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x50, 0x20, 0x00, 0x00, 0x00, 0x00,
+    // '_'
+    0x00, 0x00, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '`'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x80, 0x40, 0x00, 0x00, 0x00,
+    // 'a'
+    0x00, 0x00, 0x00, 0x00, 0x3a, 0x44, 0x44, 0x3c, 0x04, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'b'
+    0x00, 0x00, 0x00, 0x00, 0x58, 0x64, 0x44, 0x44, 0x44, 0x64, 0x58, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'c'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x40, 0x40, 0x40, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'd'
+    0x00, 0x00, 0x00, 0x00, 0x34, 0x4c, 0x44, 0x44, 0x44, 0x4c, 0x34, 0x04, 0x04, 0x00, 0x00, 0x00,
+    // 'e'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x40, 0x7c, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'f'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0xe0, 0x40, 0x30, 0x00, 0x00, 0x00,
+    // 'g'
+    0x00, 0x38, 0x44, 0x04, 0x34, 0x4c, 0x44, 0x44, 0x44, 0x4c, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'h'
+    0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x64, 0x58, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'i'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00,
+    // 'j'
+    0x00, 0x80, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00,
+    // 'k'
+    0x00, 0x00, 0x00, 0x00, 0x44, 0x48, 0x50, 0x60, 0x60, 0x50, 0x48, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'l'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'm'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x49, 0x00, 0x49, 0x00, 0x49, 0x00,
+    0x49, 0x00, 0x6d, 0x00, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'n'
+    0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x64, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'o'
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'p'
+    0x00, 0x40, 0x40, 0x40, 0x58, 0x64, 0x44, 0x44, 0x44, 0x64, 0x58, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'q'
+    0x00, 0x04, 0x04, 0x04, 0x34, 0x4c, 0x44, 0x44, 0x44, 0x4c, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'r'
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x60, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 's'
+    0x00, 0x00, 0x00, 0x00, 0x30, 0x48, 0x08, 0x30, 0x40, 0x48, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 't'
+    0x00, 0x00, 0x00, 0x00, 0x60, 0x40, 0x40, 0x40, 0x40, 0x40, 0xe0, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // 'u'
+    0x00, 0x00, 0x00, 0x00, 0x34, 0x4c, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'v'
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x28, 0x28, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'w'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x00, 0x22, 0x00, 0x55, 0x00, 0x49, 0x00,
+    0x49, 0x00, 0x88, 0x80, 0x88, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'x'
+    0x00, 0x00, 0x00, 0x00, 0x84, 0x84, 0x48, 0x30, 0x30, 0x48, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'y'
+    0x00, 0x40, 0x20, 0x10, 0x10, 0x28, 0x28, 0x48, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'z'
+    0x00, 0x00, 0x00, 0x00, 0x78, 0x40, 0x20, 0x20, 0x10, 0x08, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '{'
+    0x00, 0x30, 0x40, 0x40, 0x40, 0x40, 0x40, 0x80, 0x40, 0x40, 0x40, 0x40, 0x30, 0x00, 0x00, 0x00,
+    // '|'
+    0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00,
+    // '}'
+    0x00, 0xc0, 0x20, 0x20, 0x20, 0x20, 0x20, 0x10, 0x20, 0x20, 0x20, 0x20, 0xc0, 0x00, 0x00, 0x00,
+    // '~'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x98, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const BitmapGlyph BITMAP_HELVETICA_12_GLYPHS[BITMAP_GLYPH_COUNT] = {
+    {4, 0}, {3, 16}, {5, 32}, {7, 48}, {7, 64}, {11, 80}, {9, 112}, {3, 144},
+    {4, 160}, {4, 176}, {5, 192}, {7, 208}, {4, 224}, {8, 240}, {3, 256}, {4, 272},
+    {7, 288}, {7, 304}, {7, 320}, {7, 336}, {7, 352}, {7, 368}, {7, 384}, {7, 400},
+    {7, 416}, {7, 432}, {3, 448}, {3, 464}, {7, 480}, {7, 496}, {7, 512}, {7, 528},
+    {12, 544}, {9, 576}, {8, 608}, {9, 624}, {9, 656}, {8, 688}, {8, 704}, {9, 720},
+    {9, 752}, {3, 784}, {7, 800}, {8, 816}, {7, 832}, {11, 848}, {9, 880}, {10, 912},
+    {8, 944}, {10, 960}, {8, 992}, {8, 1008}, {7, 1024}, {8, 1040}, {9, 1056}, {11, 1088},
+    {9, 1120}, {9, 1152}, {9, 1184}, {3, 1216}, {4, 1232}, {3, 1248}, {6, 1264}, {7, 1280},
+    {3, 1296}, {7, 1312}, {7, 1328}, {7, 1344}, {7, 1360}, {7, 1376}, {3, 1392}, {7, 1408},
+    {7, 1424}, {3, 1440}, {3, 1456}, {6, 1472}, {3, 1488}, {9, 1504}, {7, 1536}, {7, 1552},
+    {7, 1568}, {7, 1584}, {4, 1600}, {6, 1616}, {3, 1632}, {7, 1648}, {7, 1664}, {9, 1680},
+    {6, 1712}, {7, 1728}, {6, 1744}, {4, 1760}, {3, 1776}, {4, 1792}, {7, 1808},
+};
+
+const BitmapFont BITMAP_HELVETICA_12 = {16, 4, BITMAP_HELVETICA_12_GLYPHS, BITMAP_HELVETICA_12_ROWS};
+
+// -adobe-helvetica-medium-r-normal--18-180-75-75-p-98-iso8859-1
+const unsigned char BITMAP_HELVETICA_18_ROWS[] = {
+    // ' '
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '!'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x20, 0x20, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+    // '"'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x90,
+    0xd8, 0xd8, 0xd8, 0x00, 0x00, 0x00, 0x00,
+    // '#'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x24, 0x00, 0x24, 0x00,
+    0xff, 0x80, 0xff, 0x80, 0x12, 0x00, 0x12, 0x00, 0x12, 0x00, 0x7f, 0xc0, 0x7f, 0xc0, 0x09, 0x00,
+    0x09, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '$'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x1f, 0x00, 0x3f, 0x80, 0x75, 0xc0,
+    0x64, 0xc0, 0x04, 0xc0, 0x07, 0x80, 0x1f, 0x00, 0x3c, 0x00, 0x74, 0x00, 0x64, 0x00, 0x65, 0x80,
+    0x3f, 0x80, 0x1f, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '%'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x3c, 0x0c, 0x7e, 0x06, 0x66,
+    0x06, 0x66, 0x03, 0x7e, 0x03, 0x3c, 0x01, 0x80, 0x3d, 0x80, 0x7e, 0xc0, 0x66, 0xc0, 0x66, 0x60,
+    0x7e, 0x60, 0x3c, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '&'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x38, 0x3f, 0x70, 0x73, 0xe0,
+    0x61, 0xc0, 0x61, 0xe0, 0x63, 0x60, 0x77, 0x60, 0x3e, 0x00, 0x1e, 0x00, 0x33, 0x00, 0x33, 0x00,
+    0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '''
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x20,
+    0x20, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // '('
+    0x00, 0x08, 0x18, 0x30, 0x30, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x30,
+    0x30, 0x18, 0x08, 0x00, 0x00, 0x00, 0x00,
+    // ')'
+    0x00, 0x40, 0x60, 0x30, 0x30, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x30,
+    0x30, 0x60, 0x40, 0x00, 0x00, 0x00, 0x00,
+    // '*'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x38, 0x38,
+    0x7c, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00,
+    // '+'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00,
+    0x0c, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ','
+    0x00, 0x00, 0x40, 0x20, 0x20, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '-'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '.'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '/'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xc0, 0x40, 0x40, 0x60, 0x60, 0x20, 0x20, 0x30, 0x30, 0x10,
+    0x10, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00,
+    // '0'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x3f, 0x00, 0x33, 0x00,
+    0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x33, 0x00,
+    0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '1'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x3e, 0x00,
+    0x3e, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '2'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x60, 0x00,
+    0x70, 0x00, 0x38, 0x00, 0x1c, 0x00, 0x0e, 0x00, 0x07, 0x00, 0x03, 0x80, 0x01, 0x80, 0x61, 0x80,
+    0x7f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '3'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x3f, 0x00, 0x63, 0x80,
+    0x61, 0x80, 0x01, 0x80, 0x03, 0x80, 0x0f, 0x00, 0x0e, 0x00, 0x03, 0x00, 0x61, 0x80, 0x61, 0x80,
+    0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '4'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80,
+    0x7f, 0xc0, 0x7f, 0xc0, 0x61, 0x80, 0x31, 0x80, 0x19, 0x80, 0x19, 0x80, 0x0d, 0x80, 0x07, 0x80,
+    0x03, 0x80, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '5'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x00, 0x7f, 0x00, 0x63, 0x80,
+    0x61, 0x80, 0x01, 0x80, 0x01, 0x80, 0x63, 0x80, 0x7f, 0x00, 0x7e, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0x7f, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '6'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x3f, 0x00, 0x71, 0x80,
+    0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x7f, 0x00, 0x6e, 0x00, 0x60, 0x00, 0x60, 0x00, 0x31, 0x80,
+    0x3f, 0x80, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '7'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x30, 0x00, 0x18, 0x00,
+    0x18, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x06, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80,
+    0x7f, 0x80, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '8'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x3f, 0x00, 0x73, 0x80,
+    0x61, 0x80, 0x61, 0x80, 0x33, 0x00, 0x3f, 0x00, 0x33, 0x00, 0x61, 0x80, 0x61, 0x80, 0x73, 0x80,
+    0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '9'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x00, 0x7f, 0x00, 0x63, 0x00,
+    0x01, 0x80, 0x01, 0x80, 0x1d, 0x80, 0x3f, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x63, 0x80,
+    0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ':'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ';'
+    0x00, 0x00, 0x40, 0x20, 0x20, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '<'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x07, 0x80, 0x1e, 0x00,
+    0x38, 0x00, 0x60, 0x00, 0x38, 0x00, 0x1e, 0x00, 0x07, 0x80, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '='
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x80,
+    0x3f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x80, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '>'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x78, 0x00, 0x1e, 0x00,
+    0x07, 0x00, 0x01, 0x80, 0x07, 0x00, 0x1e, 0x00, 0x78, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '?'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x1c, 0x00, 0x0e, 0x00, 0x07, 0x00, 0x63, 0x00,
+    0x63, 0x00, 0x7f, 0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '@'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x0f, 0xf8, 0x00, 0x1c, 0x00, 0x00, 0x38,
+    0x00, 0x00, 0x33, 0xb8, 0x00, 0x67, 0xfc, 0x00, 0x66, 0x66, 0x00, 0x66, 0x33, 0x00, 0x66, 0x33,
+    0x00, 0x66, 0x31, 0x80, 0x63, 0x19, 0x80, 0x33, 0xb9, 0x80, 0x31, 0xd9, 0x80, 0x18, 0x03, 0x00,
+    0x0e, 0x07, 0x00, 0x07, 0xfe, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'A'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x30, 0xc0, 0x30, 0x60, 0x60,
+    0x60, 0x60, 0x7f, 0xe0, 0x3f, 0xc0, 0x30, 0xc0, 0x30, 0xc0, 0x19, 0x80, 0x19, 0x80, 0x0f, 0x00,
+    0x0f, 0x00, 0x06, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'B'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x7f, 0xe0, 0x60, 0x70,
+    0x60, 0x30, 0x60, 0x30, 0x60, 0x70, 0x7f, 0xe0, 0x7f, 0xc0, 0x60, 0xc0, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0xe0, 0x7f, 0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'C'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xc0, 0x1f, 0xf0, 0x38, 0x38,
+    0x30, 0x18, 0x70, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x70, 0x00, 0x30, 0x18,
+    0x38, 0x38, 0x1f, 0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'D'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x80, 0x7f, 0xc0, 0x60, 0xe0,
+    0x60, 0x60, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x60,
+    0x60, 0xe0, 0x7f, 0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'E'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x7f, 0xc0, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x7f, 0xc0, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'F'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x7f, 0xc0, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'G'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xd8, 0x1f, 0xf8, 0x38, 0x38,
+    0x30, 0x18, 0x70, 0x18, 0x60, 0xf8, 0x60, 0xf8, 0x60, 0x00, 0x60, 0x00, 0x70, 0x18, 0x30, 0x18,
+    0x38, 0x38, 0x1f, 0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'H'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30,
+    0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x7f, 0xf0, 0x7f, 0xf0, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30,
+    0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'I'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+    // 'J'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x3f, 0x00, 0x73, 0x80,
+    0x61, 0x80, 0x61, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80,
+    0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'K'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x38, 0x60, 0x70, 0x60, 0xe0,
+    0x61, 0xc0, 0x63, 0x80, 0x67, 0x00, 0x7e, 0x00, 0x7c, 0x00, 0x6e, 0x00, 0x67, 0x00, 0x63, 0x80,
+    0x61, 0xc0, 0x60, 0xe0, 0x60, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'L'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'M'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x86, 0x61, 0x86, 0x63, 0xc6,
+    0x62, 0x46, 0x66, 0x66, 0x66, 0x66, 0x6c, 0x36, 0x6c, 0x36, 0x78, 0x1e, 0x78, 0x1e, 0x70, 0x0e,
+    0x70, 0x0e, 0x60, 0x06, 0x60, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'N'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x30, 0x60, 0x70, 0x60, 0xf0,
+    0x60, 0xf0, 0x61, 0xb0, 0x63, 0x30, 0x63, 0x30, 0x66, 0x30, 0x66, 0x30, 0x6c, 0x30, 0x78, 0x30,
+    0x78, 0x30, 0x70, 0x30, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'O'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xc0, 0x1f, 0xf0, 0x38, 0x38,
+    0x30, 0x18, 0x70, 0x1c, 0x60, 0x0c, 0x60, 0x0c, 0x60, 0x0c, 0x60, 0x0c, 0x70, 0x1c, 0x30, 0x18,
+    0x38, 0x38, 0x1f, 0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'P'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f, 0x80, 0x7f, 0xc0, 0x60, 0xe0, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0xe0, 0x7f, 0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Q'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x07, 0xd8, 0x1f, 0xf0, 0x38, 0x78,
+    0x30, 0xd8, 0x70, 0xdc, 0x60, 0x0c, 0x60, 0x0c, 0x60, 0x0c, 0x60, 0x0c, 0x70, 0x1c, 0x30, 0x18,
+    0x38, 0x38, 0x1f, 0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'R'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0xc0, 0x60, 0xc0, 0x7f, 0x80, 0x7f, 0xc0, 0x60, 0xe0, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0xe0, 0x7f, 0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'S'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x80, 0x3f, 0xe0, 0x70, 0x70,
+    0x60, 0x30, 0x00, 0x30, 0x00, 0x70, 0x01, 0xe0, 0x0f, 0x80, 0x3e, 0x00, 0x70, 0x00, 0x60, 0x30,
+    0x70, 0x70, 0x3f, 0xe0, 0x0f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'T'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0x06, 0x00, 0x7f, 0xe0, 0x7f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'U'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x80, 0x3f, 0xe0, 0x30, 0x60,
+    0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30,
+    0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'V'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x07, 0x80, 0x07, 0x80,
+    0x0c, 0xc0, 0x0c, 0xc0, 0x0c, 0xc0, 0x18, 0x60, 0x18, 0x60, 0x18, 0x60, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x60, 0x18, 0x60, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'W'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c,
+    0x0c, 0x00, 0x0c, 0x0c, 0x00, 0x0e, 0x1c, 0x00, 0x1a, 0x16, 0x00, 0x1b, 0x36, 0x00, 0x1b, 0x36,
+    0x00, 0x33, 0x33, 0x00, 0x33, 0x33, 0x00, 0x31, 0x23, 0x00, 0x31, 0xe3, 0x00, 0x61, 0xe1, 0x80,
+    0x60, 0xc1, 0x80, 0x60, 0xc1, 0x80, 0x60, 0xc1, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'X'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x30, 0x70, 0x70, 0x30, 0x60,
+    0x38, 0xe0, 0x18, 0xc0, 0x0d, 0x80, 0x07, 0x00, 0x07, 0x00, 0x0d, 0x80, 0x18, 0xc0, 0x38, 0xe0,
+    0x30, 0x60, 0x70, 0x70, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Y'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00,
+    0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x07, 0x80, 0x0c, 0xc0, 0x18, 0x60, 0x18, 0x60, 0x30, 0x30,
+    0x30, 0x30, 0x60, 0x18, 0x60, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Z'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xe0, 0x7f, 0xe0, 0x60, 0x00,
+    0x30, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x0e, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xc0,
+    0x00, 0x60, 0x7f, 0xe0, 0x7f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '['
+    0x00, 0x78, 0x78, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x78, 0x78, 0x00, 0x00, 0x00, 0x00,
+    // '\\'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x10, 0x10, 0x30, 0x30, 0x20, 0x20, 0x60, 0x60, 0x40,
+    0x40, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00,
+    // ']'
+    0x00, 0xf0, 0xf0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+    // '^'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x63, 0x00, 0x36, 0x00,
+    0x1c, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '_'
+    0x00, 0x00, 0xff, 0xc0, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '`'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60,
+    0x40, 0x40, 0x20, 0x00, 0x00, 0x00, 0x00,
+    // 'a'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3b, 0x00, 0x77, 0x00, 0x63, 0x00,
+    0x63, 0x00, 0x73, 0x00, 0x3f, 0x00, 0x07, 0x00, 0x63, 0x00, 0x77, 0x00, 0x3e, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'b'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6f, 0x00, 0x7f, 0x80, 0x71, 0x80,
+    0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x71, 0x80, 0x7f, 0x80, 0x6f, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'c'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x3f, 0x80, 0x31, 0x80,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x31, 0x80, 0x3f, 0x80, 0x1f, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'd'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0xc0, 0x3f, 0xc0, 0x31, 0xc0,
+    0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x31, 0xc0, 0x3f, 0xc0, 0x1e, 0xc0, 0x00, 0xc0,
+    0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'e'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x3f, 0x80, 0x71, 0x80,
+    0x60, 0x00, 0x60, 0x00, 0x7f, 0x80, 0x61, 0x80, 0x61, 0x80, 0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'f'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xfc, 0xfc, 0x30,
+    0x30, 0x3c, 0x1c, 0x00, 0x00, 0x00, 0x00,
+    // 'g'
+    0x00, 0x00, 0x0e, 0x00, 0x3f, 0x80, 0x31, 0x80, 0x00, 0xc0, 0x1e, 0xc0, 0x3f, 0xc0, 0x31, 0xc0,
+    0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x30, 0xc0, 0x3f, 0xc0, 0x1e, 0xc0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'h'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80,
+    0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x71, 0x80, 0x6f, 0x80, 0x67, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'i'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x00,
+    0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // 'j'
+    0x00, 0xc0, 0xe0, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x00,
+    0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // 'k'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x80, 0x63, 0x00, 0x67, 0x00,
+    0x66, 0x00, 0x6c, 0x00, 0x7c, 0x00, 0x78, 0x00, 0x6c, 0x00, 0x66, 0x00, 0x63, 0x00, 0x60, 0x00,
+    0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'l'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // 'm'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18,
+    0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x73, 0x98, 0x6f, 0x78, 0x66, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'n'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80,
+    0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x71, 0x80, 0x6f, 0x80, 0x67, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'o'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x3f, 0x80, 0x31, 0x80,
+    0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x31, 0x80, 0x3f, 0x80, 0x1f, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'p'
+    0x00, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x6f, 0x00, 0x7f, 0x80, 0x71, 0x80,
+    0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x71, 0x80, 0x7f, 0x80, 0x6f, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'q'
+    0x00, 0x00, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x1e, 0xc0, 0x3f, 0xc0, 0x31, 0xc0,
+    0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x31, 0xc0, 0x3f, 0xc0, 0x1e, 0xc0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'r'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x70, 0x6c, 0x6c, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 's'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x7e, 0x00, 0x63, 0x00,
+    0x03, 0x00, 0x1f, 0x00, 0x7e, 0x00, 0x60, 0x00, 0x63, 0x00, 0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 't'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xfc, 0xfc, 0x30,
+    0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'u'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x80, 0x7d, 0x80, 0x63, 0x80,
+    0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'v'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x1e, 0x00,
+    0x12, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'w'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0xc0, 0x0c, 0xc0, 0x1c, 0xe0,
+    0x14, 0xa0, 0x34, 0xb0, 0x33, 0x30, 0x33, 0x30, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'x'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x80, 0x73, 0x80, 0x33, 0x00,
+    0x1e, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x1e, 0x00, 0x33, 0x00, 0x73, 0x80, 0x61, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'y'
+    0x00, 0x00, 0x38, 0x00, 0x38, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x1e, 0x00,
+    0x12, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'z'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x60, 0x00,
+    0x30, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x06, 0x00, 0x03, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '{'
+    0x00, 0x0c, 0x18, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x60, 0xc0, 0x60, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x18, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    // '|'
+    0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // '}'
+    0x00, 0xc0, 0x60, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x18, 0x0c, 0x18, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x60, 0xc0, 0x00, 0x00, 0x00, 0x00,
+    // '~'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x66, 0x00, 0x3f, 0x00, 0x19, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const BitmapGlyph BITMAP_HELVETICA_18_GLYPHS[BITMAP_GLYPH_COUNT] = {
+    {5, 0}, {6, 23}, {5, 46}, {10, 69}, {10, 115}, {16, 161}, {13, 207}, {4, 253},
+    {6, 276}, {6, 299}, {7, 322}, {10, 345}, {5, 391}, {11, 414}, {5, 460}, {5, 483},
+    {10, 506}, {10, 552}, {10, 598}, {10, 644}, {10, 690}, {10, 736}, {10, 782}, {10, 828},
+    {10, 874}, {10, 920}, {5, 966}, {5, 989}, {10, 1012}, {11, 1058}, {10, 1104}, {10, 1150},
+    {18, 1196}, {12, 1265}, {13, 1311}, {14, 1357}, {13, 1403}, {11, 1449}, {11, 1495}, {14, 1541},
+    {13, 1587}, {6, 1633}, {10, 1656}, {13, 1702}, {10, 1748}, {16, 1794}, {13, 1840}, {15, 1886},
+    {12, 1932}, {15, 1978}, {12, 2024}, {13, 2070}, {12, 2116}, {13, 2162}, {14, 2208}, {18, 2254},
+    {13, 2323}, {14, 2369}, {12, 2415}, {5, 2461}, {5, 2484}, {5, 2507}, {9, 2530}, {10, 2576},
+    {4, 2622}, {9, 2645}, {11, 2691}, {10, 2737}, {11, 2783}, {10, 2829}, {6, 2875}, {11, 2898},
+    {10, 2944}, {4, 2990}, {4, 3013}, {9, 3036}, {4, 3082}, {14, 3105}, {10, 3151}, {11, 3197},
+    {11, 3243}, {11, 3289}, {6, 3335}, {9, 3358}, {6, 3404}, {10, 3427}, {10, 3473}, {14, 3519},
+    {10, 3565}, {10, 3611}, {9, 3657}, {6, 3703}, {4, 3726}, {6, 3749}, {10, 3772},
+};
+
+const BitmapFont BITMAP_HELVETICA_18 = {23, 5, BITMAP_HELVETICA_18_GLYPHS, BITMAP_HELVETICA_18_ROWS};
+
+#endif
@@ -0,0 +1,578 @@
+/*
+ * Columnar case-report store
+ * Daily per-district case reports arrive as CSV files with tens of millions of
+ * rows. The first run maps the CSV, finds delimiters 64 bytes at a time and
+ * writes the rows as fixed-width columns, together with per-year and per-day
+ * totals, to a binary file next to it. Later runs map that file and use the
+ * columns in place, with no parsing.
+ */
+
+#ifndef DENGUE_CASE_STORE_H
+#define DENGUE_CASE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CASE_STORE_HAS_SSE2 1
+#include <immintrin.h>
+#endif
+
+// The file layout is the in-memory layout of a little-endian machine
+const char CASE_STORE_MAGIC[8] = {'D', 'C', 'A', 'S', 'E', 'S', '0', '1'};
+const uint64_t CASE_STORE_ALIGN = 64;
+const size_t CASE_STORE_CHUNK = 65536; // Rows buffered per column while converting
+
+struct CaseStoreHeader {
+    char magic[8];
+    uint64_t sourceSize;   // Size and modification time of the CSV the store was built from
+    int64_t sourceTime;
+    uint64_t rows;
+    uint64_t skippedRows;  // Malformed CSV lines left out
+    uint32_t districtCount;
+    uint32_t yearCount;
+    uint32_t dayCount;
+    uint32_t reserved;
+    // Byte offsets of the sections, each aligned to CASE_STORE_ALIGN
+    uint64_t dayOffset;        // int32_t days since 1970-01-01, one per row
+    uint64_t yearOffset;       // uint16_t
+    uint64_t districtOffset;   // uint16_t index into the district names
+    uint64_t casesOffset;      // uint32_t
+    uint64_t deathsOffset;     // uint32_t
+    uint64_t preventionOffset; // uint32_t
+    uint64_t yearTotalsOffset; // CaseTotals sorted by year
+    uint64_t dayTotalsOffset;  // CaseTotals sorted by day
+    uint64_t nameIndexOffset;  // uint32_t offset of each district name in the name block
+    uint64_t namesOffset;      // Null-terminated district names
+    uint64_t namesSize;
+};
+
+struct CaseTotals {
+    int32_t key;   // Year, or days since 1970-01-01
+    uint32_t reserved;
+    uint64_t rows;
+    uint64_t cases;
+    uint64_t deaths;
+    uint64_t prevention;
+};
+
+// Mapped store; the column pointers point straight into the file
+struct CaseStore {
+    MappedFile file;
+    size_t rows;
+    size_t skippedRows;
+    const int32_t* day;
+    const uint16_t* year;
+    const uint16_t* district;
+    const uint32_t* cases;
+    const uint32_t* deaths;
+    const uint32_t* prevention;
+    const CaseTotals* yearTotals;
+    size_t yearCount;
+    const CaseTotals* dayTotals;
+    size_t dayCount;
+    const uint32_t* nameIndex;
+    const char* names;
+    size_t districtCount;
+};
+
+inline const char* districtName(const CaseStore& store, size_t district) {
+    return district < store.districtCount ? store.names + store.nameIndex[district] : "";
+}
+
+inline uint64_t alignCaseOffset(uint64_t offset) {
+    return (offset + CASE_STORE_ALIGN - 1) / CASE_STORE_ALIGN * CASE_STORE_ALIGN;
+}
+
+inline bool caseSectionFits(const MappedFile& file, uint64_t offset, uint64_t bytes) {
+    return offset % CASE_STORE_ALIGN == 0 && offset <= file.size && bytes <= file.size - offset;
+}
+
+inline void closeCaseStore(CaseStore& store) {
+    unmapFile(store.file);
+    memset(&store, 0, sizeof(store));
+}
+
+// Map a store written by convertCaseCsv and check its sections lie inside the file
+inline bool openCaseStore(CaseStore& store, const char* path) {
+    memset(&store, 0, sizeof(store));
+    if(!mapFile(store.file, path)) return false;
+    const MappedFile& file = store.file;
+    if(file.size < sizeof(CaseStoreHeader) || memcmp(file.data, CASE_STORE_MAGIC, 8) != 0) {
+        closeCaseStore(store);
+        return false;
+    }
+    CaseStoreHeader header;
+    memcpy(&header, file.data, sizeof(header));
+    uint64_t rows = header.rows;
+    bool valid = rows <= file.size &&
+        caseSectionFits(file, header.dayOffset, rows * sizeof(int32_t)) &&
+        caseSectionFits(file, header.yearOffset, rows * sizeof(uint16_t)) &&
+        caseSectionFits(file, header.districtOffset, rows * sizeof(uint16_t)) &&
+        caseSectionFits(file, header.casesOffset, rows * sizeof(uint32_t)) &&
+        caseSectionFits(file, header.deathsOffset, rows * sizeof(uint32_t)) &&
+        caseSectionFits(file, header.preventionOffset, rows * sizeof(uint32_t)) &&
+        caseSectionFits(file, header.yearTotalsOffset, uint64_t(header.yearCount) * sizeof(CaseTotals)) &&
+        caseSectionFits(file, header.dayTotalsOffset, uint64_t(header.dayCount) * sizeof(CaseTotals)) &&
+        caseSectionFits(file, header.nameIndexOffset, uint64_t(header.districtCount) * sizeof(uint32_t)) &&
+        caseSectionFits(file, header.namesOffset, header.namesSize) &&
+        (header.namesSize == 0 || file.data[header.namesOffset + header.namesSize - 1] == '\0');
+    if(!valid) {
+        closeCaseStore(store);
+        return false;
+    }
+
+    const char* base = file.data;
+    store.rows = static_cast<size_t>(rows);
+    store.skippedRows = static_cast<size_t>(header.skippedRows);
+    store.day = reinterpret_cast<const int32_t*>(base + header.dayOffset);
+    store.year = reinterpret_cast<const uint16_t*>(base + header.yearOffset);
+    store.district = reinterpret_cast<const uint16_t*>(base + header.districtOffset);
+    store.cases = reinterpret_cast<const uint32_t*>(base + header.casesOffset);
+    store.deaths = reinterpret_cast<const uint32_t*>(base + header.deathsOffset);
+    store.prevention = reinterpret_cast<const uint32_t*>(base + header.preventionOffset);
+    store.yearTotals = reinterpret_cast<const CaseTotals*>(base + header.yearTotalsOffset);
+    store.yearCount = header.yearCount;
+    store.dayTotals = reinterpret_cast<const CaseTotals*>(base + header.dayTotalsOffset);
+    store.dayCount = header.dayCount;
+    store.nameIndex = reinterpret_cast<const uint32_t*>(base + header.nameIndexOffset);
+    store.names = base + header.namesOffset;
+    store.districtCount = header.districtCount;
+    for(size_t i = 0; i < store.districtCount; i++) {
+        if(store.nameIndex[i] >= header.namesSize) {
+            closeCaseStore(store);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Bit i set where p[i] is a comma or a newline
+inline uint64_t caseDelimiterMaskScalar(const char* p, size_t count) {
+    uint64_t mask = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(p[i] == ',' || p[i] == '\n') mask |= uint64_t(1) << i;
+    }
+    return mask;
+}
+
+#ifdef CASE_STORE_HAS_SSE2
+__attribute__((target("sse2")))
+inline uint64_t caseDelimiterMask64(const char* p) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t mask = 0;
+    for(int i = 0; i < 4; i++) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, newline));
+        mask |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(hits))) << (i * 16);
+    }
+    return mask;
+}
+#else
+inline uint64_t caseDelimiterMask64(const char* p) {
+    return caseDelimiterMaskScalar(p, 64);
+}
+#endif
+
+inline unsigned lowestSetBit(uint64_t mask) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+    unsigned bit = 0;
+    while(!(mask & 1)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+inline int32_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Date of a day counted from 1970-01-01, the inverse of daysFromCivil
+inline void civilFromDays(int32_t days, int& year, int& month, int& day) {
+    int32_t z = days + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int dayOfEra = z - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int shiftedMonth = (5 * dayOfYear + 2) / 153; // March is 0
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+inline bool isCaseBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '"';
+}
+
+inline void trimCaseField(const char*& begin, const char*& end) {
+    while(begin < end && isCaseBlank(*begin)) begin++;
+    while(end > begin && isCaseBlank(end[-1])) end--;
+}
+
+// Unsigned count, clamped to 32 bits; empty fields count as 0
+inline bool parseCaseCount(const char* begin, const char* end, uint32_t& value) {
+    trimCaseField(begin, end);
+    uint64_t result = 0;
+    for(const char* p = begin; p < end; p++) {
+        unsigned digit = static_cast<unsigned>(*p - '0');
+        if(digit > 9) return false;
+        result = result * 10 + digit;
+        if(result > UINT32_MAX) result = UINT32_MAX;
+    }
+    value = static_cast<uint32_t>(result);
+    return true;
+}
+
+inline bool parseCaseNumber(const char*& p, const char* end, int digits, int& value) {
+    value = 0;
+    int read = 0;
+    while(p < end && read < digits && static_cast<unsigned>(*p - '0') <= 9) {
+        value = value * 10 + (*p++ - '0');
+        read++;
+    }
+    return read > 0;
+}
+
+// YYYY-MM-DD, YYYY/MM/DD or a bare YYYY, which counts as the 1st of January
+inline bool parseCaseDate(const char* begin, const char* end, int& year, int32_t& day) {
+    trimCaseField(begin, end);
+    const char* p = begin;
+    int month = 1, dayOfMonth = 1;
+    if(!parseCaseNumber(p, end, 4, year) || p - begin != 4 || year < 1) return false;
+    if(p < end) {
+        char separator = *p++;
+        if((separator != '-' && separator != '/') || !parseCaseNumber(p, end, 2, month) ||
+           p >= end || *p++ != separator || !parseCaseNumber(p, end, 2, dayOfMonth) || p != end) {
+            return false;
+        }
+        if(month < 1 || month > 12 || dayOfMonth < 1 || dayOfMonth > 31) return false;
+    }
+    day = daysFromCivil(year, month, dayOfMonth);
+    int checkYear, checkMonth, checkDay;
+    civilFromDays(day, checkYear, checkMonth, checkDay);
+    return checkDay == dayOfMonth; // Rejects the 30th of February and the like
+}
+
+// District names to dense ids, open addressing over FNV-1a hashes
+struct DistrictTable {
+    std::vector<uint32_t> slots; // District id + 1, 0 when empty
+    std::vector<uint32_t> nameIndex;
+    std::string names;
+};
+
+inline uint32_t hashDistrictName(const char* begin, const char* end) {
+    uint32_t hash = 2166136261u;
+    for(const char* p = begin; p < end; p++) {
+        hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    return hash;
+}
+
+// Id of the district, added if new; false once 65536 districts exist
+inline bool findDistrict(DistrictTable& table, const char* begin, const char* end, uint16_t& id) {
+    trimCaseField(begin, end);
+    size_t length = static_cast<size_t>(end - begin);
+    if(table.slots.size() < (table.nameIndex.size() + 1) * 2) {
+        std::vector<uint32_t> slots(std::max<size_t>(1024, table.slots.size() * 2), 0);
+        for(size_t i = 0; i < table.nameIndex.size(); i++) {
+            const char* name = table.names.data() + table.nameIndex[i];
+            size_t slot = hashDistrictName(name, name + strlen(name)) & (slots.size() - 1);
+            while(slots[slot]) slot = (slot + 1) & (slots.size() - 1);
+            slots[slot] = static_cast<uint32_t>(i + 1);
+        }
+        table.slots.swap(slots);
+    }
+    size_t slot = hashDistrictName(begin, end) & (table.slots.size() - 1);
+    while(table.slots[slot]) {
+        uint32_t index = table.slots[slot] - 1;
+        const char* name = table.names.data() + table.nameIndex[index];
+        if(strncmp(name, begin, length) == 0 && name[length] == '\0') {
+            id = static_cast<uint16_t>(index);
+            return true;
+        }
+        slot = (slot + 1) & (table.slots.size() - 1);
+    }
+    if(table.nameIndex.size() > UINT16_MAX) return false;
+    id = static_cast<uint16_t>(table.nameIndex.size());
+    table.slots[slot] = static_cast<uint32_t>(table.nameIndex.size() + 1);
+    table.nameIndex.push_back(static_cast<uint32_t>(table.names.size()));
+    table.names.append(begin, length);
+    table.names.push_back('\0');
+    return true;
+}
+
+inline bool seekCaseFile(FILE* file, uint64_t offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+inline bool writeCaseSection(FILE* file, uint64_t offset, const void* data, size_t bytes) {
+    return bytes == 0 || (seekCaseFile(file, offset) && fwrite(data, 1, bytes, file) == bytes);
+}
+
+// Rows parsed but not yet written, one buffer per column
+struct CaseChunk {
+    std::vector<int32_t> day;
+    std::vector<uint16_t> year, district;
+    std::vector<uint32_t> cases, deaths, prevention;
+};
+
+inline bool flushCaseChunk(FILE* file, const CaseStoreHeader& header, CaseChunk& chunk, uint64_t written) {
+    size_t count = chunk.day.size();
+    bool ok = writeCaseSection(file, header.dayOffset + written * 4, chunk.day.data(), count * 4) &&
+              writeCaseSection(file, header.yearOffset + written * 2, chunk.year.data(), count * 2) &&
+              writeCaseSection(file, header.districtOffset + written * 2, chunk.district.data(), count * 2) &&
+              writeCaseSection(file, header.casesOffset + written * 4, chunk.cases.data(), count * 4) &&
+              writeCaseSection(file, header.deathsOffset + written * 4, chunk.deaths.data(), count * 4) &&
+              writeCaseSection(file, header.preventionOffset + written * 4, chunk.prevention.data(), count * 4);
+    chunk.day.clear();
+    chunk.year.clear();
+    chunk.district.clear();
+    chunk.cases.clear();
+    chunk.deaths.clear();
+    chunk.prevention.clear();
+    return ok;
+}
+
+inline int64_t caseSourceTime(const struct stat& info) {
+    return static_cast<int64_t>(info.st_mtime);
+}
+
+// Parse a date,district,cases,deaths,prevention CSV into a store at outputPath.
+// A first line that does not start with a date is taken as a header. Fields
+// must not contain quoted commas.
+inline bool convertCaseCsv(const char* csvPath, const char* outputPath) {
+    struct stat info;
+    MappedFile csv;
+    if(stat(csvPath, &info) != 0 || !mapFile(csv, csvPath)) {
+        fprintf(stderr, "cases: cannot read %s\n", csvPath);
+        return false;
+    }
+#if !defined(_WIN32)
+    if(csv.data) madvise(const_cast<char*>(csv.data), csv.size, MADV_SEQUENTIAL);
+#endif
+
+    // Every line is at most one row, so the line count sizes the columns
+    uint64_t capacity = 1;
+    for(const char* p = csv.data, *end = csv.data + csv.size;
+        p < end && (p = static_cast<const char*>(memchr(p, '\n', end - p))) != NULL; p++) {
+        capacity++;
+    }
+
+    CaseStoreHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CASE_STORE_MAGIC, sizeof(header.magic));
+    header.sourceSize = csv.size;
+    header.sourceTime = caseSourceTime(info);
+    header.dayOffset = alignCaseOffset(sizeof(header));
+    header.yearOffset = alignCaseOffset(header.dayOffset + capacity * 4);
+    header.districtOffset = alignCaseOffset(header.yearOffset + capacity * 2);
+    header.casesOffset = alignCaseOffset(header.districtOffset + capacity * 2);
+    header.deathsOffset = alignCaseOffset(header.casesOffset + capacity * 4);
+    header.preventionOffset = alignCaseOffset(header.deathsOffset + capacity * 4);
+
+    // Write to a temporary name, so an interrupted run never leaves a half store
+    std::string temporaryPath = std::string(outputPath) + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if(!file) {
+        fprintf(stderr, "cases: cannot write %s\n", temporaryPath.c_str());
+        unmapFile(csv);
+        return false;
+    }
+
+    DistrictTable districts;
+    std::map<int32_t, CaseTotals> dayTotals;
+    CaseTotals* lastDay = NULL; // Rows usually come grouped by date
+    CaseChunk chunk;
+    uint64_t written = 0;
+    bool ok = true;
+
+    const char* data = csv.data;
+    size_t size = csv.size;
+    size_t fieldStart = 0;
+    size_t fieldBegin[5], fieldEnd[5];
+    int field = 0;
+    bool firstLine = true;
+
+    // Takes the fields of one line once its newline (or the end of file) is reached
+    auto finishLine = [&]() {
+        bool isFirst = firstLine;
+        firstLine = false;
+        if(field == 1 && fieldEnd[0] - fieldBegin[0] <= 1) return; // Blank line
+        int year = 0;
+        int32_t day = 0;
+        uint16_t district = 0;
+        uint32_t cases = 0, deaths = 0, prevention = 0;
+        bool parsed = field == 5 &&
+            parseCaseDate(data + fieldBegin[0], data + fieldEnd[0], year, day) && year <= UINT16_MAX &&
+            parseCaseCount(data + fieldBegin[2], data + fieldEnd[2], cases) &&
+            parseCaseCount(data + fieldBegin[3], data + fieldEnd[3], deaths) &&
+            parseCaseCount(data + fieldBegin[4], data + fieldEnd[4], prevention) &&
+            findDistrict(districts, data + fieldBegin[1], data + fieldEnd[1], district);
+        if(!parsed) {
+            if(!isFirst) header.skippedRows++;
+            return;
+        }
+        chunk.day.push_back(day);
+        chunk.year.push_back(static_cast<uint16_t>(year));
+        chunk.district.push_back(district);
+        chunk.cases.push_back(cases);
+        chunk.deaths.push_back(deaths);
+        chunk.prevention.push_back(prevention);
+        header.rows++;
+        if(!lastDay || lastDay->key != day) {
+            lastDay = &dayTotals[day];
+            lastDay->key = day;
+        }
+        lastDay->rows++;
+        lastDay->cases += cases;
+        lastDay->deaths += deaths;
+        lastDay->prevention += prevention;
+        if(chunk.day.size() == CASE_STORE_CHUNK) {
+            ok = flushCaseChunk(file, header, chunk, written) && ok;
+            written += CASE_STORE_CHUNK;
+        }
+    };
+
+    for(size_t block = 0; block < size; block += 64) {
+        uint64_t mask = block + 64 <= size ? caseDelimiterMask64(data + block)
+                                           : caseDelimiterMaskScalar(data + block, size - block);
+        while(mask) {
+            size_t position = block + lowestSetBit(mask);
+            mask &= mask - 1;
+            if(field < 5) {
+                fieldBegin[field] = fieldStart;
+                fieldEnd[field] = position;
+            }
+            field++;
+            fieldStart = position + 1;
+            if(data[position] == '\n') {
+                finishLine();
+                field = 0;
+            }
+        }
+    }
+    if(fieldStart < size || field > 0) {
+        // Last line without a newline
+        if(field < 5) {
+            fieldBegin[field] = fieldStart;
+            fieldEnd[field] = size;
+        }
+        field++;
+        finishLine();
+    }
+    ok = flushCaseChunk(file, header, chunk, written) && ok;
+    unmapFile(csv);
+
+    // Totals per day, then per year from the daily ones
+    std::vector<CaseTotals> days, years;
+    days.reserve(dayTotals.size());
+    for(const auto& entry : dayTotals) days.push_back(entry.second);
+    for(const CaseTotals& total : days) {
+        int year, month, dayOfMonth;
+        civilFromDays(total.key, year, month, dayOfMonth);
+        if(years.empty() || years.back().key != year) {
+            CaseTotals yearTotal;
+            memset(&yearTotal, 0, sizeof(yearTotal));
+            yearTotal.key = year;
+            years.push_back(yearTotal);
+        }
+        years.back().rows += total.rows;
+        years.back().cases += total.cases;
+        years.back().deaths += total.deaths;
+        years.back().prevention += total.prevention;
+    }
+
+    header.districtCount = static_cast<uint32_t>(districts.nameIndex.size());
+    header.yearCount = static_cast<uint32_t>(years.size());
+    header.dayCount = static_cast<uint32_t>(days.size());
+    header.yearTotalsOffset = alignCaseOffset(header.preventionOffset + capacity * 4);
+    header.dayTotalsOffset = alignCaseOffset(header.yearTotalsOffset + years.size() * sizeof(CaseTotals));
+    header.nameIndexOffset = alignCaseOffset(header.dayTotalsOffset + days.size() * sizeof(CaseTotals));
+    header.namesOffset = alignCaseOffset(header.nameIndexOffset + districts.nameIndex.size() * 4);
+    header.namesSize = districts.names.size();
+    ok = ok &&
+         writeCaseSection(file, header.yearTotalsOffset, years.data(), years.size() * sizeof(CaseTotals)) &&
+         writeCaseSection(file, header.dayTotalsOffset, days.data(), days.size() * sizeof(CaseTotals)) &&
+         writeCaseSection(file, header.nameIndexOffset, districts.nameIndex.data(),
+                          districts.nameIndex.size() * 4) &&
+         writeCaseSection(file, header.namesOffset, districts.names.data(), districts.names.size()) &&
+         writeCaseSection(file, 0, &header, sizeof(header));
+    ok = fclose(file) == 0 && ok;
+
+    remove(outputPath);
+    if(!ok || rename(temporaryPath.c_str(), outputPath) != 0) {
+        fprintf(stderr, "cases: cannot write %s\n", outputPath);
+        remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+inline bool isCaseStoreFile(const char* path) {
+    char magic[8];
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+    bool match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, CASE_STORE_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return match;
+}
+
+// Open a store directly, or the store cached next to a CSV as <csv>.cols,
+// converting the CSV first when the cache is missing or older than it
+inline bool loadCaseStore(CaseStore& store, const char* path) {
+    if(isCaseStoreFile(path)) {
+        if(openCaseStore(store, path)) return true;
+        fprintf(stderr, "cases: %s is damaged\n", path);
+        return false;
+    }
+
+    struct stat info;
+    if(stat(path, &info) != 0) {
+        fprintf(stderr, "cases: cannot read %s\n", path);
+        return false;
+    }
+    std::string cachePath = std::string(path) + ".cols";
+    if(openCaseStore(store, cachePath.c_str())) {
+        CaseStoreHeader header;
+        memcpy(&header, store.file.data, sizeof(header));
+        if(header.sourceSize == static_cast<uint64_t>(info.st_size) &&
+           header.sourceTime == caseSourceTime(info)) {
+            return true;
+        }
+        closeCaseStore(store);
+    }
+
+    if(!convertCaseCsv(path, cachePath.c_str())) return false;
+    if(!openCaseStore(store, cachePath.c_str())) {
+        fprintf(stderr, "cases: %s is damaged\n", cachePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#endif
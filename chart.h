@@ -0,0 +1,204 @@
+/*
+ * Decimated chart series
+ * A series of any length is first reduced to the minimum and maximum of a
+ * few thousand buckets, once per data version. Drawing then reduces that
+ * summary to at most two points per pixel column, by min/max bucketing or by
+ * largest-triangle-three-buckets, and caches the vertices until the data,
+ * the layout or the pixel width change, so each series is one vertex array.
+ */
+
+#ifndef DENGUE_CHART_H
+#define DENGUE_CHART_H
+
+#include <stddef.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+enum ChartDecimation {
+    CHART_MINMAX = 0, // Minimum and maximum of every pixel column, keeps every spike
+    CHART_LTTB        // Largest-triangle-three-buckets, keeps the shape with fewer points
+};
+
+const size_t CHART_SUMMARY_BUCKETS = 8192;
+
+struct ChartSeries {
+    // Points kept from the data, x in [0, 1] and non-decreasing, y in data units
+    std::vector<float> summaryX, summaryY;
+    float peak;
+    unsigned long long version; // Data version the summary was built from, 0 for none
+
+    // x, y pairs in chart coordinates for the layout below
+    std::vector<float> vertices;
+    std::vector<float> layoutX, layoutY; // Decimated points, kept so relayouts reuse their memory
+    unsigned long long vertexVersion;
+    int columns;
+    ChartDecimation decimation;
+    float left, bottom, right, top, scale;
+
+    ChartSeries() : peak(0.0f), version(0), vertexVersion(0), columns(0), decimation(CHART_MINMAX),
+                    left(0.0f), bottom(0.0f), right(0.0f), top(0.0f), scale(0.0f) {}
+};
+
+// Keep the minimum and maximum point of each of `buckets` equal slices of
+// x, in the order they occur, so a line through them traces the envelope
+template<typename XAt, typename YAt>
+void bucketMinMax(size_t count, const XAt& xAt, const YAt& yAt, size_t buckets,
+                  std::vector<float>& outX, std::vector<float>& outY) {
+    size_t current = static_cast<size_t>(-1);
+    size_t minIndex = 0, maxIndex = 0;
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    auto flush = [&]() {
+        if(current == static_cast<size_t>(-1)) return;
+        bool minFirst = minIndex <= maxIndex;
+        outX.push_back(minFirst ? minX : maxX);
+        outY.push_back(minFirst ? minY : maxY);
+        if(minIndex != maxIndex) {
+            outX.push_back(minFirst ? maxX : minX);
+            outY.push_back(minFirst ? maxY : minY);
+        }
+    };
+    for(size_t i = 0; i < count; i++) {
+        float x = xAt(i);
+        float y = yAt(i);
+        size_t bucket = std::min(buckets - 1, static_cast<size_t>(std::max(0.0f, x) * buckets));
+        if(bucket != current) {
+            flush();
+            current = bucket;
+            minIndex = maxIndex = i;
+            minX = maxX = x;
+            minY = maxY = y;
+        } else if(y < minY) {
+            minIndex = i;
+            minX = x;
+            minY = y;
+        } else if(y > maxY) {
+            maxIndex = i;
+            maxX = x;
+            maxY = y;
+        }
+    }
+    flush();
+}
+
+// Largest-triangle-three-buckets down to `threshold` points (at least 3)
+inline void decimateLTTB(const std::vector<float>& x, const std::vector<float>& y, size_t threshold,
+                         std::vector<float>& outX, std::vector<float>& outY) {
+    size_t count = x.size();
+    if(threshold >= count || threshold < 3) {
+        outX = x;
+        outY = y;
+        return;
+    }
+    double every = static_cast<double>(count - 2) / (threshold - 2);
+    size_t a = 0;
+    outX.push_back(x[0]);
+    outY.push_back(y[0]);
+    for(size_t bucket = 0; bucket < threshold - 2; bucket++) {
+        // Average of the next bucket is the third corner of the triangle
+        size_t nextBegin = static_cast<size_t>((bucket + 1) * every) + 1;
+        size_t nextEnd = std::min(count, static_cast<size_t>((bucket + 2) * every) + 1);
+        double averageX = 0.0, averageY = 0.0;
+        for(size_t i = nextBegin; i < nextEnd; i++) {
+            averageX += x[i];
+            averageY += y[i];
+        }
+        size_t nextCount = std::max<size_t>(1, nextEnd - nextBegin);
+        averageX /= nextCount;
+        averageY /= nextCount;
+
+        size_t begin = static_cast<size_t>(bucket * every) + 1;
+        size_t end = static_cast<size_t>((bucket + 1) * every) + 1;
+        double bestArea = -1.0;
+        size_t best = begin;
+        for(size_t i = begin; i < end; i++) {
+            double area = std::fabs((x[a] - averageX) * (y[i] - y[a]) - (x[a] - x[i]) * (averageY - y[a]));
+            if(area > bestArea) {
+                bestArea = area;
+                best = i;
+            }
+        }
+        outX.push_back(x[best]);
+        outY.push_back(y[best]);
+        a = best;
+    }
+    outX.push_back(x[count - 1]);
+    outY.push_back(y[count - 1]);
+}
+
+// Summarize points i = 0..count-1 at x = xAt(i) in [0, 1] and y = yAt(i),
+// unless the summary is already of this data version
+template<typename XAt, typename YAt>
+void summarizeChartSeries(ChartSeries& series, unsigned long long version, size_t count,
+                          const XAt& xAt, const YAt& yAt) {
+    if(series.version == version) return;
+    series.version = version;
+    series.summaryX.clear();
+    series.summaryY.clear();
+    series.summaryX.reserve(2 * CHART_SUMMARY_BUCKETS);
+    series.summaryY.reserve(2 * CHART_SUMMARY_BUCKETS);
+    if(count <= 2 * CHART_SUMMARY_BUCKETS) {
+        for(size_t i = 0; i < count; i++) {
+            series.summaryX.push_back(xAt(i));
+            series.summaryY.push_back(yAt(i));
+        }
+    } else {
+        bucketMinMax(count, xAt, yAt, CHART_SUMMARY_BUCKETS, series.summaryX, series.summaryY);
+    }
+    series.peak = 0.0f;
+    for(float y : series.summaryY) series.peak = std::max(series.peak, y);
+}
+
+// Vertices of the summary in the box [left, right] x [bottom, top] with y = scale
+// at the top, reduced to at most two points per pixel column
+inline const std::vector<float>& layoutChartSeries(ChartSeries& series, int columns, ChartDecimation decimation,
+                                                   float left, float bottom, float right, float top,
+                                                   float scale) {
+    columns = std::max(columns, 2);
+    if(series.vertexVersion == series.version && series.columns == columns &&
+       series.decimation == decimation && series.left == left && series.bottom == bottom &&
+       series.right == right && series.top == top && series.scale == scale) {
+        return series.vertices;
+    }
+    series.vertexVersion = series.version;
+    series.columns = columns;
+    series.decimation = decimation;
+    series.left = left;
+    series.bottom = bottom;
+    series.right = right;
+    series.top = top;
+    series.scale = scale;
+
+    std::vector<float>& x = series.layoutX;
+    std::vector<float>& y = series.layoutY;
+    x.clear();
+    y.clear();
+    const std::vector<float>& summaryX = series.summaryX;
+    const std::vector<float>& summaryY = series.summaryY;
+    size_t limit = 2 * static_cast<size_t>(columns);
+    // Never more points than the limit, so growing data reallocates nothing
+    x.reserve(limit);
+    y.reserve(limit);
+    series.vertices.reserve(2 * limit);
+    if(summaryX.size() <= limit) {
+        x.assign(summaryX.begin(), summaryX.end());
+        y.assign(summaryY.begin(), summaryY.end());
+    } else if(decimation == CHART_LTTB) {
+        decimateLTTB(summaryX, summaryY, limit, x, y);
+    } else {
+        bucketMinMax(summaryX.size(), [&](size_t i) { return summaryX[i]; },
+                     [&](size_t i) { return summaryY[i]; }, static_cast<size_t>(columns), x, y);
+    }
+
+    float width = right - left;
+    float height = top - bottom;
+    float inverseScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+    series.vertices.resize(x.size() * 2);
+    for(size_t i = 0; i < x.size(); i++) {
+        series.vertices[i * 2] = left + x[i] * width;
+        series.vertices[i * 2 + 1] = bottom + height * std::min(1.0f, y[i] * inverseScale);
+    }
+    return series.vertices;
+}
+
+#endif
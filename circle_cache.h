@@ -0,0 +1,73 @@
+/*
+ * Shared unit-circle geometry
+ * Cosine/sine tables for a few tessellation levels are built at compile time,
+ * and circles pick a level from their on-screen radius instead of calling
+ * trig functions for every vertex.
+ */
+
+#ifndef DENGUE_CIRCLE_CACHE_H
+#define DENGUE_CIRCLE_CACHE_H
+
+constexpr double CIRCLE_PI = 3.14159265358979323846;
+
+// Taylor series sine for compile-time tables, accurate to float precision
+constexpr double constexprSin(double angle) {
+    while(angle > CIRCLE_PI) angle -= 2.0 * CIRCLE_PI;
+    while(angle < -CIRCLE_PI) angle += 2.0 * CIRCLE_PI;
+    double term = angle;
+    double sum = angle;
+    for(int n = 1; n < 12; n++) {
+        term *= -angle * angle / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexprCos(double angle) {
+    return constexprSin(angle + CIRCLE_PI / 2.0);
+}
+
+// Unit circle with N segments; entry N repeats entry 0 to close fans and strips
+template<int N>
+struct CircleTable {
+    float cosines[N + 1];
+    float sines[N + 1];
+
+    constexpr CircleTable() : cosines(), sines() {
+        for(int i = 0; i <= N; i++) {
+            double angle = 2.0 * CIRCLE_PI * (i % N) / N;
+            cosines[i] = static_cast<float>(constexprCos(angle));
+            sines[i] = static_cast<float>(constexprSin(angle));
+        }
+    }
+};
+
+constexpr CircleTable<12> CIRCLE_12;
+constexpr CircleTable<24> CIRCLE_24;
+constexpr CircleTable<36> CIRCLE_36;
+constexpr CircleTable<72> CIRCLE_72;
+
+// A tessellation level, segments + 1 entries in each table
+struct CircleLevel {
+    int segments;
+    const float* cosines;
+    const float* sines;
+};
+
+constexpr CircleLevel CIRCLE_LEVELS[] = {
+    {12, CIRCLE_12.cosines, CIRCLE_12.sines},
+    {24, CIRCLE_24.cosines, CIRCLE_24.sines},
+    {36, CIRCLE_36.cosines, CIRCLE_36.sines},
+    {72, CIRCLE_72.cosines, CIRCLE_72.sines}
+};
+
+// Pick a level from the on-screen radius: tiny circles get few segments,
+// large ones enough that the outline still looks round
+inline const CircleLevel& circleForRadius(float radiusPixels) {
+    if(radiusPixels < 4.0f) return CIRCLE_LEVELS[0];
+    if(radiusPixels < 16.0f) return CIRCLE_LEVELS[1];
+    if(radiusPixels < 48.0f) return CIRCLE_LEVELS[2];
+    return CIRCLE_LEVELS[3];
+}
+
+#endif
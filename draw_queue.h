@@ -0,0 +1,295 @@
+/*
+ * State-sorted draw queue
+ * The moving parts of a frame are queued instead of drawn: small shapes as
+ * vertices copied into the queue, large batches as vertex arrays the caller
+ * keeps alive until the flush. The flush sorts the submissions by layer,
+ * texture, primitive, blending and line width or point size, then draws
+ * each run of equal state with one call, so a frame changes state a handful
+ * of times instead of once per shape. Submissions only keep their order
+ * against submissions with the same state, so anything that must cover
+ * something else goes in a higher layer. Repeated shapes can be queued as
+ * instances of a renderer shape, which the core backend draws in one
+ * instanced call.
+ */
+
+#ifndef DENGUE_DRAW_QUEUE_H
+#define DENGUE_DRAW_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "renderer.h"
+
+// In drawing order within a layer
+enum DrawPrimitive {
+    DRAW_LINES = 0,
+    DRAW_LINE_STRIP, // Caller arrays only, strips cannot be merged
+    DRAW_TRIANGLES,
+    DRAW_POINTS
+};
+
+const size_t DRAW_STRIDE = RENDER_STRIDE; // Floats per queued vertex: x, y, u, v, r, g, b, a
+
+struct DrawCommand {
+    uint64_t key;
+    GLuint texture;          // 0 for untextured
+    DrawPrimitive primitive;
+    bool blend;
+    float size;              // Line width or point size in pixels
+    const float* positions;  // Caller's x, y pairs drawn in one color, NULL for queued vertices
+    int shape;               // Renderer shape drawn at each of the positions' instances, or -1
+    size_t first, count;     // Vertices (instances for shapes), in the queue or the caller's array
+    float color[4];          // Color of the caller's array
+    size_t order;            // Submission order, keeps equal states in order through the sort
+    RenderArrays arrays;     // Where the renderer reads the caller's array, set by the flush
+};
+
+// Work done by the flushes since the stats were reset
+struct DrawStats {
+    size_t commands;
+    size_t drawCalls;
+    size_t stateChanges; // Texture, blending, line width or point size, or vertex format switches
+};
+
+struct DrawQueue {
+    bool sorted;   // Sort by state, otherwise draw in submission order (for comparison)
+    std::vector<float> vertices;
+    std::vector<DrawCommand> commands;
+    std::vector<float> gathered; // Queued vertices in drawing order
+
+    // Recording state
+    float originX, originY, scale;
+    float color[4];
+
+    DrawStats stats;
+
+    DrawQueue() : sorted(true), originX(0.0f), originY(0.0f), scale(1.0f), stats() {
+        color[0] = color[1] = color[2] = color[3] = 1.0f;
+    }
+};
+
+// Room for a frame of this many submissions and queued vertices, so the
+// queue does not grow while the frame is recorded
+inline void reserveDrawQueue(DrawQueue& queue, size_t commands, size_t vertices) {
+    queue.commands.reserve(commands);
+    queue.vertices.reserve(vertices * DRAW_STRIDE);
+    queue.gathered.reserve(vertices * DRAW_STRIDE);
+}
+
+inline uint64_t drawKey(int layer, GLuint texture, DrawPrimitive primitive, bool blend, float size) {
+    uint64_t quantizedSize = static_cast<uint64_t>(std::min(255.0f, std::max(0.0f, size * 4.0f)));
+    return (static_cast<uint64_t>(layer & 0xFF) << 56) | (static_cast<uint64_t>(texture) << 24) |
+           (static_cast<uint64_t>(primitive) << 22) | (static_cast<uint64_t>(blend) << 21) |
+           (quantizedSize << 13);
+}
+
+// Start queueing vertices with this state; they join the previous
+// submission when its state is the same
+inline void queueBegin(DrawQueue& queue, int layer, DrawPrimitive primitive, bool blend,
+                       GLuint texture = 0, float size = 1.0f) {
+    uint64_t key = drawKey(layer, texture, primitive, blend, size);
+    if(!queue.commands.empty()) {
+        const DrawCommand& last = queue.commands.back();
+        if(last.key == key && !last.positions && primitive != DRAW_LINE_STRIP) return;
+    }
+    DrawCommand command = {key, texture, primitive, blend, size, NULL, -1,
+                           queue.vertices.size() / DRAW_STRIDE, 0, {1.0f, 1.0f, 1.0f, 1.0f},
+                           queue.commands.size(), {NULL, 0, 0}};
+    queue.commands.push_back(command);
+}
+
+// Place the following vertices like glTranslatef(x, y) then glScalef(scale)
+inline void queueTransform(DrawQueue& queue, float x, float y, float scale) {
+    queue.originX = x;
+    queue.originY = y;
+    queue.scale = scale;
+}
+
+inline void queueColor(DrawQueue& queue, float r, float g, float b, float a = 1.0f) {
+    queue.color[0] = r;
+    queue.color[1] = g;
+    queue.color[2] = b;
+    queue.color[3] = a;
+}
+
+inline void queueVertex(DrawQueue& queue, float x, float y, float u = 0.0f, float v = 0.0f) {
+    const float vertex[DRAW_STRIDE] = {queue.originX + x * queue.scale, queue.originY + y * queue.scale, u, v,
+                                       queue.color[0], queue.color[1], queue.color[2], queue.color[3]};
+    queue.vertices.insert(queue.vertices.end(), vertex, vertex + DRAW_STRIDE);
+    queue.commands.back().count++;
+}
+
+// Quadrilateral as two triangles, corners in order around it
+inline void queueQuad(DrawQueue& queue, float x0, float y0, float x1, float y1,
+                      float x2, float y2, float x3, float y3) {
+    queueVertex(queue, x0, y0);
+    queueVertex(queue, x1, y1);
+    queueVertex(queue, x2, y2);
+    queueVertex(queue, x0, y0);
+    queueVertex(queue, x2, y2);
+    queueVertex(queue, x3, y3);
+}
+
+// Axis-aligned rectangle, texture coordinates running from (u0, v0) to (u1, v1)
+inline void queueRect(DrawQueue& queue, float left, float bottom, float right, float top,
+                      float u0 = 0.0f, float v0 = 0.0f, float u1 = 1.0f, float v1 = 1.0f) {
+    queueVertex(queue, left, bottom, u0, v0);
+    queueVertex(queue, right, bottom, u1, v0);
+    queueVertex(queue, right, top, u1, v1);
+    queueVertex(queue, left, bottom, u0, v0);
+    queueVertex(queue, right, top, u1, v1);
+    queueVertex(queue, left, top, u0, v1);
+}
+
+// Queue a caller-owned array of x, y pairs drawn in one color; it must stay
+// unchanged until the flush
+inline void queueArray(DrawQueue& queue, int layer, DrawPrimitive primitive, bool blend,
+                       const float* positions, size_t count, float r, float g, float b, float a = 1.0f,
+                       float size = 1.0f) {
+    if(count == 0) return;
+    DrawCommand command = {drawKey(layer, 0, primitive, blend, size), 0, primitive, blend, size, positions,
+                           -1, 0, count, {r, g, b, a}, queue.commands.size(), {NULL, 0, 0}};
+    queue.commands.push_back(command);
+}
+
+// Queue a renderer shape drawn at each of count caller-owned instances
+// (RENDER_INSTANCE_STRIDE floats each) in one color; primitive must match the
+// shape's mode, and the instances must stay unchanged until the flush
+inline void queueInstances(DrawQueue& queue, int layer, DrawPrimitive primitive, bool blend, int shape,
+                           const float* instances, size_t count, float r, float g, float b, float a = 1.0f,
+                           float size = 1.0f) {
+    if(count == 0) return;
+    DrawCommand command = {drawKey(layer, 0, primitive, blend, size), 0, primitive, blend, size, instances,
+                           shape, 0, count, {r, g, b, a}, queue.commands.size(), {NULL, 0, 0}};
+    queue.commands.push_back(command);
+}
+
+inline GLenum drawMode(DrawPrimitive primitive) {
+    switch(primitive) {
+        case DRAW_LINES: return GL_LINES;
+        case DRAW_LINE_STRIP: return GL_LINE_STRIP;
+        case DRAW_POINTS: return GL_POINTS;
+        default: return GL_TRIANGLES;
+    }
+}
+
+// Draw everything queued and empty the queue. Leaves blending on, texturing
+// off and the line width and point size at 1, as the rest of the frame expects.
+inline void flushDrawQueue(DrawQueue& queue, Renderer& renderer) {
+    DrawStats& stats = queue.stats;
+    stats.commands += queue.commands.size();
+    if(queue.commands.empty()) {
+        queue.vertices.clear();
+        return;
+    }
+    if(queue.sorted) {
+        // Not std::stable_sort, which takes a heap buffer on every call
+        std::sort(queue.commands.begin(), queue.commands.end(), [](const DrawCommand& a, const DrawCommand& b) {
+            return a.key < b.key || (a.key == b.key && a.order < b.order);
+        });
+    }
+
+    // Lay the queued vertices out in drawing order, so runs of equal state are contiguous
+    queue.gathered.clear();
+    for(DrawCommand& command : queue.commands) {
+        if(command.positions) continue;
+        size_t first = queue.gathered.size() / DRAW_STRIDE;
+        const float* source = &queue.vertices[command.first * DRAW_STRIDE];
+        queue.gathered.insert(queue.gathered.end(), source, source + command.count * DRAW_STRIDE);
+        command.first = first;
+    }
+
+    // Hand every array of the flush to the renderer up front, in one piece of
+    // its stream. Consecutive shapes drawn at the same instances share them.
+    size_t bytes = alignRenderStream(queue.gathered.size() * sizeof(float));
+    for(const DrawCommand& command : queue.commands) {
+        if(!command.positions) continue;
+        size_t floats = command.count * (command.shape >= 0 ? RENDER_INSTANCE_STRIDE : 2);
+        bytes += alignRenderStream(floats * sizeof(float));
+    }
+    reserveRenderStream(renderer, bytes);
+    RenderArrays vertices = streamRenderArrays(renderer, queue.gathered.data(), queue.gathered.size());
+    const DrawCommand* streamed = NULL;
+    for(DrawCommand& command : queue.commands) {
+        if(!command.positions) continue;
+        if(streamed && streamed->positions == command.positions && streamed->count == command.count &&
+           (streamed->shape >= 0) == (command.shape >= 0)) {
+            command.arrays = streamed->arrays;
+            continue;
+        }
+        size_t floats = command.count * (command.shape >= 0 ? RENDER_INSTANCE_STRIDE : 2);
+        command.arrays = streamRenderArrays(renderer, command.positions, floats);
+        streamed = &command;
+    }
+
+    int format = -1;  // 0 caller arrays, 1 queued vertices
+    int texture = -1; // Bound texture, 0 for texturing off
+    int blend = -1;
+    float lineWidth = 1.0f, pointSize = 1.0f;
+    size_t i = 0;
+    while(i < queue.commands.size()) {
+        const DrawCommand& command = queue.commands[i];
+
+        // Queued vertices with the same state that follow on are drawn with this one
+        size_t end = i + 1;
+        size_t count = command.count;
+        if(!command.positions && command.primitive != DRAW_LINE_STRIP) {
+            while(end < queue.commands.size() && queue.commands[end].key == command.key &&
+                  !queue.commands[end].positions) {
+                count += queue.commands[end++].count;
+            }
+        }
+
+        if(static_cast<int>(command.texture) != texture) {
+            setRenderTexture(renderer, command.texture, command.texture ? RENDER_RGBA : RENDER_UNTEXTURED);
+            texture = static_cast<int>(command.texture);
+            stats.stateChanges++;
+        }
+        if(static_cast<int>(command.blend) != blend) {
+            if(command.blend) glEnable(GL_BLEND);
+            else glDisable(GL_BLEND);
+            blend = command.blend;
+            stats.stateChanges++;
+        }
+        if(command.primitive == DRAW_POINTS) {
+            if(command.size != pointSize) {
+                glPointSize(command.size);
+                pointSize = command.size;
+                stats.stateChanges++;
+            }
+        } else if(command.primitive != DRAW_TRIANGLES && command.size != lineWidth) {
+            glLineWidth(command.size);
+            lineWidth = command.size;
+            stats.stateChanges++;
+        }
+        int commandFormat = command.positions ? 0 : 1;
+        if(commandFormat != format) {
+            if(commandFormat) setRenderVertices(renderer, vertices);
+            format = commandFormat;
+            stats.stateChanges++;
+        }
+
+        if(command.shape >= 0) {
+            drawRenderInstances(renderer, command.shape, command.arrays, count, command.color);
+        } else if(command.positions) {
+            setRenderPositions(renderer, command.arrays, command.color);
+            drawRenderArrays(renderer, drawMode(command.primitive), 0, count);
+        } else {
+            drawRenderArrays(renderer, drawMode(command.primitive), command.first, count);
+        }
+        stats.drawCalls++;
+        i = end;
+    }
+
+    endRenderArrays(renderer);
+    setRenderTexture(renderer, 0, RENDER_UNTEXTURED);
+    glEnable(GL_BLEND);
+    if(lineWidth != 1.0f) glLineWidth(1.0f);
+    if(pointSize != 1.0f) glPointSize(1.0f);
+    queue.vertices.clear();
+    queue.commands.clear();
+}
+
+#endif
@@ -0,0 +1,596 @@
+/*
+ * Agent-based dengue transmission
+ * People and mosquitoes are agents on a grid of city patches. Every simulated
+ * day mosquitoes bite the people spending the day in their patch, carrying the
+ * virus both ways, and people move through susceptible, exposed, infectious
+ * and recovered states. Fighter teams spray adult mosquitoes and cleaner teams
+ * empty breeding sites in the patches reporting the most cases. Agents are
+ * updated in parallel blocks, each drawing from its own random stream, so a
+ * day comes out the same for any number of threads.
+ */
+
+#ifndef DENGUE_EPIDEMIC_H
+#define DENGUE_EPIDEMIC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "profiler.h"
+#include "random.h"
+#include "sim_channel.h"
+#include "worker_pool.h"
+
+// Person states, HUMAN_CASE is set on top of the state for symptomatic infections
+const uint8_t HUMAN_SUSCEPTIBLE = 0;
+const uint8_t HUMAN_EXPOSED = 1;
+const uint8_t HUMAN_INFECTIOUS = 2;
+const uint8_t HUMAN_RECOVERED = 3;
+const uint8_t HUMAN_CASE = 0x80;
+
+// Mosquito slot states, empty slots are refilled by emerging adults
+const uint8_t VECTOR_EMPTY = 0;
+const uint8_t VECTOR_SUSCEPTIBLE = 1;
+const uint8_t VECTOR_EXPOSED = 2;
+const uint8_t VECTOR_INFECTIOUS = 3;
+
+// Agents per parallel task and per random stream
+const size_t EPIDEMIC_BLOCK = 16384;
+
+struct EpidemicParams {
+    size_t humans;
+    size_t mosquitoes;          // Mosquito slots, alive or empty
+    int patchesX, patchesY;     // 0 picks about 50 people per patch
+    int seedInfections;         // Infectious people on day 0
+    float importedInfections;   // People infected elsewhere arriving per day
+    float bitingRate;           // Bites per mosquito per day
+    float mosquitoToHuman;      // Chance an infectious bite infects
+    float humanToMosquito;      // Chance biting an infectious person infects the mosquito
+    float mosquitoMortality;    // Per day
+    float emergenceRate;        // Adults emerging per empty slot per day at full breeding capacity
+    int extrinsicIncubation;    // Days before an infected mosquito is infectious
+    int intrinsicIncubation;    // Days before an infected person is infectious
+    int infectiousDays;
+    float symptomaticFraction;  // Infections that become reported cases
+    float caseFatality;         // Deaths per reported case
+    float immunityLoss;         // Recovered people susceptible again, per day
+    float mobility;             // Chance a person spends the day in a neighbouring patch
+    float travel;               // Chance a person spends the day anywhere in the city
+    float dispersal;            // Chance a mosquito flies to a neighbouring patch
+    int fighterTeams;           // Patches sprayed per day
+    int cleanerTeams;           // Patches cleaned per day
+    float sprayKill;            // Extra adult mortality on the day a patch is sprayed
+    float cleanEfficacy;        // Breeding capacity removed by cleaning
+    float refillRate;           // Cleaned breeding sites filling up again, per day
+};
+
+inline EpidemicParams defaultEpidemicParams() {
+    EpidemicParams params;
+    params.humans = 100000;
+    params.mosquitoes = 1000000;
+    params.patchesX = params.patchesY = 0;
+    params.seedInfections = 20;
+    params.importedInfections = 0.5f;
+    params.bitingRate = 0.3f;
+    params.mosquitoToHuman = 0.5f;
+    params.humanToMosquito = 0.5f;
+    params.mosquitoMortality = 0.07f;
+    params.emergenceRate = 0.3f;
+    params.extrinsicIncubation = 10;
+    params.intrinsicIncubation = 5;
+    params.infectiousDays = 5;
+    params.symptomaticFraction = 0.25f;
+    params.caseFatality = 0.005f;
+    params.immunityLoss = 1.0f / 730.0f;
+    params.mobility = 0.3f;
+    params.travel = 0.01f;
+    params.dispersal = 0.05f;
+    params.fighterTeams = 4;
+    params.cleanerTeams = 4;
+    params.sprayKill = 0.7f;
+    params.cleanEfficacy = 0.6f;
+    params.refillRate = 1.0f / 30.0f;
+    return params;
+}
+
+// City-wide totals at the end of one day
+struct EpidemicReport {
+    int day;
+    unsigned newCases;
+    unsigned deaths;
+    unsigned interventions;     // Patches sprayed or cleaned
+    unsigned long long susceptible, exposed, infectious, recovered;
+    unsigned long long mosquitoes, infectiousMosquitoes;
+};
+
+// Counts from one block of agents, summed after each parallel phase
+struct EpidemicTally {
+    unsigned newCases;
+    unsigned deaths;
+    unsigned long long states[4];
+};
+
+struct Epidemic {
+    EpidemicParams params;
+    uint64_t seed;
+    int day;
+    int patchesX, patchesY;
+    size_t patchCount;
+
+    // People, structure-of-arrays
+    std::vector<uint8_t> humanState, humanTimer;
+    std::vector<uint32_t> homePatch, dayPatch;
+
+    // Mosquito slots
+    std::vector<uint8_t> vectorState, vectorTimer;
+    std::vector<uint32_t> vectorPatch;
+
+    // Patches
+    std::vector<float> baseBreeding, breeding;
+    std::vector<float> emergence;        // Chance an empty slot fills today
+    std::vector<float> vectorInfection;  // Chance a susceptible mosquito is infected today
+    std::vector<float> humanInfection;   // Chance a susceptible person is infected today
+    std::vector<float> incidence;        // Recent cases, decaying, where teams are sent
+    std::vector<uint8_t> sprayed;
+    std::vector<std::atomic<uint32_t>> present, infectiousPresent, infectiousBites, patchCases;
+    std::vector<uint32_t> ranking;
+    float imports;                       // Imported infections owed, carried between days
+
+    std::vector<EpidemicTally> humanTallies, vectorTallies;
+};
+
+// Parallel phases, each with its own random streams
+enum EpidemicPhase {
+    EPIDEMIC_PHASE_SEED_HUMANS = 0,
+    EPIDEMIC_PHASE_SEED_VECTORS,
+    EPIDEMIC_PHASE_MOVE,
+    EPIDEMIC_PHASE_VECTORS,
+    EPIDEMIC_PHASE_HUMANS,
+    EPIDEMIC_PHASE_IMPORT
+};
+
+inline void seedEpidemicStream(RandomStream& stream, const Epidemic& epidemic, EpidemicPhase phase, size_t block) {
+    uint64_t id = static_cast<uint64_t>(epidemic.day) << 36 | static_cast<uint64_t>(phase) << 32 | block;
+    seedRandomStream(stream, epidemic.seed, RANDOM_STREAM_EPIDEMIC, id);
+}
+
+inline size_t epidemicBlocks(size_t count) {
+    return (count + EPIDEMIC_BLOCK - 1) / EPIDEMIC_BLOCK;
+}
+
+// One of the four patches next to p, or p itself at the edge of the city
+inline uint32_t neighbourPatch(const Epidemic& epidemic, uint32_t p, uint32_t direction) {
+    int x = static_cast<int>(p % epidemic.patchesX), y = static_cast<int>(p / epidemic.patchesX);
+    switch(direction & 3) {
+        case 0: if(x > 0) x--; break;
+        case 1: if(x + 1 < epidemic.patchesX) x++; break;
+        case 2: if(y > 0) y--; break;
+        default: if(y + 1 < epidemic.patchesY) y++; break;
+    }
+    return static_cast<uint32_t>(y * epidemic.patchesX + x);
+}
+
+inline uint32_t randomPatch(RandomStream& random, size_t patchCount) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(nextRandom(random)) * patchCount) >> 32);
+}
+
+// Seasonal breeding, peaking with the monsoon in late July
+inline float breedingSeason(int day) {
+    return 0.55f + 0.45f * std::sin(6.2831853f * (day % 365 - 120) / 365.0f);
+}
+
+inline void initEpidemic(Epidemic& epidemic, const EpidemicParams& params, uint64_t seed, WorkerPool& pool) {
+    epidemic.params = params;
+    // Timers count down in a byte
+    epidemic.params.extrinsicIncubation = std::max(1, std::min(params.extrinsicIncubation, 255));
+    epidemic.params.intrinsicIncubation = std::max(1, std::min(params.intrinsicIncubation, 255));
+    epidemic.params.infectiousDays = std::max(1, std::min(params.infectiousDays, 255));
+    epidemic.seed = seed;
+    epidemic.day = 0;
+    epidemic.imports = 0.0f;
+    if(params.patchesX > 0 && params.patchesY > 0) {
+        epidemic.patchesX = params.patchesX;
+        epidemic.patchesY = params.patchesY;
+    } else {
+        int side = static_cast<int>(std::lround(std::sqrt(params.humans / 50.0)));
+        epidemic.patchesX = epidemic.patchesY = std::max(4, std::min(side, 1024));
+    }
+    size_t patches = epidemic.patchCount = static_cast<size_t>(epidemic.patchesX) * epidemic.patchesY;
+
+    RandomStream random;
+    seedRandomStream(random, seed, RANDOM_STREAM_EPIDEMIC);
+    epidemic.baseBreeding.resize(patches);
+    for(size_t p = 0; p < patches; p++) {
+        epidemic.baseBreeding[p] = randomRange(random, 0.2f, 1.0f);
+    }
+    epidemic.breeding = epidemic.baseBreeding;
+    epidemic.emergence.assign(patches, 0.0f);
+    epidemic.vectorInfection.assign(patches, 0.0f);
+    epidemic.humanInfection.assign(patches, 0.0f);
+    epidemic.incidence.assign(patches, 0.0f);
+    epidemic.sprayed.assign(patches, 0);
+    epidemic.present = std::vector<std::atomic<uint32_t>>(patches);
+    epidemic.infectiousPresent = std::vector<std::atomic<uint32_t>>(patches);
+    epidemic.infectiousBites = std::vector<std::atomic<uint32_t>>(patches);
+    epidemic.patchCases = std::vector<std::atomic<uint32_t>>(patches);
+    for(size_t p = 0; p < patches; p++) {
+        epidemic.present[p].store(0, std::memory_order_relaxed);
+        epidemic.infectiousPresent[p].store(0, std::memory_order_relaxed);
+        epidemic.infectiousBites[p].store(0, std::memory_order_relaxed);
+        epidemic.patchCases[p].store(0, std::memory_order_relaxed);
+    }
+    epidemic.ranking.resize(patches);
+
+    size_t humans = params.humans, vectors = params.mosquitoes;
+    epidemic.humanState.assign(humans, HUMAN_SUSCEPTIBLE);
+    epidemic.humanTimer.assign(humans, 0);
+    epidemic.homePatch.resize(humans);
+    epidemic.dayPatch.resize(humans);
+    epidemic.vectorState.resize(vectors);
+    epidemic.vectorTimer.assign(vectors, 0);
+    epidemic.vectorPatch.resize(vectors);
+    epidemic.humanTallies.resize(epidemicBlocks(humans));
+    epidemic.vectorTallies.resize(epidemicBlocks(vectors));
+
+    parallelFor(pool, epidemicBlocks(humans), [&](size_t block) {
+        RandomStream stream;
+        seedEpidemicStream(stream, epidemic, EPIDEMIC_PHASE_SEED_HUMANS, block);
+        size_t end = std::min(humans, (block + 1) * EPIDEMIC_BLOCK);
+        for(size_t i = block * EPIDEMIC_BLOCK; i < end; i++) {
+            epidemic.homePatch[i] = epidemic.dayPatch[i] = randomPatch(stream, patches);
+        }
+    });
+
+    // Start near the adult population breeding would sustain
+    parallelFor(pool, epidemicBlocks(vectors), [&](size_t block) {
+        RandomStream stream;
+        seedEpidemicStream(stream, epidemic, EPIDEMIC_PHASE_SEED_VECTORS, block);
+        size_t end = std::min(vectors, (block + 1) * EPIDEMIC_BLOCK);
+        for(size_t i = block * EPIDEMIC_BLOCK; i < end; i++) {
+            uint32_t p = randomPatch(stream, patches);
+            float emerge = params.emergenceRate * epidemic.baseBreeding[p] * breedingSeason(0);
+            epidemic.vectorPatch[i] = p;
+            epidemic.vectorState[i] = randomChance(stream, emerge / (emerge + params.mosquitoMortality))
+                                      ? VECTOR_SUSCEPTIBLE : VECTOR_EMPTY;
+        }
+    });
+
+    // A few people come home infectious
+    for(int s = 0; s < params.seedInfections && humans > 0; s++) {
+        size_t i = static_cast<size_t>((static_cast<uint64_t>(nextRandom(random)) * humans) >> 32);
+        epidemic.humanState[i] = HUMAN_INFECTIOUS;
+        epidemic.humanTimer[i] = static_cast<uint8_t>(1 + s % std::max(1, params.infectiousDays));
+    }
+}
+
+// Send fighter and cleaner teams to the patches with the most recent cases,
+// and work out today's emergence. Returns the number of interventions.
+inline unsigned planInterventions(Epidemic& epidemic) {
+    const EpidemicParams& params = epidemic.params;
+    size_t patches = epidemic.patchCount;
+    for(size_t p = 0; p < patches; p++) {
+        epidemic.breeding[p] += (epidemic.baseBreeding[p] - epidemic.breeding[p]) * params.refillRate;
+        epidemic.sprayed[p] = 0;
+    }
+
+    unsigned interventions = 0;
+    size_t teams = std::min(patches, static_cast<size_t>(std::max(params.fighterTeams, params.cleanerTeams)));
+    if(teams > 0) {
+        for(size_t p = 0; p < patches; p++) epidemic.ranking[p] = static_cast<uint32_t>(p);
+        const std::vector<float>& incidence = epidemic.incidence;
+        std::partial_sort(epidemic.ranking.begin(), epidemic.ranking.begin() + teams, epidemic.ranking.end(),
+                          [&](uint32_t a, uint32_t b) {
+                              return incidence[a] != incidence[b] ? incidence[a] > incidence[b] : a < b;
+                          });
+        for(size_t t = 0; t < teams; t++) {
+            uint32_t p = epidemic.ranking[t];
+            if(incidence[p] <= 0.0f) break;
+            if(static_cast<int>(t) < params.fighterTeams) {
+                epidemic.sprayed[p] = 1;
+                interventions++;
+            }
+            if(static_cast<int>(t) < params.cleanerTeams) {
+                epidemic.breeding[p] *= 1.0f - params.cleanEfficacy;
+                interventions++;
+            }
+        }
+    }
+
+    float season = breedingSeason(epidemic.day);
+    for(size_t p = 0; p < patches; p++) {
+        epidemic.emergence[p] = epidemic.breeding[p] * season * params.emergenceRate;
+    }
+    return interventions;
+}
+
+// Travellers infected elsewhere come home exposed
+inline void importInfections(Epidemic& epidemic) {
+    epidemic.imports += epidemic.params.importedInfections;
+    if(epidemic.imports < 1.0f || epidemic.params.humans == 0) return;
+    RandomStream random;
+    seedEpidemicStream(random, epidemic, EPIDEMIC_PHASE_IMPORT, 0);
+    for(; epidemic.imports >= 1.0f; epidemic.imports -= 1.0f) {
+        size_t i = static_cast<size_t>((static_cast<uint64_t>(nextRandom(random)) * epidemic.params.humans) >> 32);
+        if(epidemic.humanState[i] != HUMAN_SUSCEPTIBLE) continue;
+        epidemic.humanState[i] = HUMAN_EXPOSED;
+        epidemic.humanTimer[i] = static_cast<uint8_t>(epidemic.params.intrinsicIncubation);
+    }
+}
+
+// People pick where they spend the day, and are counted there
+inline void moveHumans(Epidemic& epidemic, WorkerPool& pool) {
+    const EpidemicParams& params = epidemic.params;
+    size_t humans = params.humans;
+    parallelFor(pool, epidemicBlocks(humans), [&](size_t block) {
+        RandomStream stream;
+        seedEpidemicStream(stream, epidemic, EPIDEMIC_PHASE_MOVE, block);
+        size_t end = std::min(humans, (block + 1) * EPIDEMIC_BLOCK);
+        for(size_t i = block * EPIDEMIC_BLOCK; i < end; i++) {
+            uint32_t bits = nextRandom(stream);
+            float roll = unitFloat(bits);
+            uint32_t p = epidemic.homePatch[i];
+            if(roll < params.travel) p = randomPatch(stream, epidemic.patchCount);
+            else if(roll < params.travel + params.mobility) p = neighbourPatch(epidemic, p, bits);
+            epidemic.dayPatch[i] = p;
+            epidemic.present[p].fetch_add(1, std::memory_order_relaxed);
+            if((epidemic.humanState[i] & ~HUMAN_CASE) == HUMAN_INFECTIOUS) {
+                epidemic.infectiousPresent[p].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Chance a biting mosquito picks up the virus in each patch
+    for(size_t p = 0; p < epidemic.patchCount; p++) {
+        uint32_t present = epidemic.present[p].load(std::memory_order_relaxed);
+        uint32_t infectious = epidemic.infectiousPresent[p].load(std::memory_order_relaxed);
+        epidemic.vectorInfection[p] = present > 0
+            ? params.bitingRate * params.humanToMosquito * infectious / present : 0.0f;
+    }
+}
+
+// Mosquitoes emerge, die, fly, bite and incubate
+inline void updateVectors(Epidemic& epidemic, WorkerPool& pool) {
+    const EpidemicParams& params = epidemic.params;
+    size_t vectors = params.mosquitoes;
+    parallelFor(pool, epidemicBlocks(vectors), [&](size_t block) {
+        RandomStream stream;
+        seedEpidemicStream(stream, epidemic, EPIDEMIC_PHASE_VECTORS, block);
+        EpidemicTally tally = {};
+        size_t end = std::min(vectors, (block + 1) * EPIDEMIC_BLOCK);
+        for(size_t i = block * EPIDEMIC_BLOCK; i < end; i++) {
+            uint32_t p = epidemic.vectorPatch[i];
+            uint8_t state = epidemic.vectorState[i];
+            if(state == VECTOR_EMPTY) {
+                if(randomFloat(stream) < epidemic.emergence[p]) {
+                    epidemic.vectorState[i] = VECTOR_SUSCEPTIBLE;
+                    tally.states[VECTOR_SUSCEPTIBLE]++;
+                } else {
+                    tally.states[VECTOR_EMPTY]++;
+                }
+                continue;
+            }
+
+            float mortality = params.mosquitoMortality + (epidemic.sprayed[p] ? params.sprayKill : 0.0f);
+            if(randomFloat(stream) < mortality) {
+                epidemic.vectorState[i] = VECTOR_EMPTY;
+                tally.states[VECTOR_EMPTY]++;
+                continue;
+            }
+            uint32_t bits = nextRandom(stream);
+            if(unitFloat(bits) < params.dispersal) {
+                p = epidemic.vectorPatch[i] = neighbourPatch(epidemic, p, bits);
+            }
+
+            if(state == VECTOR_SUSCEPTIBLE) {
+                if(randomFloat(stream) < epidemic.vectorInfection[p]) {
+                    state = VECTOR_EXPOSED;
+                    epidemic.vectorTimer[i] = static_cast<uint8_t>(params.extrinsicIncubation);
+                }
+            } else if(state == VECTOR_EXPOSED) {
+                if(--epidemic.vectorTimer[i] == 0) state = VECTOR_INFECTIOUS;
+            } else if(randomFloat(stream) < params.bitingRate) {
+                epidemic.infectiousBites[p].fetch_add(1, std::memory_order_relaxed);
+            }
+            epidemic.vectorState[i] = state;
+            tally.states[state]++;
+        }
+        epidemic.vectorTallies[block] = tally;
+    });
+
+    // Chance a person is infected by the infectious bites in the patch they are in
+    for(size_t p = 0; p < epidemic.patchCount; p++) {
+        uint32_t present = epidemic.present[p].load(std::memory_order_relaxed);
+        uint32_t bites = epidemic.infectiousBites[p].load(std::memory_order_relaxed);
+        epidemic.humanInfection[p] = present > 0
+            ? 1.0f - std::exp(-params.mosquitoToHuman * bites / present) : 0.0f;
+    }
+}
+
+// People are infected, fall ill, recover or die, and lose immunity
+inline void updateHumans(Epidemic& epidemic, WorkerPool& pool) {
+    const EpidemicParams& params = epidemic.params;
+    size_t humans = params.humans;
+    parallelFor(pool, epidemicBlocks(humans), [&](size_t block) {
+        RandomStream stream;
+        seedEpidemicStream(stream, epidemic, EPIDEMIC_PHASE_HUMANS, block);
+        EpidemicTally tally = {};
+        size_t end = std::min(humans, (block + 1) * EPIDEMIC_BLOCK);
+        for(size_t i = block * EPIDEMIC_BLOCK; i < end; i++) {
+            uint8_t state = epidemic.humanState[i];
+            bool isCase = (state & HUMAN_CASE) != 0;
+            switch(state & ~HUMAN_CASE) {
+                case HUMAN_SUSCEPTIBLE: {
+                    float chance = epidemic.humanInfection[epidemic.dayPatch[i]];
+                    if(chance > 0.0f && randomFloat(stream) < chance) {
+                        state = HUMAN_EXPOSED;
+                        epidemic.humanTimer[i] = static_cast<uint8_t>(params.intrinsicIncubation);
+                    }
+                    break;
+                }
+                case HUMAN_EXPOSED:
+                    if(--epidemic.humanTimer[i] == 0) {
+                        state = HUMAN_INFECTIOUS;
+                        epidemic.humanTimer[i] = static_cast<uint8_t>(params.infectiousDays);
+                        if(randomFloat(stream) < params.symptomaticFraction) {
+                            state |= HUMAN_CASE;
+                            tally.newCases++;
+                            epidemic.patchCases[epidemic.homePatch[i]].fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                    break;
+                case HUMAN_INFECTIOUS:
+                    if(--epidemic.humanTimer[i] == 0) {
+                        state = HUMAN_RECOVERED;
+                        // A death is replaced by a susceptible newborn in the same home
+                        if(isCase && randomFloat(stream) < params.caseFatality) {
+                            tally.deaths++;
+                            state = HUMAN_SUSCEPTIBLE;
+                        }
+                    }
+                    break;
+                default:
+                    if(randomFloat(stream) < params.immunityLoss) state = HUMAN_SUSCEPTIBLE;
+                    break;
+            }
+            epidemic.humanState[i] = state;
+            tally.states[state & ~HUMAN_CASE]++;
+        }
+        epidemic.humanTallies[block] = tally;
+    });
+}
+
+// Advance the epidemic by one day and report the city-wide totals
+inline void stepEpidemicDay(Epidemic& epidemic, WorkerPool& pool, EpidemicReport& report) {
+    for(size_t p = 0; p < epidemic.patchCount; p++) {
+        epidemic.present[p].store(0, std::memory_order_relaxed);
+        epidemic.infectiousPresent[p].store(0, std::memory_order_relaxed);
+        epidemic.infectiousBites[p].store(0, std::memory_order_relaxed);
+        epidemic.patchCases[p].store(0, std::memory_order_relaxed);
+    }
+    unsigned interventions = planInterventions(epidemic);
+    importInfections(epidemic);
+    moveHumans(epidemic, pool);
+    updateVectors(epidemic, pool);
+    updateHumans(epidemic, pool);
+
+    // Cases reported in the last week or so decide where teams go next
+    for(size_t p = 0; p < epidemic.patchCount; p++) {
+        epidemic.incidence[p] = epidemic.incidence[p] * 0.8f +
+                                epidemic.patchCases[p].load(std::memory_order_relaxed);
+    }
+
+    report = EpidemicReport();
+    report.day = ++epidemic.day;
+    report.interventions = interventions;
+    for(const EpidemicTally& tally : epidemic.humanTallies) {
+        report.newCases += tally.newCases;
+        report.deaths += tally.deaths;
+        report.susceptible += tally.states[HUMAN_SUSCEPTIBLE];
+        report.exposed += tally.states[HUMAN_EXPOSED];
+        report.infectious += tally.states[HUMAN_INFECTIOUS];
+        report.recovered += tally.states[HUMAN_RECOVERED];
+    }
+    for(const EpidemicTally& tally : epidemic.vectorTallies) {
+        report.mosquitoes += tally.states[VECTOR_SUSCEPTIBLE] + tally.states[VECTOR_EXPOSED] +
+                             tally.states[VECTOR_INFECTIOUS];
+        report.infectiousMosquitoes += tally.states[VECTOR_INFECTIOUS];
+    }
+}
+
+const size_t EPIDEMIC_REPORT_CAPACITY = 256;
+
+// Steps the epidemic on its own thread, one day per request, and streams
+// the daily reports back through a lock-free queue
+struct EpidemicRunner {
+    Epidemic epidemic;
+    EpidemicParams params;
+    uint64_t seed;
+    unsigned workers;
+    WorkerPool pool;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;     // More days requested, or stopping
+    std::condition_variable finished; // A day was completed
+    unsigned long long requestedDays;
+    unsigned long long completedDays;
+    std::atomic<bool> stopping;
+    SpscQueue<EpidemicReport, EPIDEMIC_REPORT_CAPACITY> reports;
+};
+
+inline void epidemicRunnerThread(EpidemicRunner* runner) {
+    profileThreadId() = 2;
+    startWorkerPool(runner->pool, runner->workers);
+    initEpidemic(runner->epidemic, runner->params, runner->seed, runner->pool);
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock(runner->mutex);
+            runner->wake.wait(lock, [&] { return runner->stopping || runner->requestedDays > runner->completedDays; });
+            if(runner->stopping) break;
+        }
+
+        EpidemicReport report;
+        {
+            ProfileScope scope(PHASE_EPIDEMIC_DAY);
+            stepEpidemicDay(runner->epidemic, runner->pool, report);
+        }
+        while(!runner->reports.push(report)) {
+            if(runner->stopping.load()) break;
+            std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> lock(runner->mutex);
+        runner->completedDays++;
+        runner->finished.notify_all();
+    }
+    stopWorkerPool(runner->pool);
+}
+
+// Build the population and start the runner thread; workers is the number of
+// pool threads besides the runner itself
+inline void startEpidemicRunner(EpidemicRunner& runner, const EpidemicParams& params, uint64_t seed, unsigned workers) {
+    runner.params = params;
+    runner.seed = seed;
+    runner.workers = workers;
+    runner.requestedDays = 0;
+    runner.completedDays = 0;
+    runner.stopping.store(false);
+    runner.thread = std::thread(epidemicRunnerThread, &runner);
+}
+
+inline void stopEpidemicRunner(EpidemicRunner& runner) {
+    if(!runner.thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(runner.mutex);
+        runner.stopping.store(true);
+    }
+    runner.wake.notify_one();
+    runner.thread.join();
+}
+
+inline void requestEpidemicDay(EpidemicRunner& runner) {
+    {
+        std::lock_guard<std::mutex> lock(runner.mutex);
+        runner.requestedDays++;
+    }
+    runner.wake.notify_one();
+}
+
+// Days requested but not finished yet
+inline unsigned long long pendingEpidemicDays(EpidemicRunner& runner) {
+    std::lock_guard<std::mutex> lock(runner.mutex);
+    return runner.requestedDays - runner.completedDays;
+}
+
+// Block until every requested day is finished
+inline void waitForEpidemicDays(EpidemicRunner& runner) {
+    std::unique_lock<std::mutex> lock(runner.mutex);
+    runner.finished.wait(lock, [&] { return runner.completedDays == runner.requestedDays; });
+}
+
+#endif
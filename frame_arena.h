@@ -0,0 +1,90 @@
+/*
+ * Per-frame arena
+ * Transient data of one frame (formatted labels, scratch arrays) is carved
+ * from one block with a bump pointer and dropped all at once when the next
+ * frame begins. A frame that needs more than the block gets extra blocks from
+ * the heap; the next reset frees them and grows the block to the peak, so
+ * later frames fit again without touching the heap.
+ */
+
+#ifndef DENGUE_FRAME_ARENA_H
+#define DENGUE_FRAME_ARENA_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+const size_t FRAME_ARENA_ALIGN = 16;
+
+struct FrameArena {
+    char* base;
+    size_t capacity;
+    size_t used;
+    size_t frameBytes;           // Requested this frame, including overflow
+    size_t peak;                 // Most bytes any frame since the last grow requested
+    std::vector<void*> overflow; // Heap blocks of this frame, freed on reset
+};
+
+inline void initFrameArena(FrameArena& arena, size_t capacity) {
+    arena.base = static_cast<char*>(malloc(capacity));
+    arena.capacity = arena.base ? capacity : 0;
+    arena.used = arena.frameBytes = arena.peak = 0;
+    arena.overflow.reserve(16);
+}
+
+// Drop everything allocated since the last reset
+inline void resetFrameArena(FrameArena& arena) {
+    for(void* block : arena.overflow) free(block);
+    arena.overflow.clear();
+    if(arena.peak > arena.capacity) {
+        size_t capacity = arena.capacity ? arena.capacity : FRAME_ARENA_ALIGN;
+        while(capacity < arena.peak) capacity *= 2;
+        char* base = static_cast<char*>(malloc(capacity));
+        if(base) {
+            free(arena.base);
+            arena.base = base;
+            arena.capacity = capacity;
+        }
+    }
+    arena.used = arena.frameBytes = 0;
+}
+
+// Uninitialized memory valid until the next reset, aligned for any type
+inline void* arenaAllocate(FrameArena& arena, size_t size) {
+    size = (size + FRAME_ARENA_ALIGN - 1) / FRAME_ARENA_ALIGN * FRAME_ARENA_ALIGN;
+    arena.frameBytes += size;
+    if(arena.frameBytes > arena.peak) arena.peak = arena.frameBytes;
+    if(arena.used + size <= arena.capacity) {
+        void* p = arena.base + arena.used;
+        arena.used += size;
+        return p;
+    }
+    void* block = malloc(size ? size : 1);
+    if(!block) abort();
+    arena.overflow.push_back(block);
+    return block;
+}
+
+template<typename T>
+T* arenaArray(FrameArena& arena, size_t count) {
+    return static_cast<T*>(arenaAllocate(arena, count * sizeof(T)));
+}
+
+// printf into the arena
+inline const char* arenaPrintf(FrameArena& arena, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    char* text = static_cast<char*>(arenaAllocate(arena, length > 0 ? length + 1 : 1));
+    if(length > 0) vsnprintf(text, length + 1, format, args);
+    else text[0] = '\0';
+    va_end(args);
+    return text;
+}
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Frame pacing
+ * Schedules redraws against fixed deadlines instead of redrawing as fast as
+ * possible, drops to a low idle rate or to redraw-on-event when nothing on
+ * screen moves, and measures how far real frame intervals stray from the target.
+ */
+
+#ifndef DENGUE_FRAME_PACER_H
+#define DENGUE_FRAME_PACER_H
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <GL/gl.h>
+#elif defined(__APPLE__)
+#include <OpenGL/OpenGL.h>
+#else
+#include <GL/glx.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+enum PacingMode {
+    PACING_CONTINUOUS = 0, // Redraw at the target rate
+    PACING_IDLE,           // Only slow changes on screen, redraw at the idle rate
+    PACING_EVENT           // Nothing changes by itself, redraw only on input
+};
+
+const size_t PACER_HISTORY = 240;
+
+struct FramePacer {
+    float targetRate;   // Frames per second, 0 for uncapped
+    float idleRate;
+    PacingMode mode;
+    double nextDeadline; // Seconds on the pacer clock
+    double lastFrame;
+    bool haveLastFrame;
+    bool recordInterval; // False for the first frame after a mode change
+    // Intervals between frames paced at the target rate, as a ring
+    std::vector<float> intervals;
+    size_t intervalCount;
+    std::vector<double> deviations; // Scratch for computePacingStats
+    unsigned long long missedDeadlines;
+    std::chrono::steady_clock::time_point epoch;
+};
+
+struct PacingStats {
+    size_t frames;
+    double meanMs;
+    double jitterMs;        // Standard deviation of the frame interval
+    double p99DeviationMs;  // 99th percentile of |interval - target|
+    unsigned long long missed;
+};
+
+inline void initFramePacer(FramePacer& pacer, float targetRate, float idleRate) {
+    pacer.targetRate = std::max(0.0f, targetRate);
+    pacer.idleRate = std::max(1.0f, idleRate);
+    pacer.mode = PACING_CONTINUOUS;
+    pacer.nextDeadline = 0.0;
+    pacer.lastFrame = 0.0;
+    pacer.haveLastFrame = false;
+    pacer.recordInterval = false;
+    pacer.intervals.assign(PACER_HISTORY, 0.0f);
+    pacer.intervalCount = 0;
+    pacer.deviations.assign(PACER_HISTORY, 0.0);
+    pacer.missedDeadlines = 0;
+    pacer.epoch = std::chrono::steady_clock::now();
+}
+
+inline double pacerNow(const FramePacer& pacer) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - pacer.epoch).count();
+}
+
+// Redraw rate for the current mode, 0 for uncapped
+inline float pacerRate(const FramePacer& pacer) {
+    if(pacer.mode != PACING_IDLE) return pacer.targetRate;
+    return pacer.targetRate > 0.0f ? std::min(pacer.idleRate, pacer.targetRate) : pacer.idleRate;
+}
+
+// Call when a frame starts. Records the interval since the previous frame,
+// returns the frame time to feed the simulation.
+inline float beginPacedFrame(FramePacer& pacer) {
+    double now = pacerNow(pacer);
+    float frameTime = pacer.haveLastFrame ? static_cast<float>(now - pacer.lastFrame) : 0.0f;
+    // Jitter only means something for frames that were paced at the target rate
+    if(pacer.recordInterval && pacer.mode == PACING_CONTINUOUS && pacer.targetRate > 0.0f) {
+        pacer.intervals[pacer.intervalCount++ % PACER_HISTORY] = frameTime;
+        if(frameTime > 1.5f / pacer.targetRate) pacer.missedDeadlines++;
+    }
+    pacer.lastFrame = now;
+    pacer.haveLastFrame = true;
+    pacer.recordInterval = true;
+    // Nothing moves in event mode, so the time spent waiting for input is not simulated
+    return pacer.mode == PACING_EVENT ? 0.0f : frameTime;
+}
+
+// Switch mode after a frame, depending on what is left moving on screen
+inline void setPacingMode(FramePacer& pacer, PacingMode mode) {
+    if(mode == pacer.mode) return;
+    pacer.mode = mode;
+    // Start a new deadline chain, and do not count the switch as jitter
+    pacer.nextDeadline = pacerNow(pacer);
+    pacer.recordInterval = false;
+}
+
+// Milliseconds to wait before the next frame, or -1 in event mode
+inline int scheduleNextFrame(FramePacer& pacer) {
+    if(pacer.mode == PACING_EVENT) return -1;
+    float rate = pacerRate(pacer);
+    if(rate <= 0.0f) return 0;
+
+    double interval = 1.0 / rate;
+    double now = pacerNow(pacer);
+    pacer.nextDeadline += interval;
+    // Fell more than a frame behind (or just started), start a new deadline chain
+    if(pacer.nextDeadline < now - interval || pacer.nextDeadline > now + 2.0 * interval) {
+        pacer.nextDeadline = now + interval;
+    }
+    // Timers fire in whole milliseconds, never late on purpose
+    return std::max(0, static_cast<int>(std::floor((pacer.nextDeadline - now) * 1000.0)));
+}
+
+inline void computePacingStats(FramePacer& pacer, PacingStats& stats) {
+    size_t count = std::min(pacer.intervalCount, PACER_HISTORY);
+    stats.frames = count;
+    stats.missed = pacer.missedDeadlines;
+    stats.meanMs = stats.jitterMs = stats.p99DeviationMs = 0.0;
+    if(count == 0) return;
+
+    double sum = 0.0, sumSq = 0.0;
+    double target = pacer.targetRate > 0.0f ? 1.0 / pacer.targetRate : 0.0;
+    std::vector<double>& deviations = pacer.deviations;
+    for(size_t i = 0; i < count; i++) {
+        double interval = pacer.intervals[i];
+        sum += interval;
+        sumSq += interval * interval;
+        deviations[i] = std::fabs(interval - target);
+    }
+    double mean = sum / count;
+    stats.meanMs = mean * 1000.0;
+    stats.jitterMs = std::sqrt(std::max(0.0, sumSq / count - mean * mean)) * 1000.0;
+    std::sort(deviations.begin(), deviations.begin() + count);
+    stats.p99DeviationMs = deviations[(count - 1) * 99 / 100] * 1000.0;
+}
+
+// Set the buffer swap interval of the current context (0 = no vsync,
+// 1 = wait for every vertical blank). Returns false if the driver has no control.
+inline bool setSwapInterval(int interval) {
+#if defined(_WIN32)
+    typedef BOOL (WINAPI *SwapIntervalProc)(int);
+    SwapIntervalProc swapInterval = (SwapIntervalProc)wglGetProcAddress("wglSwapIntervalEXT");
+    return swapInterval && swapInterval(interval);
+#elif defined(__APPLE__)
+    GLint value = interval;
+    CGLContextObj context = CGLGetCurrentContext();
+    return context && CGLSetParameter(context, kCGLCPSwapInterval, &value) == kCGLNoError;
+#else
+    typedef void (*SwapIntervalEXTProc)(Display*, GLXDrawable, int);
+    typedef int (*SwapIntervalMESAProc)(unsigned int);
+    typedef int (*SwapIntervalSGIProc)(int);
+    const char* extensions = NULL;
+    Display* display = glXGetCurrentDisplay();
+    GLXDrawable drawable = glXGetCurrentDrawable();
+    if(display) extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+    if(!extensions || !drawable) return false;
+
+    if(strstr(extensions, "GLX_EXT_swap_control")) {
+        SwapIntervalEXTProc swapInterval =
+            (SwapIntervalEXTProc)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalEXT");
+        if(swapInterval) {
+            swapInterval(display, drawable, interval);
+            return true;
+        }
+    }
+    if(strstr(extensions, "GLX_MESA_swap_control")) {
+        SwapIntervalMESAProc swapInterval =
+            (SwapIntervalMESAProc)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalMESA");
+        if(swapInterval) return swapInterval(interval) == 0;
+    }
+    // The SGI extension cannot turn vsync off
+    if(interval > 0 && strstr(extensions, "GLX_SGI_swap_control")) {
+        SwapIntervalSGIProc swapInterval =
+            (SwapIntervalSGIProc)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalSGI");
+        if(swapInterval) return swapInterval(interval) == 0;
+    }
+    return false;
+#endif
+}
+
+#endif
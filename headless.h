@@ -0,0 +1,186 @@
+/*
+ * Headless offscreen rendering
+ * Creates an OpenGL context through EGL without a window or display server
+ * (Mesa's surfaceless platform works with llvmpipe on machines without a GPU)
+ * and renders into a framebuffer object that can be read back as images.
+ */
+
+#ifndef DENGUE_HEADLESS_H
+#define DENGUE_HEADLESS_H
+
+#if defined(__linux__)
+#define DENGUE_HAS_HEADLESS 1
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Frame time source that advances a fixed delta per rendered frame
+struct VirtualClock {
+    double now;
+    float frameDelta;
+    unsigned long long frame;
+};
+
+inline void initVirtualClock(VirtualClock& clock, float framesPerSecond) {
+    clock.now = 0.0;
+    clock.frameDelta = 1.0f / framesPerSecond;
+    clock.frame = 0;
+}
+
+// Advance one frame, returns the frame time to feed the simulation
+inline float tickVirtualClock(VirtualClock& clock) {
+    clock.now += clock.frameDelta;
+    clock.frame++;
+    return clock.frameDelta;
+}
+
+struct HeadlessContext {
+    EGLDisplay display;
+    EGLContext context;
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    GLuint depthBuffer;
+    int width, height;
+    std::vector<unsigned char> pixels;
+};
+
+// Prefer Mesa's surfaceless platform, which needs neither X11 nor a GPU device
+inline EGLDisplay openHeadlessDisplay() {
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if(extensions && strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if(getPlatformDisplay) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+            if(display != EGL_NO_DISPLAY) return display;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+// coreProfile asks for an OpenGL 3.3 core context, for the core renderer
+// backend; where EGL cannot make one the default context is used instead
+inline bool createHeadlessContext(HeadlessContext& ctx, int width, int height, bool coreProfile = false) {
+    ctx.width = width;
+    ctx.height = height;
+    ctx.display = openHeadlessDisplay();
+    if(ctx.display == EGL_NO_DISPLAY || !eglInitialize(ctx.display, NULL, NULL)) {
+        fprintf(stderr, "headless: no EGL display\n");
+        return false;
+    }
+    if(!eglBindAPI(EGL_OPENGL_API)) {
+        fprintf(stderr, "headless: EGL has no desktop OpenGL\n");
+        return false;
+    }
+
+    // No EGL surface is ever created, so any surface type will do
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, 0,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if(!eglChooseConfig(ctx.display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        fprintf(stderr, "headless: no matching EGL config\n");
+        return false;
+    }
+
+    // Default attributes give a compatibility profile, which the legacy
+    // renderer backend needs
+    ctx.context = EGL_NO_CONTEXT;
+    if(coreProfile) {
+        const EGLint coreAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+            EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+            EGL_NONE
+        };
+        ctx.context = eglCreateContext(ctx.display, config, EGL_NO_CONTEXT, coreAttribs);
+        if(ctx.context == EGL_NO_CONTEXT) {
+            fprintf(stderr, "headless: no OpenGL 3.3 core context (0x%x), using the default one\n", eglGetError());
+        }
+    }
+    if(ctx.context == EGL_NO_CONTEXT) ctx.context = eglCreateContext(ctx.display, config, EGL_NO_CONTEXT, NULL);
+    if(ctx.context == EGL_NO_CONTEXT ||
+       !eglMakeCurrent(ctx.display, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx.context)) {
+        fprintf(stderr, "headless: cannot create a surfaceless GL context (0x%x)\n", eglGetError());
+        return false;
+    }
+
+    PFNGLGENFRAMEBUFFERSPROC genFramebuffers =
+        (PFNGLGENFRAMEBUFFERSPROC)eglGetProcAddress("glGenFramebuffers");
+    PFNGLBINDFRAMEBUFFERPROC bindFramebuffer =
+        (PFNGLBINDFRAMEBUFFERPROC)eglGetProcAddress("glBindFramebuffer");
+    PFNGLGENRENDERBUFFERSPROC genRenderbuffers =
+        (PFNGLGENRENDERBUFFERSPROC)eglGetProcAddress("glGenRenderbuffers");
+    PFNGLBINDRENDERBUFFERPROC bindRenderbuffer =
+        (PFNGLBINDRENDERBUFFERPROC)eglGetProcAddress("glBindRenderbuffer");
+    PFNGLRENDERBUFFERSTORAGEPROC renderbufferStorage =
+        (PFNGLRENDERBUFFERSTORAGEPROC)eglGetProcAddress("glRenderbufferStorage");
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer =
+        (PFNGLFRAMEBUFFERRENDERBUFFERPROC)eglGetProcAddress("glFramebufferRenderbuffer");
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC checkFramebufferStatus =
+        (PFNGLCHECKFRAMEBUFFERSTATUSPROC)eglGetProcAddress("glCheckFramebufferStatus");
+    if(!genFramebuffers || !bindFramebuffer || !genRenderbuffers || !bindRenderbuffer ||
+       !renderbufferStorage || !framebufferRenderbuffer || !checkFramebufferStatus) {
+        fprintf(stderr, "headless: framebuffer objects are not supported\n");
+        return false;
+    }
+
+    genRenderbuffers(1, &ctx.colorBuffer);
+    bindRenderbuffer(GL_RENDERBUFFER, ctx.colorBuffer);
+    renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    genRenderbuffers(1, &ctx.depthBuffer);
+    bindRenderbuffer(GL_RENDERBUFFER, ctx.depthBuffer);
+    renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+
+    genFramebuffers(1, &ctx.framebuffer);
+    bindFramebuffer(GL_FRAMEBUFFER, ctx.framebuffer);
+    framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, ctx.colorBuffer);
+    framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, ctx.depthBuffer);
+    if(checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        fprintf(stderr, "headless: offscreen framebuffer is incomplete\n");
+        return false;
+    }
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+inline void destroyHeadlessContext(HeadlessContext& ctx) {
+    if(ctx.display == EGL_NO_DISPLAY) return;
+    eglMakeCurrent(ctx.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if(ctx.context != EGL_NO_CONTEXT) eglDestroyContext(ctx.display, ctx.context);
+    eglTerminate(ctx.display);
+    ctx.display = EGL_NO_DISPLAY;
+}
+
+// Read the offscreen framebuffer back and write it as a binary PPM
+inline bool writeFramePPM(HeadlessContext& ctx, const char* path) {
+    size_t rowBytes = static_cast<size_t>(ctx.width) * 3;
+    ctx.pixels.resize(rowBytes * ctx.height);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, ctx.width, ctx.height, GL_RGB, GL_UNSIGNED_BYTE, ctx.pixels.data());
+
+    FILE* file = fopen(path, "wb");
+    if(!file) return false;
+    fprintf(file, "P6\n%d %d\n255\n", ctx.width, ctx.height);
+    // OpenGL rows start at the bottom, image rows at the top
+    for(int row = ctx.height - 1; row >= 0; row--) {
+        fwrite(&ctx.pixels[row * rowBytes], 1, rowBytes, file);
+    }
+    return fclose(file) == 0;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Image atlas
+ * All images are packed into one RGBA texture on shelves, so drawing one
+ * image after another needs no texture bind. Each image keeps the rectangle
+ * of texture coordinates it occupies, inset by half a texel so linear
+ * filtering never reaches into its neighbours.
+ */
+
+#ifndef DENGUE_IMAGE_ATLAS_H
+#define DENGUE_IMAGE_ATLAS_H
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <string.h>
+#include <vector>
+
+const int IMAGE_ATLAS_WIDTH = 64;
+
+struct AtlasRegion {
+    int x, y, width, height; // Texels in the atlas
+    float u0, v0, u1, v1;    // Texture coordinates of the first and last texel centers
+};
+
+struct ImageAtlas {
+    GLuint texture;
+    int width, height;                 // Height is rounded up to a power of two on upload
+    int penX, penY, shelfHeight;
+    std::vector<unsigned char> pixels; // RGBA rows of IMAGE_ATLAS_WIDTH texels
+    std::vector<AtlasRegion> regions;
+};
+
+// Copy an RGBA image into the atlas, returns its region index or -1 if it is
+// wider than the atlas
+inline int addAtlasImage(ImageAtlas& atlas, const unsigned char* rgba, int width, int height) {
+    if(width <= 0 || height <= 0 || width > IMAGE_ATLAS_WIDTH) return -1;
+    if(atlas.penX + width > IMAGE_ATLAS_WIDTH) {
+        atlas.penX = 0;
+        atlas.penY += atlas.shelfHeight;
+        atlas.shelfHeight = 0;
+    }
+    AtlasRegion region = {atlas.penX, atlas.penY, width, height, 0.0f, 0.0f, 0.0f, 0.0f};
+    atlas.penX += width;
+    if(height > atlas.shelfHeight) atlas.shelfHeight = height;
+
+    size_t rowBytes = IMAGE_ATLAS_WIDTH * 4;
+    size_t used = static_cast<size_t>(atlas.penY + atlas.shelfHeight) * rowBytes;
+    if(atlas.pixels.size() < used) atlas.pixels.resize(used, 0);
+    for(int row = 0; row < height; row++) {
+        memcpy(&atlas.pixels[(region.y + row) * rowBytes + region.x * 4], rgba + row * width * 4, width * 4);
+    }
+    atlas.regions.push_back(region);
+    return static_cast<int>(atlas.regions.size() - 1);
+}
+
+// Create the texture and the texture coordinates of every region
+inline void uploadImageAtlas(ImageAtlas& atlas) {
+    atlas.width = IMAGE_ATLAS_WIDTH;
+    atlas.height = 1;
+    while(atlas.height < atlas.penY + atlas.shelfHeight) atlas.height *= 2;
+    atlas.pixels.resize(static_cast<size_t>(atlas.width) * atlas.height * 4, 0);
+    for(AtlasRegion& region : atlas.regions) {
+        region.u0 = (region.x + 0.5f) / atlas.width;
+        region.v0 = (region.y + 0.5f) / atlas.height;
+        region.u1 = (region.x + region.width - 0.5f) / atlas.width;
+        region.v1 = (region.y + region.height - 0.5f) / atlas.height;
+    }
+
+    if(!atlas.texture) glGenTextures(1, &atlas.texture);
+    glBindTexture(GL_TEXTURE_2D, atlas.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlas.width, atlas.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 atlas.pixels.data());
+}
+
+// Atlas coordinates of (u, v) in [0, 1] over a region; images do not repeat,
+// so coordinates outside it are clamped
+inline float atlasU(const AtlasRegion& region, float u) {
+    u = u < 0.0f ? 0.0f : (u > 1.0f ? 1.0f : u);
+    return region.u0 + u * (region.u1 - region.u0);
+}
+
+inline float atlasV(const AtlasRegion& region, float v) {
+    v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    return region.v0 + v * (region.v1 - region.v0);
+}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Cached screen layers
+ * Opaque rectangles of the screen that rarely change (the sky and ground, the
+ * scene name banner) are drawn in place once, and the window pixels they
+ * cover are copied into a texture. Until the layer's key or the window size
+ * change, it is composited as one textured quad instead of being drawn again.
+ */
+
+#ifndef DENGUE_LAYER_CACHE_H
+#define DENGUE_LAYER_CACHE_H
+
+#include <stddef.h>
+#include <cmath>
+
+#include "renderer.h"
+
+struct ScreenLayer {
+    GLuint texture;
+    int textureWidth, textureHeight; // Power-of-two allocation holding the pixels
+    int x, y, width, height;         // Window pixels covered
+    int windowWidth, windowHeight;
+    long key;
+    bool valid;                      // Texture holds the pixels for the key and rectangle above
+};
+
+struct LayerCache {
+    bool enabled;
+    // World to pixel mapping for the current frame
+    float left, bottom;
+    float unitsPerPixelX, unitsPerPixelY;
+    int windowWidth, windowHeight;
+    // Layers composited from their texture and drawn again this frame
+    size_t composited, redrawn;
+};
+
+// Set the mapping from world coordinates to window pixels for this frame
+inline void beginLayerFrame(LayerCache& cache, float left, float right, float bottom, float top,
+                            int windowWidth, int windowHeight) {
+    cache.left = left;
+    cache.bottom = bottom;
+    cache.unitsPerPixelX = (right - left) / windowWidth;
+    cache.unitsPerPixelY = (top - bottom) / windowHeight;
+    cache.windowWidth = windowWidth;
+    cache.windowHeight = windowHeight;
+    cache.composited = cache.redrawn = 0;
+}
+
+// Pixels whose centers fall inside [from, to), the ones a quad with these edges fills
+inline void layerPixelSpan(float from, float to, float origin, float unitsPerPixel, int limit,
+                           int& first, int& count) {
+    int begin = static_cast<int>(std::floor((from - origin) / unitsPerPixel + 0.5f));
+    int end = static_cast<int>(std::floor((to - origin) / unitsPerPixel + 0.5f));
+    begin = begin < 0 ? 0 : begin;
+    end = end > limit ? limit : end;
+    first = begin;
+    count = end > begin ? end - begin : 0;
+}
+
+// Draw the layer for `key` covering the world rectangle from its texture and
+// return true, or return false when it must be drawn again, followed by
+// captureLayer(). The rectangle must be filled opaquely by the layer.
+inline bool compositeLayer(LayerCache& cache, ScreenLayer& layer, Renderer& renderer, long key,
+                           float left, float bottom, float right, float top) {
+    if(!cache.enabled) return false;
+    int x, y, width, height;
+    layerPixelSpan(left, right, cache.left, cache.unitsPerPixelX, cache.windowWidth, x, width);
+    layerPixelSpan(bottom, top, cache.bottom, cache.unitsPerPixelY, cache.windowHeight, y, height);
+    if(!layer.valid || layer.key != key || layer.x != x || layer.y != y || layer.width != width ||
+       layer.height != height || layer.windowWidth != cache.windowWidth ||
+       layer.windowHeight != cache.windowHeight) {
+        layer.valid = false;
+        layer.key = key;
+        layer.x = x;
+        layer.y = y;
+        layer.width = width;
+        layer.height = height;
+        layer.windowWidth = cache.windowWidth;
+        layer.windowHeight = cache.windowHeight;
+        cache.redrawn++;
+        return false;
+    }
+    if(width == 0 || height == 0) return true;
+
+    // Quad edges on pixel edges and nearest filtering map every texel to its pixel
+    float x0 = cache.left + x * cache.unitsPerPixelX;
+    float y0 = cache.bottom + y * cache.unitsPerPixelY;
+    float x1 = cache.left + (x + width) * cache.unitsPerPixelX;
+    float y1 = cache.bottom + (y + height) * cache.unitsPerPixelY;
+    float u1 = static_cast<float>(width) / layer.textureWidth;
+    float v1 = static_cast<float>(height) / layer.textureHeight;
+    const float quad[6][RENDER_STRIDE] = {
+        {x0, y0, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f}, {x1, y0, u1, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f},
+        {x1, y1, u1, v1, 1.0f, 1.0f, 1.0f, 1.0f}, {x0, y0, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f},
+        {x1, y1, u1, v1, 1.0f, 1.0f, 1.0f, 1.0f}, {x0, y1, 0.0f, v1, 1.0f, 1.0f, 1.0f, 1.0f}
+    };
+    setRenderTexture(renderer, layer.texture, RENDER_RGBA);
+    drawRenderVertices(renderer, GL_TRIANGLES, quad[0], 6);
+    setRenderTexture(renderer, 0, RENDER_UNTEXTURED);
+    cache.composited++;
+    return true;
+}
+
+// Copy the pixels of a layer just drawn by the caller from the frame being
+// rendered, so the following frames can composite them
+inline void captureLayer(LayerCache& cache, ScreenLayer& layer) {
+    if(!cache.enabled || layer.width == 0 || layer.height == 0) return;
+    int textureWidth = 1, textureHeight = 1;
+    while(textureWidth < layer.width) textureWidth *= 2;
+    while(textureHeight < layer.height) textureHeight *= 2;
+
+    if(!layer.texture) glGenTextures(1, &layer.texture);
+    glBindTexture(GL_TEXTURE_2D, layer.texture);
+    if(layer.textureWidth != textureWidth || layer.textureHeight != textureHeight) {
+        layer.textureWidth = textureWidth;
+        layer.textureHeight = textureHeight;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0,
+                     GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    }
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, layer.x, layer.y, layer.width, layer.height);
+    layer.valid = true;
+}
+
+#endif
@@ -7,14 +7,49 @@
 #include <GLUT/glut.h>
 #else
 #include <GL/glut.h>
+#ifdef FREEGLUT
+#include <GL/freeglut_ext.h>
+#endif
 #endif
 
 #include <stdlib.h>
+#include <stdio.h>
 #include <string>
 #include <vector>
 #include <cmath>
-#include <map>
 #include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <string.h>
+
+#include "sim_clock.h"
+#include "swarm.h"
+#include "steering.h"
+#include "circle_cache.h"
+#include "text_atlas.h"
+#include "headless.h"
+#include "profiler.h"
+#include "spatial_grid.h"
+#include "frame_pacer.h"
+#include "random.h"
+#include "rain.h"
+#include "sim_channel.h"
+#include "epidemic.h"
+#include "case_store.h"
+#include "chart.h"
+#include "retained.h"
+#include "layer_cache.h"
+#include "image_atlas.h"
+#include "draw_queue.h"
+#include "renderer.h"
+#include "asset_loader.h"
+#include "frame_arena.h"
+#include "alloc_tracker.h"
+
+#ifdef DENGUE_HAS_HEADLESS
+#include "bench/frame_bench.h"
+#endif
 
 // Scene and animation management
 static int currentScene = 0;
@@ -35,7 +70,6 @@ static int killedMosquitoes = 0;
 static float rippleTime = 0.0f;
 static float mosquitoLifeCycle = 0.0f;
 static float pulseEffect = 0.0f;
-static float rainEffect = 0.0f;
 static bool isRaining = false;
 static float mosquitoSpawnTimer = 0.0f;
 static float mosquitoSpawnInterval = 2.0f;
@@ -49,6 +83,76 @@ static float killEffectTime = 0.0f;
 static int mosquitoToKill = -1;
 static bool isKillingMosquito = false;
 
+// Fixed-timestep simulation clock and render interpolation factor
+static SimClock simClock;
+static int tickRate = DEFAULT_TICK_RATE;
+static float renderAlpha = 1.0f;
+static float prevWaterLevel = 0.0f;
+
+// Window pixels per world unit, used to choose circle tessellation
+static float pixelsPerUnit = 60.0f;
+
+// Rasterized fonts and the text queued for this frame
+static TextAtlas textAtlas;
+
+// Size of the window or offscreen framebuffer being drawn to
+static int viewWidth = 800;
+static int viewHeight = 600;
+
+// Windowed frame pacing: target and idle redraw rates, and the swap interval
+// to request (-1 keeps the driver default)
+static FramePacer framePacer;
+static float targetFrameRate = 60.0f;
+static float idleFrameRate = 5.0f;
+static int swapInterval = -1;
+static bool frameTimerPending = false;
+
+// Frame profiler HUD and trace output
+static const size_t PROFILER_HUD_WINDOW = 4096;
+static PhaseStatsBuffers profilerHudBuffers;
+static const char* const DEFAULT_TRACE_OUTPUT = "dengue_trace.json";
+static const char* traceOutput = NULL;
+
+// Transient data of the current frame, dropped when the next one begins
+static FrameArena frameArena;
+const size_t FRAME_ARENA_SIZE = 64 * 1024;
+
+// Heap allocation tracking: counts per frame phase, and a report (an abort
+// in debug builds) when a frame allocates after settling
+static bool trackAllocations = false;
+static AllocationFrame lastAllocations;
+// The GL driver may allocate the first time it sees new state (llvmpipe
+// compiles shader variants with new), so day/night switches and the first
+// frames of a shower settle again too, and so does opening the profiler HUD,
+// whose labels fill the text caches
+const int ALLOCATION_WARMUP_FRAMES = 10; // Frames to settle after a scene change, resize or state switch
+static int allocationWarmup = ALLOCATION_WARMUP_FRAMES;
+static int allocationScene = -1;
+static int allocationWidth = 0, allocationHeight = 0;
+static bool allocationDayMode = true;
+static bool allocationHud = false;
+static bool allocationRain = false;
+
+// Headless rendering options
+static bool headlessMode = false;
+static int headlessFirstScene = 0;
+static int headlessLastScene = TOTAL_SCENES - 1;
+static int headlessFramesPerScene = -1; // Defaults to one scene duration
+static float headlessFrameRate = 30.0f;
+static const char* headlessOutput = NULL;
+static bool autoSceneTransition = true;
+
+// Scripted benchmark options, dengue_bench runs the benchmark by default
+#ifdef DENGUE_BENCH
+static bool benchMode = true;
+#else
+static bool benchMode = false;
+#endif
+static const int BENCH_WARMUP_FRAMES = 30;
+static const char* benchOutput = NULL;
+static const char* benchBaseline = NULL;
+static float benchThreshold = 15.0f; // Percent slowdown that fails the run
+
 // Add new animation variables for people
 struct Person {
     float x, y;
@@ -56,22 +160,25 @@ struct Person {
     bool isMoving;
     float moveDirection;
     float animationTime;
+    float prevAnimationTime;
     int type; // 0: fighter, 1: cleaner, 2: inspector, 3: patient
 };
 
 std::vector<Person> people;
 const int MAX_MOSQUITOES = 20;
 const int MIN_MOSQUITOES = 0;
+static int maxMosquitoes = MAX_MOSQUITOES; // Raised by --mosquitoes for swarm scenes
 static float mosquitoSpawnRate = 0.5f; // Mosquitoes per second
 
 // Add statistics data
 struct Statistics {
     int year;
-    int cases;
-    int deaths;
-    int prevention;
+    unsigned long long cases;
+    unsigned long long deaths;
+    unsigned long long prevention;
 };
 
+// Built-in figures, replaced by the yearly totals of --cases when given
 std::vector<Statistics> yearlyStats = {
     {2018, 1200, 15, 800},
     {2019, 1500, 20, 1000},
@@ -80,6 +187,55 @@ std::vector<Statistics> yearlyStats = {
     {2022, 1000, 12, 1800},
     {2023, 800, 8, 2000}
 };
+static const char* casesPath = NULL;
+static CaseStore caseStore;
+// Full-height values of the bar chart, derived from yearlyStats
+static float statsCountScale = 1.0f; // Cases and prevention share one axis
+static float statsDeathScale = 1.0f;
+static std::string statsTitle;
+static std::string statsScaleLabel;
+static float statsBarSpacing = 1.2f;
+static float statsBarWidth = 0.8f;
+static size_t statsLabelStep = 1;
+
+// Decimated line charts of the Statistics scene
+static ChartDecimation chartDecimation = CHART_MINMAX;
+static ChartSeries dailyCasesSeries;       // Daily totals of the case file
+static ChartSeries districtEnvelopeSeries; // Every report row of the case file
+static std::atomic<bool> districtEnvelopeReady(false);
+static std::thread caseSummaryThread;
+
+// Everything is drawn through the renderer, the fixed-function pipeline by
+// default or OpenGL 3.3 core with --renderer gl33
+static RenderBackend requestedRenderBackend = RENDER_LEGACY;
+static bool persistentStream = true; // Orphan the core backend's stream buffer instead with --stream orphan
+static Renderer renderer;
+
+// Geometry that never moves, recorded once per scene and drawn from GPU buffers
+static MeshPath requestedMeshPath = MESH_BUFFER; // MESH_CLIENT re-submits every frame, for comparison
+static MeshPath meshPath = MESH_CLIENT;
+static StaticMesh sceneMeshes[9];
+static StaticMesh ambulanceMesh;
+static StaticMesh emergencyMesh;
+
+// Screen layers drawn once and composited from textures until they change
+static LayerCache layerCache = {true, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0, 0, 0};
+static ScreenLayer backgroundLayer;
+static ScreenLayer sceneNameLayer;
+static ScreenLayer emergencyLayer;
+
+// Simulated city outbreak shown live in the Statistics scene. The engine
+// steps whole days on its own threads; the simulation requests a day every
+// 1 / epidemicDaysPerSecond seconds and collects the daily reports.
+static EpidemicRunner epidemicRunner;
+static EpidemicParams epidemicParams = defaultEpidemicParams();
+static float epidemicDaysPerSecond = 10.0f;
+static int epidemicWorkers = -1; // Pool threads besides the runner, -1 for one per spare core
+static float epidemicClock = 0.0f;
+static bool epidemicLockstep = true; // Wait for each day, so runs without a simulation thread repeat exactly
+const size_t EPIDEMIC_CHART_DAYS = 365;
+static std::vector<EpidemicReport> epidemicHistory; // Trimmed before it outgrows 2 * EPIDEMIC_CHART_DAYS
+static ChartSeries epidemicCasesSeries, epidemicDeathsSeries;
 
 // Colors
 struct Color {
@@ -93,19 +249,6 @@ const Color HOUSE = {0.8f, 0.4f, 0.2f};
 const Color WATER = {0.0f, 0.5f, 1.0f};
 const Color AMBULANCE = {1.0f, 0.0f, 0.0f};
 
-// Scene names
-const std::map<int, std::string> SCENE_NAMES = {
-    {0, "Mosquito Journey Scene"},
-    {1, "Clean Environment Scene"},
-    {2, "Dengue Fighter Scene"},
-    {3, "Stagnant Water Scene"},
-    {4, "Home Inspection Scene"},
-    {5, "Symptoms Scene"},
-    {6, "Prevention Methods Scene"},
-    {7, "Treatment Options Scene"},
-    {8, "Statistics Scene"}
-};
-
 // Interactive elements
 struct InteractiveElement {
     float x, y;
@@ -117,106 +260,325 @@ struct InteractiveElement {
 
 std::vector<InteractiveElement> interactiveElements;
 
-// Mosquito struct for multiple mosquitoes
-struct Mosquito {
-    float x, y;
-    float speedX, speedY;
-    float wingAngle;
-    bool alive;
-};
-
-std::vector<Mosquito> mosquitoes;
+// Mosquito swarm, stored as structure-of-arrays
+MosquitoSwarm mosquitoes;
 const int MOSQUITO_COUNT = 10;
 
-// Information display system
-struct InfoMessage {
-    std::string text;
-    float displayTime;
-    float fadeTime;
-    bool active;
+// Random streams, all derived from randomSeed so runs can be replayed
+static uint64_t randomSeed = DEFAULT_RANDOM_SEED;
+static RandomStream spawnRandom;
+static RandomStream weatherRandom;
+static RandomStream rainRandom;
+static RandomBlocks jitterRandom;
+const size_t JITTER_RANDOM_BLOCK = 1024; // Mosquitoes per jitter stream
+
+// Rain drops and the ripples their splashes leave
+static RainPool rain;
+static RipplePool splashRipples;
+static int rainDrops = 10000;
+static std::vector<float> rainVerts;
+const size_t SPLASH_RIPPLE_CAPACITY = 256;
+const float SPLASH_RIPPLE_LIFETIME = 0.6f;
+const float RAIN_GROUND = -3.0f;
+
+// Water containers drawn by each scene, which also catch rain
+struct ContainerPlacement {
+    int scene;
+    float x, y, scale;
 };
 
-std::vector<InfoMessage> infoMessages;
+const ContainerPlacement WATER_CONTAINERS[] = {
+    {1, 0.0f, -2.0f, 1.0f},
+    {3, -3.0f, 1.0f, 1.0f},
+    {3, 0.0f, 1.0f, 1.0f},
+    {3, 3.0f, 1.0f, 1.0f},
+    {4, 3.0f, -2.0f, 1.0f},
+    {6, 0.0f, -2.0f, 1.0f}
+};
+
+// Grid over the view holding live mosquitoes and interactive elements for
+// picking. Element ids have PICK_ELEMENT set, mosquito ids are swarm indices.
+static SpatialGrid pickGrid;
+const uint32_t PICK_ELEMENT = 0x80000000u;
+const float PICK_CELL_SIZE = 0.25f;
+const float SWAT_RADIUS = 0.3f;
+const float VIEW_DIAGONAL = 14.15f;
+
+// Last known mouse position in world coordinates
+static float cursorX = 0.0f;
+static float cursorY = 0.0f;
+static int initialMosquitoes = MOSQUITO_COUNT;
+static SwarmKernel swarmKernel = SWARM_KERNEL_AUTO;
+static bool batchedMosquitoes = true; // Batched vertex arrays or one drawMosquito() each, toggled with B
+
+// Flocking and seeking ahead of each swarm update, turned off with --steering off
+static bool steeringEnabled = true;
+static SteeringGrid steeringGrid;
+static WorkerPool steeringPool; // Only started for swarms of more than one block
+const float STEERING_RADIUS = 0.5f;
+const int STEERING_NEIGHBORS = 8;
+const size_t MAX_SCENE_HOSTS = 8;
+
+// Information display system
 float messageTimer = 0.0f;
 const float MESSAGE_DURATION = 5.0f; // seconds per message
+const int SCENE_MESSAGES = 4;
 
 // Scene-specific information
-const std::map<int, std::vector<std::string>> SCENE_INFO = {
-    {0, {
-        "Mosquitoes go through four life stages: egg, larva, pupa, and adult",
-        "Female Aedes aegypti mosquitoes lay eggs in stagnant water",
-        "After hatching, they become larvae, then pupae, and finally adults",
-        "This scene shows how unchecked water sources contribute to breeding"
-    }},
-    {1, {
-        "A clean environment is the first defense against dengue",
-        "Remove stagnant water from plant pots, buckets, old tires, and drains",
-        "Proper garbage disposal and cleaning roof gutters helps",
-        "Using mosquito nets reduces breeding grounds for mosquitoes"
-    }},
-    {2, {
-        "Dengue Fighters are everyday heroes in our community",
-        "They include community workers, health officials, and citizens",
-        "They raise awareness and inspect areas for breeding grounds",
-        "You can be a Dengue Fighter by inspecting your surroundings"
-    }},
-    {3, {
-        "Stagnant water is a mosquito's favorite breeding place",
-        "Common spots: flowerpots, unused containers, air coolers",
-        "Empty and clean these spots weekly",
-        "Even a bottle cap full of water is enough for breeding"
-    }},
-    {4, {
-        "Regular home inspections help detect breeding areas early",
-        "Check bathrooms, balconies, and rooftop tanks",
-        "Don't forget refrigerator trays and water containers",
-        "Do a weekly '10-Minute Check' to eliminate standing water"
-    }},
-    {5, {
-        "Common symptoms: High fever (up to 104�F)",
-        "Severe headache, pain behind eyes, muscle and joint pain",
-        "Nausea, vomiting, and skin rash may occur",
-        "Bleeding (gums, nose) in severe cases - Seek help immediately"
-    }},
-    {6, {
-        "Prevent dengue by using repellents and mosquito nets",
-        "Wear long-sleeved clothes and install window screens",
-        "Cover water containers and apply larvicides",
-        "Raise community awareness about prevention"
-    }},
-    {7, {
-        "No specific cure, but early diagnosis saves lives",
-        "Treatment includes rest and plenty of fluids",
-        "Use paracetamol for fever (avoid aspirin/NSAIDs)",
-        "Hospital care needed for severe dengue - Don't self-medicate"
-    }},
-    {8, {
-        "Dengue cases are rising globally due to urbanization",
-        "Climate change increases mosquito breeding areas",
-        "Urban areas are at higher risk of outbreaks",
-        "Stay informed through health department updates"
-    }}
+const char* const JOURNEY_MESSAGES[SCENE_MESSAGES] = {
+    "Mosquitoes go through four life stages: egg, larva, pupa, and adult",
+    "Female Aedes aegypti mosquitoes lay eggs in stagnant water",
+    "After hatching, they become larvae, then pupae, and finally adults",
+    "This scene shows how unchecked water sources contribute to breeding"
+};
+
+const char* const CLEAN_ENVIRONMENT_MESSAGES[SCENE_MESSAGES] = {
+    "A clean environment is the first defense against dengue",
+    "Remove stagnant water from plant pots, buckets, old tires, and drains",
+    "Proper garbage disposal and cleaning roof gutters helps",
+    "Using mosquito nets reduces breeding grounds for mosquitoes"
+};
+
+const char* const FIGHTER_MESSAGES[SCENE_MESSAGES] = {
+    "Dengue Fighters are everyday heroes in our community",
+    "They include community workers, health officials, and citizens",
+    "They raise awareness and inspect areas for breeding grounds",
+    "You can be a Dengue Fighter by inspecting your surroundings"
+};
+
+const char* const STAGNANT_WATER_MESSAGES[SCENE_MESSAGES] = {
+    "Stagnant water is a mosquito's favorite breeding place",
+    "Common spots: flowerpots, unused containers, air coolers",
+    "Empty and clean these spots weekly",
+    "Even a bottle cap full of water is enough for breeding"
+};
+
+const char* const HOME_INSPECTION_MESSAGES[SCENE_MESSAGES] = {
+    "Regular home inspections help detect breeding areas early",
+    "Check bathrooms, balconies, and rooftop tanks",
+    "Don't forget refrigerator trays and water containers",
+    "Do a weekly '10-Minute Check' to eliminate standing water"
+};
+
+const char* const SYMPTOMS_MESSAGES[SCENE_MESSAGES] = {
+    "Common symptoms: High fever (up to 104�F)",
+    "Severe headache, pain behind eyes, muscle and joint pain",
+    "Nausea, vomiting, and skin rash may occur",
+    "Bleeding (gums, nose) in severe cases - Seek help immediately"
+};
+
+const char* const PREVENTION_MESSAGES[SCENE_MESSAGES] = {
+    "Prevent dengue by using repellents and mosquito nets",
+    "Wear long-sleeved clothes and install window screens",
+    "Cover water containers and apply larvicides",
+    "Raise community awareness about prevention"
+};
+
+const char* const TREATMENT_MESSAGES[SCENE_MESSAGES] = {
+    "No specific cure, but early diagnosis saves lives",
+    "Treatment includes rest and plenty of fluids",
+    "Use paracetamol for fever (avoid aspirin/NSAIDs)",
+    "Hospital care needed for severe dengue - Don't self-medicate"
 };
 
-// Texture IDs
-GLuint textureIDs[20]; // Array to store texture IDs
+const char* const STATISTICS_MESSAGES[SCENE_MESSAGES] = {
+    "Dengue cases are rising globally due to urbanization",
+    "Climate change increases mosquito breeding areas",
+    "Urban areas are at higher risk of outbreaks",
+    "Stay informed through health department updates"
+};
+
+// Everything a scene starts from, built once at startup and only read after:
+// its starting mosquitoes and the water its rain splashes into
+struct SceneState {
+    SwarmLayout mosquitoes;
+    SplashTarget splashTargets[sizeof(WATER_CONTAINERS) / sizeof(WATER_CONTAINERS[0])];
+    size_t splashTargetCount;
+    SteeringTarget hosts[MAX_SCENE_HOSTS];  // Heads of the people mosquitoes fly at
+    size_t hostCount;
+    SteeringTarget breedingSites[sizeof(WATER_CONTAINERS) / sizeof(WATER_CONTAINERS[0])];
+    size_t breedingSiteCount;
+};
+
+// Simulation systems a scene can need. Only the systems of the scene shown
+// are updated; the others keep their state, suspended, until a scene that
+// needs them comes up.
+enum SceneSystem {
+    SYSTEM_MOSQUITOES = 1 << 0, // Flight, spawning and swats
+    SYSTEM_PEOPLE     = 1 << 1, // People animations
+    SYSTEM_WATER      = 1 << 2, // Water rising and falling in the containers
+    SYSTEM_RAIN       = 1 << 3, // Weather changes, rain drops and their splashes
+    SYSTEM_EPIDEMIC   = 1 << 4  // Simulated city outbreak
+};
+
+// A scene: its text, the systems it needs and its hooks, any of which may be NULL
+struct Scene {
+    const char* name;
+    const char* const* messages;                // SCENE_MESSAGES info messages
+    unsigned systems;                           // SceneSystem bits
+    int mosquitoLimit;                          // Most mosquitoes at once, 0 for maxMosquitoes
+    int hostType;                               // Person type the mosquitoes seek, -1 for none
+    PacingMode pacing;                          // Redraw rate when only the scene itself moves
+    void (*init)(int scene, SceneState& state); // Build the starting state, once at startup
+    void (*enter)();                            // After the starting state is restored
+    void (*update)(float deltaTime);            // Scene animations, each tick after the systems
+    void (*draw)(float waterLevel);             // Moving parts, after the recorded static geometry
+    void (*exit)();                             // Before the next scene is entered
+};
+
+// Scene hooks, defined with the drawing code below
+void initJourneyScene(int scene, SceneState& state);
+void initSwarmScene(int scene, SceneState& state);
+void updateLifeCycle(float deltaTime);
+void updateRipplePhase(float deltaTime);
+void updatePulse(float deltaTime);
+void drawJourneyScene(float waterLevel);
+void drawCleanEnvironmentScene(float waterLevel);
+void drawFighterScene(float waterLevel);
+void drawStagnantWaterScene(float waterLevel);
+void drawHomeInspectionScene(float waterLevel);
+void drawSymptomsScene(float waterLevel);
+void drawPreventionScene(float waterLevel);
+void drawTreatmentScene(float waterLevel);
+void drawStatisticsScene(float waterLevel);
+
+// Every scene in presentation order, numbered 1-9 on the keyboard
+constexpr Scene SCENES[TOTAL_SCENES] = {
+    {"Mosquito Journey Scene", JOURNEY_MESSAGES, SYSTEM_MOSQUITOES | SYSTEM_RAIN, 3, -1, PACING_CONTINUOUS,
+     initJourneyScene, NULL, updateLifeCycle, drawJourneyScene, NULL},
+    {"Clean Environment Scene", CLEAN_ENVIRONMENT_MESSAGES, SYSTEM_PEOPLE | SYSTEM_RAIN, 0, -1,
+     PACING_CONTINUOUS, NULL, NULL, updateRipplePhase, drawCleanEnvironmentScene, NULL},
+    {"Dengue Fighter Scene", FIGHTER_MESSAGES, SYSTEM_MOSQUITOES | SYSTEM_PEOPLE | SYSTEM_RAIN, 0, 0,
+     PACING_CONTINUOUS, initSwarmScene, NULL, updatePulse, drawFighterScene, NULL},
+    {"Stagnant Water Scene", STAGNANT_WATER_MESSAGES,
+     SYSTEM_MOSQUITOES | SYSTEM_PEOPLE | SYSTEM_WATER | SYSTEM_RAIN, 0, 2, PACING_CONTINUOUS,
+     initSwarmScene, NULL, updateRipplePhase, drawStagnantWaterScene, NULL},
+    {"Home Inspection Scene", HOME_INSPECTION_MESSAGES, SYSTEM_PEOPLE | SYSTEM_WATER | SYSTEM_RAIN, 0, -1,
+     PACING_CONTINUOUS, NULL, NULL, NULL, drawHomeInspectionScene, NULL},
+    {"Symptoms Scene", SYMPTOMS_MESSAGES, SYSTEM_PEOPLE | SYSTEM_RAIN, 0, -1, PACING_CONTINUOUS,
+     NULL, NULL, NULL, drawSymptomsScene, NULL},
+    // Static drawings, only messages and scene changes need redraws
+    {"Prevention Methods Scene", PREVENTION_MESSAGES, SYSTEM_RAIN, 0, -1, PACING_IDLE,
+     NULL, NULL, NULL, drawPreventionScene, NULL},
+    {"Treatment Options Scene", TREATMENT_MESSAGES, SYSTEM_RAIN, 0, -1, PACING_IDLE,
+     NULL, NULL, NULL, drawTreatmentScene, NULL},
+    // Indoors: the bars and the outbreak chart, no weather
+    {"Statistics Scene", STATISTICS_MESSAGES, SYSTEM_EPIDEMIC, 0, -1, PACING_IDLE,
+     NULL, NULL, NULL, drawStatisticsScene, NULL}
+};
+
+bool sceneNeeds(int scene, SceneSystem system) {
+    return (SCENES[scene].systems & system) != 0;
+}
+
+static SceneState sceneStates[TOTAL_SCENES];
+static const SceneState* activeScene = NULL; // State of currentScene, NULL before the first is entered
+static int activeMessage = 0; // Index in SCENES[currentScene].messages
+
+// Everything the renderer draws from the simulation, copied out after each
+// tick. Arrays keep their capacity between copies, so publishing does not allocate.
+struct SimSnapshot {
+    double publishTime;                 // Seconds on the simulation clock
+    unsigned long long commandsApplied; // Input commands handled so far
+    int scene;
+    bool animating;
+    bool raining;
+    bool killing;
+    float waterLevel, prevWaterLevel;
+    float rippleTime;
+    float mosquitoLifeCycle;
+    float pulseEffect;
+    const char* message;                // Active info message of the scene, or NULL
+    MosquitoSwarm mosquitoes;           // Positions, wings and alive bits only
+    std::vector<Person> people;
+    RainPool rain;                      // Positions and velocities of falling drops only
+    RipplePool ripples;
+    std::vector<EpidemicReport> epidemicDays; // Up to EPIDEMIC_CHART_DAYS most recent days
+};
 
-// Load texture function using standard OpenGL
-GLuint loadTexture(const unsigned char* data, int width, int height) {
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+// Input forwarded from the GLUT callbacks to the simulation
+enum SimCommandType {
+    SIM_SET_SCENE = 0,     // Switch scene, starting over its messages and mosquitoes
+    SIM_TOGGLE_ANIMATION,
+    SIM_KILL_NEAREST,      // Kill the mosquito nearest (x, y)
+    SIM_POINTER_CLICK,     // Select an element and swat a mosquito at (x, y)
+    SIM_POINTER_MOVE       // Hover the element under (x, y)
+};
 
-    // Set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+struct SimCommand {
+    SimCommandType type;
+    int scene;
+    float x, y;
+};
 
-    // Load texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+const size_t SIM_COMMAND_CAPACITY = 256;
+
+// Snapshots from the simulation to the renderer, commands the other way.
+// Headless runs and --sim-thread off step the simulation on the render thread.
+static TripleBuffer<SimSnapshot> simSnapshots;
+static SpscQueue<SimCommand, SIM_COMMAND_CAPACITY> simCommands;
+static const SimSnapshot* simView = NULL;     // Snapshot being drawn this frame
+static unsigned long long simCommandsSent = 0;
+static unsigned long long simCommandsApplied = 0;
+static bool useSimThread = true;
+static std::thread* simThread = NULL;
+static std::atomic<bool> simRunning(false);
+static std::chrono::steady_clock::time_point simEpoch = std::chrono::steady_clock::now();
+
+// Images, all packed into one atlas texture
+enum ImageId {
+    IMAGE_MOSQUITO = 0,
+    IMAGE_WATER,
+    IMAGE_HOUSE,
+    IMAGE_PERSON,
+    IMAGE_AMBULANCE,
+    IMAGE_GRASS,
+    IMAGE_SKY_DAY,
+    IMAGE_SKY_NIGHT,
+    IMAGE_RAIN,
+    IMAGE_RIPPLE,
+    IMAGE_COUNT
+};
+static ImageAtlas imageAtlas;
 
-    return textureID;
+const AtlasRegion& imageRegion(ImageId image) {
+    return imageAtlas.regions[image];
 }
 
+// Moving parts of the frame, drawn sorted by state after the rain and again
+// for the boxes under the text
+enum DrawLayer {
+    LAYER_POSTERS = 0, // Illustrations from the asset archive
+    LAYER_WATER,      // Water in the containers
+    LAYER_RIPPLES,    // Rings on the water
+    LAYER_PEOPLE,
+    LAYER_MOSQUITOES, // Mosquitoes and their life cycle
+    LAYER_EFFECTS,    // Pulse and kill effects
+    LAYER_CHARTS,
+    LAYER_RAIN,       // Splash ripples, then the streaks
+    LAYER_PANELS      // Message, options and profiler boxes
+};
+static DrawQueue drawQueue;
+// Reserved for a frame besides the mosquitoes drawn one by one (3 submissions, 9 vertices each)
+const size_t DRAW_QUEUE_COMMANDS = 512;
+const size_t DRAW_QUEUE_VERTICES = 8192;
+
+// Illustrations from the asset archive, drawn in their average color until
+// their texture arrives and not at all when the archive lacks them
+struct Illustration {
+    const char* name;
+    int scene;
+    float left, bottom, right, top;
+};
+static const Illustration ILLUSTRATIONS[] = {
+    {"mosquito_life_cycle", 0, 1.5f, -1.0f, 3.75f, 2.0f},
+    {"symptoms_poster", 5, -1.8f, 1.0f, 1.8f, 2.8f}
+};
+static const size_t ILLUSTRATION_COUNT = sizeof(ILLUSTRATIONS) / sizeof(ILLUSTRATIONS[0]);
+static const char* const DEFAULT_ASSETS = "dengue_assets.pak";
+static const char* assetsPath = NULL;
+static AssetLoader assetLoader;
+
 // Initialize textures with default colors
 void initTextures() {
     // Create simple colored textures
@@ -231,26 +593,29 @@ void initTextures() {
     unsigned char rainData[4] = {200, 200, 255, 128};     // Light blue with alpha
     unsigned char rippleData[4] = {0, 128, 255, 128};     // Blue with alpha
 
-    // Load textures
-    textureIDs[0] = loadTexture(mosquitoData, 1, 1);
-    textureIDs[1] = loadTexture(waterData, 1, 1);
-    textureIDs[2] = loadTexture(houseData, 1, 1);
-    textureIDs[3] = loadTexture(personData, 1, 1);
-    textureIDs[4] = loadTexture(ambulanceData, 1, 1);
-    textureIDs[5] = loadTexture(grassData, 1, 1);
-    textureIDs[6] = loadTexture(skyDayData, 1, 1);
-    textureIDs[7] = loadTexture(skyNightData, 1, 1);
-    textureIDs[8] = loadTexture(rainData, 1, 1);
-    textureIDs[9] = loadTexture(rippleData, 1, 1);
+    // Pack them in ImageId order
+    addAtlasImage(imageAtlas, mosquitoData, 1, 1);
+    addAtlasImage(imageAtlas, waterData, 1, 1);
+    addAtlasImage(imageAtlas, houseData, 1, 1);
+    addAtlasImage(imageAtlas, personData, 1, 1);
+    addAtlasImage(imageAtlas, ambulanceData, 1, 1);
+    addAtlasImage(imageAtlas, grassData, 1, 1);
+    addAtlasImage(imageAtlas, skyDayData, 1, 1);
+    addAtlasImage(imageAtlas, skyNightData, 1, 1);
+    addAtlasImage(imageAtlas, rainData, 1, 1);
+    addAtlasImage(imageAtlas, rippleData, 1, 1);
+    uploadImageAtlas(imageAtlas);
 }
 
 // Function declarations
 void addInteractiveElement(float x, float y, float width, float height, int scene);
 void initInteractiveElements();
-void initMosquitoes();
-void initInfoMessages();
+void buildSceneStates();
+void enterScene(int scene);
 void initPeople();
 void startAutomaticDisplay();
+void rebuildPickGrid();
+void publishSnapshot(double now);
 void drawOptionsBox();
 void drawWaterRipple(float x, float y, float scale, float time);
 void drawMosquitoLifeCycle(float x, float y, float scale, float cycle);
@@ -258,6 +623,8 @@ void drawRain();
 void drawPulseEffect(float x, float y, float scale);
 void drawMosquitoKillEffect(float x, float y, float scale, float time);
 void drawSceneNameBox();
+void drawEpidemicChart(float bottom, float top);
+void drawCaseReportChart(float bottom, float top);
 
 // Function definitions
 void addInteractiveElement(float x, float y, float width, float height, int scene) {
@@ -272,52 +639,108 @@ void initInteractiveElements() {
     addInteractiveElement(3.0f, 1.0f, 1.0f, 1.0f, 1); // Mosquito repellent
 }
 
-void initMosquitoes() {
-    mosquitoes.clear();
-    if (currentScene == 0) {
-        mosquitoes.push_back({-2.0f, 2.0f, 0.02f, -0.01f, 0.0f, true});
-    } else {
-        for(int i = 0; i < MOSQUITO_COUNT; ++i) {
-            float x = -4.0f + static_cast<float>(rand()) / RAND_MAX * 8.0f;
-            float y = -2.0f + static_cast<float>(rand()) / RAND_MAX * 6.0f;
-            float speedX = 0.01f + static_cast<float>(rand()) / RAND_MAX * 0.03f;
-            float speedY = 0.01f + static_cast<float>(rand()) / RAND_MAX * 0.03f;
-            if(rand() % 2) speedX = -speedX;
-            if(rand() % 2) speedY = -speedY;
-            mosquitoes.push_back({x, y, speedX, speedY, 0.0f, true});
-        }
+// Restart every random stream from randomSeed
+void seedRandomStreams() {
+    seedRandomStream(spawnRandom, randomSeed, RANDOM_STREAM_SPAWN);
+    seedRandomStream(weatherRandom, randomSeed, RANDOM_STREAM_WEATHER);
+    seedRandomStream(rainRandom, randomSeed, RANDOM_STREAM_RAIN);
+    seedRandomBlocks(jitterRandom, randomSeed, RANDOM_STREAM_JITTER, JITTER_RANDOM_BLOCK);
+}
+
+// A single mosquito crossing the Mosquito Journey Scene
+void initJourneyScene(int scene, SceneState& state) {
+    (void)scene;
+    addLayoutMosquito(state.mosquitoes, -2.0f, 2.0f, 0.02f, -0.01f);
+}
+
+// initialMosquitoes scattered over the view, from the scene's own stream
+void initSwarmScene(int scene, SceneState& state) {
+    RandomStream random;
+    seedRandomStream(random, randomSeed, RANDOM_STREAM_LAYOUT, scene);
+    for(int i = 0; i < initialMosquitoes; ++i) {
+        float x = randomRange(random, -4.0f, 4.0f);
+        float y = randomRange(random, -2.0f, 4.0f);
+        float speedX = randomRange(random, 0.01f, 0.04f);
+        float speedY = randomRange(random, 0.01f, 0.04f);
+        if(randomBool(random)) speedX = -speedX;
+        if(randomBool(random)) speedY = -speedY;
+        addLayoutMosquito(state.mosquitoes, x, y, speedX, speedY);
     }
 }
 
-void initInfoMessages() {
-    infoMessages.clear();
-    auto it = SCENE_INFO.find(currentScene);
-    if(it != SCENE_INFO.end()) {
-        const auto& messages = it->second;
-        for(const auto& msg : messages) {
-            infoMessages.push_back({msg, 0.0f, 0.0f, false});
+// Build the state of every scene. Layouts draw from a stream per scene, so
+// a scene always starts the same way whatever was shown before it. Needs
+// initPeople() for the hosts.
+void buildSceneStates() {
+    for(int scene = 0; scene < TOTAL_SCENES; scene++) {
+        SceneState& state = sceneStates[scene];
+        if(SCENES[scene].init) SCENES[scene].init(scene, state);
+
+        // The opening of the water quad in drawContainerWater
+        state.splashTargetCount = 0;
+        state.breedingSiteCount = 0;
+        for(const ContainerPlacement& container : WATER_CONTAINERS) {
+            if(container.scene != scene) continue;
+            SplashTarget& target = state.splashTargets[state.splashTargetCount++];
+            target.minX = container.x - 0.25f * container.scale;
+            target.maxX = container.x + 0.25f * container.scale;
+            target.top = container.y + 0.2f * container.scale;
+            // Mosquitoes lay their eggs on the same water surface
+            state.breedingSites[state.breedingSiteCount++] = {container.x, target.top};
         }
-        if(!infoMessages.empty()) {
-            infoMessages[0].active = true;
+
+        // People stand still, so their heads are fixed targets
+        state.hostCount = 0;
+        for(const Person& person : people) {
+            if(person.type != SCENES[scene].hostType || state.hostCount == MAX_SCENE_HOSTS) continue;
+            state.hosts[state.hostCount++] = {person.x, person.y + 0.4f * person.scale};
         }
     }
 }
 
+// Switch to a scene: point at its state, start its messages over and copy its
+// starting mosquitoes into the swarm, whose slots are reserved up front
+void enterScene(int scene) {
+    if(activeScene && SCENES[currentScene].exit) SCENES[currentScene].exit();
+    currentScene = scene;
+    activeScene = &sceneStates[scene];
+    activeMessage = 0;
+    messageTimer = 0.0f;
+    resetSwarm(mosquitoes, activeScene->mosquitoes);
+
+    // A swat in progress was aimed at a mosquito of the old swarm
+    isKillingMosquito = false;
+    killEffectTime = 0.0f;
+    mosquitoToKill = -1;
+    if(SCENES[scene].enter) SCENES[scene].enter();
+}
+
 void startAutomaticDisplay() {
     // Initialize all displays
-    initInfoMessages();
-    initMosquitoes();
-    initInteractiveElements();
     initPeople();
+    buildSceneStates();
+    initSwarm(mosquitoes, maxMosquitoes);
+    initSteeringGrid(steeringGrid, -5.0f, -5.0f, 5.0f, 5.0f, STEERING_RADIUS, mosquitoes.capacity);
+    reserveRenderInstances(renderer, mosquitoes.capacity);
+    reserveDrawQueue(drawQueue, DRAW_QUEUE_COMMANDS + 3 * mosquitoes.capacity,
+                     DRAW_QUEUE_VERTICES + 9 * mosquitoes.capacity);
+    initInteractiveElements();
+    initSpatialGrid(pickGrid, -5.0f, -5.0f, 5.0f, 5.0f, PICK_CELL_SIZE);
+    initRainPool(rain, rainDrops);
+    initRipplePool(splashRipples, SPLASH_RIPPLE_CAPACITY, SPLASH_RIPPLE_LIFETIME);
 
     // Start with first scene
-    currentScene = 0;
+    enterScene(0);
+    rebuildPickGrid();
 
     // Enable all displays
     isAnimating = true;
     showInfo = true;
     showAmbulance = true;
     showEmergency = true;
+
+    // Give the renderer a first snapshot to draw
+    publishSnapshot(0.0);
 }
 
 // Check if point is inside an element
@@ -326,95 +749,144 @@ bool isPointInside(float x, float y, const InteractiveElement& element) {
             y >= element.y - element.height/2 && y <= element.y + element.height/2);
 }
 
+// Re-bucket live mosquitoes and interactive elements after the simulation moved them
+void rebuildPickGrid() {
+    clearSpatialGrid(pickGrid);
+    // Room for a full swarm up front, so a growing one does not reallocate every few frames
+    pickGrid.items.reserve(mosquitoes.capacity + interactiveElements.size());
+    for(size_t w = 0; w < mosquitoes.aliveMask.size(); w++) {
+        uint64_t word = mosquitoes.aliveMask[w];
+        while(word) {
+            size_t i = w * 64 + __builtin_ctzll(word);
+            word &= word - 1;
+            addGridPoint(pickGrid, static_cast<uint32_t>(i), mosquitoes.x[i], mosquitoes.y[i]);
+        }
+    }
+    for(size_t i = 0; i < interactiveElements.size(); i++) {
+        const InteractiveElement& element = interactiveElements[i];
+        addGridBox(pickGrid, static_cast<uint32_t>(i) | PICK_ELEMENT,
+                   element.x - element.width/2, element.y - element.height/2,
+                   element.x + element.width/2, element.y + element.height/2);
+    }
+    buildSpatialGrid(pickGrid);
+}
+
+// Live mosquito closest to (x, y) within maxRadius, or -1
+long findNearestMosquito(float x, float y, float maxRadius) {
+    return findNearestInGrid(pickGrid, x, y, maxRadius, [&](uint32_t id) {
+        if(id & PICK_ELEMENT) return -1.0f;
+        if(!isMosquitoAlive(mosquitoes, id)) return -1.0f;
+        float dx = mosquitoes.x[id] - x, dy = mosquitoes.y[id] - y;
+        return dx * dx + dy * dy;
+    });
+}
+
+// Interactive element under (x, y) whose center is closest, or -1
+int pickInteractiveElement(float x, float y) {
+    int picked = -1;
+    float pickedDistance = 0.0f;
+    forEachAtPoint(pickGrid, x, y, [&](uint32_t id) {
+        if(!(id & PICK_ELEMENT)) return;
+        int i = static_cast<int>(id & ~PICK_ELEMENT);
+        const InteractiveElement& element = interactiveElements[i];
+        if(!isPointInside(x, y, element)) return;
+        float dx = element.x - x, dy = element.y - y;
+        float distance = dx * dx + dy * dy;
+        if(picked < 0 || distance < pickedDistance) {
+            picked = i;
+            pickedDistance = distance;
+        }
+    });
+    return picked;
+}
+
+// Start the kill effect on a mosquito
+void swatMosquito(long i) {
+    if(isKillingMosquito || i < 0) return;
+    mosquitoToKill = i;
+    isKillingMosquito = true;
+    killEffectTime = 0.0f;
+    killedMosquitoes++;
+}
+
 // Draw a mosquito with animation
 void drawMosquito(float x, float y, float scale, float wingAngle) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+    queueTransform(drawQueue, x, y, scale);
 
     // Body
-    glColor3f(0.2f, 0.2f, 0.2f);
-    glBegin(GL_LINES);
-    glVertex2f(0, 0);
-    glVertex2f(0, 0.5f);
-    glEnd();
+    queueBegin(drawQueue, LAYER_MOSQUITOES, DRAW_LINES, false);
+    queueColor(drawQueue, 0.2f, 0.2f, 0.2f);
+    queueVertex(drawQueue, 0, 0);
+    queueVertex(drawQueue, 0, 0.5f);
 
     // Wings with enhanced animation
-    glColor4f(0.3f, 0.3f, 0.3f, 0.8f);
-    glBegin(GL_TRIANGLES);
+    queueBegin(drawQueue, LAYER_MOSQUITOES, DRAW_TRIANGLES, true);
+    queueColor(drawQueue, 0.3f, 0.3f, 0.3f, 0.8f);
     // Left wing with smoother animation
     float wingAngle1 = sin(wingAngle * mosquitoWingSpeed) * 0.5f;
-    glVertex2f(0, 0.3f);
-    glVertex2f(-0.2f * cos(wingAngle1), 0.4f);
-    glVertex2f(0, 0.5f);
+    queueVertex(drawQueue, 0, 0.3f);
+    queueVertex(drawQueue, -0.2f * cos(wingAngle1), 0.4f);
+    queueVertex(drawQueue, 0, 0.5f);
 
     // Right wing with smoother animation
-    glVertex2f(0, 0.3f);
-    glVertex2f(0.2f * cos(wingAngle1), 0.4f);
-    glVertex2f(0, 0.5f);
-    glEnd();
+    queueVertex(drawQueue, 0, 0.3f);
+    queueVertex(drawQueue, 0.2f * cos(wingAngle1), 0.4f);
+    queueVertex(drawQueue, 0, 0.5f);
 
     // Add a small dot for the head
-    glColor3f(0.1f, 0.1f, 0.1f);
-    glPointSize(3.0f);
-    glBegin(GL_POINTS);
-    glVertex2f(0, 0.5f);
-    glEnd();
-
-    glPopMatrix();
+    queueBegin(drawQueue, LAYER_MOSQUITOES, DRAW_POINTS, false, 0, 3.0f);
+    queueColor(drawQueue, 0.1f, 0.1f, 0.1f);
+    queueVertex(drawQueue, 0, 0.5f);
 }
 
-// Draw a water container with animated water level
-void drawWaterContainer(float x, float y, float scale, float waterLevel) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
-
-    // Container
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureIDs[1]);
+// Record a water container body; the water inside is drawn per frame
+void recordWaterContainer(StaticMesh& mesh, float x, float y, float scale) {
+    meshTransform(mesh, x, y, scale);
+    const AtlasRegion& water = imageRegion(IMAGE_WATER);
+    meshColor(mesh, 1.0f, 1.0f, 1.0f);
+    meshTexture(mesh, imageAtlas.texture);
+    meshRect(mesh, -0.3f, -0.2f, 0.3f, 0.2f, water.u0, water.v0, water.u1, water.v1);
+    meshTexture(mesh, 0);
+}
 
-    // Draw container with texture
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(-0.3f, -0.2f);
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(0.3f, -0.2f);
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(0.3f, 0.2f);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(-0.3f, 0.2f);
-    glEnd();
+// Draw the animated water inside a container recorded at the same place
+void drawContainerWater(float x, float y, float scale, float waterLevel) {
+    if(waterLevel <= 0.0f) return;
+    queueTransform(drawQueue, x, y, scale);
 
     // Water with animated texture
-    glBindTexture(GL_TEXTURE_2D, textureIDs[1]);
-    glBegin(GL_QUADS);
+    const AtlasRegion& water = imageRegion(IMAGE_WATER);
+    queueBegin(drawQueue, LAYER_WATER, DRAW_TRIANGLES, true, imageAtlas.texture);
+    queueColor(drawQueue, 1.0f, 1.0f, 1.0f);
     float texY = waterLevel;
-    glTexCoord2f(0.0f, texY); glVertex2f(-0.25f, -0.15f);
-    glTexCoord2f(1.0f, texY); glVertex2f(0.25f, -0.15f);
-    glTexCoord2f(1.0f, texY + 0.3f); glVertex2f(0.25f, -0.15f + waterLevel * 0.3f);
-    glTexCoord2f(0.0f, texY + 0.3f); glVertex2f(-0.25f, -0.15f + waterLevel * 0.3f);
-    glEnd();
-
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
+    float u0 = atlasU(water, 0.0f), u1 = atlasU(water, 1.0f);
+    float v0 = atlasV(water, texY), v1 = atlasV(water, texY + 0.3f);
+    float top = -0.15f + waterLevel * 0.3f;
+    queueVertex(drawQueue, -0.25f, -0.15f, u0, v0);
+    queueVertex(drawQueue, 0.25f, -0.15f, u1, v0);
+    queueVertex(drawQueue, 0.25f, top, u1, v1);
+    queueVertex(drawQueue, -0.25f, -0.15f, u0, v0);
+    queueVertex(drawQueue, 0.25f, top, u1, v1);
+    queueVertex(drawQueue, -0.25f, top, u0, v1);
 }
 
 // Enhanced drawPerson function with different types
 void drawPerson(float x, float y, float scale, int type, float animationTime) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+    queueTransform(drawQueue, x, y, scale);
 
     // Body color based on type
     switch(type) {
         case 0: // Fighter
-            glColor3f(0.0f, 0.5f, 1.0f); // Blue uniform
+            queueColor(drawQueue, 0.0f, 0.5f, 1.0f); // Blue uniform
             break;
         case 1: // Cleaner
-            glColor3f(0.0f, 0.8f, 0.0f); // Green uniform
+            queueColor(drawQueue, 0.0f, 0.8f, 0.0f); // Green uniform
             break;
         case 2: // Inspector
-            glColor3f(1.0f, 0.5f, 0.0f); // Orange uniform
+            queueColor(drawQueue, 1.0f, 0.5f, 0.0f); // Orange uniform
             break;
         case 3: // Patient
-            glColor3f(1.0f, 0.8f, 0.8f); // Light red
+            queueColor(drawQueue, 1.0f, 0.8f, 0.8f); // Light red
             break;
     }
 
@@ -422,322 +894,539 @@ void drawPerson(float x, float y, float scale, int type, float animationTime) {
     float bodyOffset = sin(animationTime * 2.0f) * 0.05f;
 
     // Body
-    glBegin(GL_QUADS);
-    glVertex2f(-0.1f, 0.3f + bodyOffset);
-    glVertex2f(0.1f, 0.3f + bodyOffset);
-    glVertex2f(0.1f, -0.1f + bodyOffset);
-    glVertex2f(-0.1f, -0.1f + bodyOffset);
-    glEnd();
-
-    // Head
-    glColor3f(1.0f, 0.8f, 0.6f);
-    glBegin(GL_TRIANGLE_FAN);
-    for(int i = 0; i < 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
-        glVertex2f(0.1f * cos(angle), 0.1f * sin(angle) + 0.4f + bodyOffset);
-    }
-    glEnd();
+    queueBegin(drawQueue, LAYER_PEOPLE, DRAW_TRIANGLES, false);
+    queueQuad(drawQueue, -0.1f, 0.3f + bodyOffset, 0.1f, 0.3f + bodyOffset,
+              0.1f, -0.1f + bodyOffset, -0.1f, -0.1f + bodyOffset);
+
+    // Head, as a fan of triangles around its first vertex
+    const CircleLevel& head = circleForRadius(0.1f * scale * pixelsPerUnit);
+    queueColor(drawQueue, 1.0f, 0.8f, 0.6f);
+    float headY = 0.4f + bodyOffset;
+    for(int i = 1; i + 1 < head.segments; i++) {
+        queueVertex(drawQueue, 0.1f * head.cosines[0], 0.1f * head.sines[0] + headY);
+        queueVertex(drawQueue, 0.1f * head.cosines[i], 0.1f * head.sines[i] + headY);
+        queueVertex(drawQueue, 0.1f * head.cosines[i + 1], 0.1f * head.sines[i + 1] + headY);
+    }
 
     // Arms with animation
     float armAngle = sin(animationTime * 4.0f) * 0.3f;
-    glColor3f(0.0f, 0.5f, 1.0f);
-    glBegin(GL_LINES);
+    queueBegin(drawQueue, LAYER_PEOPLE, DRAW_LINES, false);
+    queueColor(drawQueue, 0.0f, 0.5f, 1.0f);
     // Left arm
-    glVertex2f(-0.1f, 0.2f + bodyOffset);
-    glVertex2f(-0.2f * cos(armAngle), 0.1f + bodyOffset);
+    queueVertex(drawQueue, -0.1f, 0.2f + bodyOffset);
+    queueVertex(drawQueue, -0.2f * cos(armAngle), 0.1f + bodyOffset);
     // Right arm
-    glVertex2f(0.1f, 0.2f + bodyOffset);
-    glVertex2f(0.2f * cos(armAngle), 0.1f + bodyOffset);
-    glEnd();
+    queueVertex(drawQueue, 0.1f, 0.2f + bodyOffset);
+    queueVertex(drawQueue, 0.2f * cos(armAngle), 0.1f + bodyOffset);
 
     // Legs with animation
     float legAngle = sin(animationTime * 4.0f + 3.14159f) * 0.2f;
-    glBegin(GL_LINES);
     // Left leg
-    glVertex2f(-0.05f, -0.1f + bodyOffset);
-    glVertex2f(-0.1f * cos(legAngle), -0.3f + bodyOffset);
+    queueVertex(drawQueue, -0.05f, -0.1f + bodyOffset);
+    queueVertex(drawQueue, -0.1f * cos(legAngle), -0.3f + bodyOffset);
     // Right leg
-    glVertex2f(0.05f, -0.1f + bodyOffset);
-    glVertex2f(0.1f * cos(legAngle), -0.3f + bodyOffset);
-    glEnd();
+    queueVertex(drawQueue, 0.05f, -0.1f + bodyOffset);
+    queueVertex(drawQueue, 0.1f * cos(legAngle), -0.3f + bodyOffset);
 
     // Add equipment based on type
     switch(type) {
         case 0: // Fighter with spray
-            glColor3f(0.5f, 0.5f, 0.5f);
-            glBegin(GL_LINES);
-            glVertex2f(0.2f * cos(armAngle), 0.1f + bodyOffset);
-            glVertex2f(0.4f * cos(armAngle), 0.0f + bodyOffset);
-            glEnd();
+            queueColor(drawQueue, 0.5f, 0.5f, 0.5f);
+            queueVertex(drawQueue, 0.2f * cos(armAngle), 0.1f + bodyOffset);
+            queueVertex(drawQueue, 0.4f * cos(armAngle), 0.0f + bodyOffset);
             break;
         case 1: // Cleaner with broom
-            glColor3f(0.6f, 0.3f, 0.1f);
-            glBegin(GL_LINES);
-            glVertex2f(-0.2f * cos(armAngle), 0.1f + bodyOffset);
-            glVertex2f(-0.4f * cos(armAngle), -0.1f + bodyOffset);
-            glEnd();
+            queueColor(drawQueue, 0.6f, 0.3f, 0.1f);
+            queueVertex(drawQueue, -0.2f * cos(armAngle), 0.1f + bodyOffset);
+            queueVertex(drawQueue, -0.4f * cos(armAngle), -0.1f + bodyOffset);
             break;
         case 2: // Inspector with clipboard
-            glColor3f(1.0f, 1.0f, 1.0f);
-            glBegin(GL_QUADS);
-            glVertex2f(0.2f * cos(armAngle), 0.1f + bodyOffset);
-            glVertex2f(0.3f * cos(armAngle), 0.1f + bodyOffset);
-            glVertex2f(0.3f * cos(armAngle), 0.0f + bodyOffset);
-            glVertex2f(0.2f * cos(armAngle), 0.0f + bodyOffset);
-            glEnd();
+            queueBegin(drawQueue, LAYER_PEOPLE, DRAW_TRIANGLES, false);
+            queueColor(drawQueue, 1.0f, 1.0f, 1.0f);
+            queueQuad(drawQueue, 0.2f * cos(armAngle), 0.1f + bodyOffset, 0.3f * cos(armAngle), 0.1f + bodyOffset,
+                      0.3f * cos(armAngle), 0.0f + bodyOffset, 0.2f * cos(armAngle), 0.0f + bodyOffset);
             break;
         case 3: // Patient with thermometer
-            glColor3f(1.0f, 0.0f, 0.0f);
-            glBegin(GL_LINES);
-            glVertex2f(0.2f * cos(armAngle), 0.1f + bodyOffset);
-            glVertex2f(0.3f * cos(armAngle), 0.2f + bodyOffset);
-            glEnd();
+            queueColor(drawQueue, 1.0f, 0.0f, 0.0f);
+            queueVertex(drawQueue, 0.2f * cos(armAngle), 0.1f + bodyOffset);
+            queueVertex(drawQueue, 0.3f * cos(armAngle), 0.2f + bodyOffset);
             break;
     }
+}
 
-    glPopMatrix();
+// Draw a person with its animation blended between the last two ticks
+void drawPersonInterpolated(const Person& person) {
+    drawPerson(person.x, person.y, person.scale, person.type,
+               lerpState(person.prevAnimationTime, person.animationTime, renderAlpha));
 }
 
-// Draw background
+// Draw background, from its layer unless the day/night mode or the window changed
 void drawBackground() {
-    glEnable(GL_TEXTURE_2D);
-
-    // Sky
-    if(isDayMode) {
-        glBindTexture(GL_TEXTURE_2D, textureIDs[6]);
-    } else {
-        glBindTexture(GL_TEXTURE_2D, textureIDs[7]);
-    }
-
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(-5.0f, -5.0f);
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(5.0f, -5.0f);
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(5.0f, 5.0f);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(-5.0f, 5.0f);
-    glEnd();
-
-    // Ground with grass texture
-    glBindTexture(GL_TEXTURE_2D, textureIDs[5]);
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(-5.0f, -5.0f);
-    glTexCoord2f(2.0f, 0.0f); glVertex2f(5.0f, -5.0f);
-    glTexCoord2f(2.0f, 1.0f); glVertex2f(5.0f, -3.0f);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(-5.0f, -3.0f);
-    glEnd();
-
-    glDisable(GL_TEXTURE_2D);
+    if(compositeLayer(layerCache, backgroundLayer, renderer, isDayMode, -5.0f, -5.0f, 5.0f, 5.0f)) return;
+
+    // Sky, then the ground with grass texture; atlas images do not repeat, so
+    // the grass is stretched across instead of tiled twice
+    const AtlasRegion& sky = imageRegion(isDayMode ? IMAGE_SKY_DAY : IMAGE_SKY_NIGHT);
+    const AtlasRegion& grass = imageRegion(IMAGE_GRASS);
+    const float vertices[12][RENDER_STRIDE] = {
+        {-5.0f, -5.0f, sky.u0, sky.v0, 1.0f, 1.0f, 1.0f, 1.0f},
+        {5.0f, -5.0f, sky.u1, sky.v0, 1.0f, 1.0f, 1.0f, 1.0f},
+        {5.0f, 5.0f, sky.u1, sky.v1, 1.0f, 1.0f, 1.0f, 1.0f},
+        {-5.0f, -5.0f, sky.u0, sky.v0, 1.0f, 1.0f, 1.0f, 1.0f},
+        {5.0f, 5.0f, sky.u1, sky.v1, 1.0f, 1.0f, 1.0f, 1.0f},
+        {-5.0f, 5.0f, sky.u0, sky.v1, 1.0f, 1.0f, 1.0f, 1.0f},
+        {-5.0f, -5.0f, grass.u0, grass.v0, 1.0f, 1.0f, 1.0f, 1.0f},
+        {5.0f, -5.0f, grass.u1, grass.v0, 1.0f, 1.0f, 1.0f, 1.0f},
+        {5.0f, -3.0f, grass.u1, grass.v1, 1.0f, 1.0f, 1.0f, 1.0f},
+        {-5.0f, -5.0f, grass.u0, grass.v0, 1.0f, 1.0f, 1.0f, 1.0f},
+        {5.0f, -3.0f, grass.u1, grass.v1, 1.0f, 1.0f, 1.0f, 1.0f},
+        {-5.0f, -3.0f, grass.u0, grass.v1, 1.0f, 1.0f, 1.0f, 1.0f}
+    };
+    setRenderTexture(renderer, imageAtlas.texture, RENDER_RGBA);
+    drawRenderVertices(renderer, GL_TRIANGLES, vertices[0], 12);
+    setRenderTexture(renderer, 0, RENDER_UNTEXTURED);
+    captureLayer(layerCache, backgroundLayer);
 }
 
-// Draw a house
-void drawHouse(float x, float y, float scale) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+// Record a house
+void recordHouse(StaticMesh& mesh, float x, float y, float scale) {
+    meshTransform(mesh, x, y, scale);
 
     // House body
-    glColor3f(HOUSE.r, HOUSE.g, HOUSE.b);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.5f, -0.5f);
-    glVertex2f(0.5f, -0.5f);
-    glVertex2f(0.5f, 0.5f);
-    glVertex2f(-0.5f, 0.5f);
-    glEnd();
+    meshColor(mesh, HOUSE.r, HOUSE.g, HOUSE.b);
+    meshRect(mesh, -0.5f, -0.5f, 0.5f, 0.5f);
 
     // Roof
-    glColor3f(0.5f, 0.2f, 0.1f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(-0.6f, 0.5f);
-    glVertex2f(0.0f, 0.8f);
-    glVertex2f(0.6f, 0.5f);
-    glEnd();
+    meshColor(mesh, 0.5f, 0.2f, 0.1f);
+    meshTriangle(mesh, -0.6f, 0.5f, 0.0f, 0.8f, 0.6f, 0.5f);
 
     // Door
-    glColor3f(0.4f, 0.2f, 0.1f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.1f, -0.5f);
-    glVertex2f(0.1f, -0.5f);
-    glVertex2f(0.1f, 0.0f);
-    glVertex2f(-0.1f, 0.0f);
-    glEnd();
-
-    glPopMatrix();
+    meshColor(mesh, 0.4f, 0.2f, 0.1f);
+    meshRect(mesh, -0.1f, -0.5f, 0.1f, 0.0f);
 }
 
-// Draw an ambulance
-void drawAmbulance(float x, float y, float scale) {
-    if(!showAmbulance) return;
-
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+// Record an ambulance
+void recordAmbulance(StaticMesh& mesh, float x, float y, float scale) {
+    meshTransform(mesh, x, y, scale);
 
     // Ambulance body
-    glColor3f(AMBULANCE.r, AMBULANCE.g, AMBULANCE.b);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.8f, -0.4f);
-    glVertex2f(0.8f, -0.4f);
-    glVertex2f(0.8f, 0.4f);
-    glVertex2f(-0.8f, 0.4f);
-    glEnd();
+    meshColor(mesh, AMBULANCE.r, AMBULANCE.g, AMBULANCE.b);
+    meshRect(mesh, -0.8f, -0.4f, 0.8f, 0.4f);
 
     // Cross symbol
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.2f, -0.2f);
-    glVertex2f(0.2f, -0.2f);
-    glVertex2f(0.2f, 0.2f);
-    glVertex2f(-0.2f, 0.2f);
-    glEnd();
+    meshColor(mesh, 1.0f, 1.0f, 1.0f);
+    meshRect(mesh, -0.2f, -0.2f, 0.2f, 0.2f);
+}
 
-    glPopMatrix();
+// Record the emergency contacts banner
+void recordEmergencyContacts(StaticMesh& mesh) {
+    meshTransform(mesh, 0.0f, 0.0f, 1.0f);
+    meshColor(mesh, 1.0f, 0.0f, 0.0f);
+    meshRect(mesh, -4.0f, 3.0f, 4.0f, 4.0f);
 }
 
 // Draw emergency contacts
 void drawEmergencyContacts() {
     if(!showEmergency) return;
+    if(compositeLayer(layerCache, emergencyLayer, renderer, 0, -4.0f, 3.0f, 4.0f, 4.0f)) return;
+    drawMesh(emergencyMesh, renderer);
+    captureLayer(layerCache, emergencyLayer);
+}
 
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(-4.0f, 3.0f);
-    glVertex2f(4.0f, 3.0f);
-    glVertex2f(4.0f, 4.0f);
-    glVertex2f(-4.0f, 4.0f);
-    glEnd();
+// Smallest 1, 2, 2.5, 5 or 10 times a power of ten that is at least value
+float niceChartCeiling(double value) {
+    if(value <= 1.0) return 1.0f;
+    double power = std::pow(10.0, std::floor(std::log10(value)));
+    const double steps[] = {1.0, 2.0, 2.5, 5.0, 10.0};
+    for(double step : steps) {
+        if(step * power >= value) return static_cast<float>(step * power);
+    }
+    return static_cast<float>(10.0 * power);
 }
 
-// Enhanced drawStatistics function
-void drawStatistics() {
-    // Draw background
-    glColor4f(0.2f, 0.2f, 0.2f, 0.8f);
-    glBegin(GL_QUADS);
-    glVertex2f(-4.5f, -4.5f);
-    glVertex2f(4.5f, -4.5f);
-    glVertex2f(4.5f, 4.5f);
-    glVertex2f(-4.5f, 4.5f);
-    glEnd();
-
-    // Draw title
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glRasterPos2f(-1.0f, 4.0f);
-    std::string title = "Dengue Statistics (2018-2023)";
-    for(const char& c : title) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, c);
-    }
-
-    // Draw bars for each year
-    float barWidth = 0.8f;
+// Axis scales, labels and bar vertices of the bar chart, from whatever yearlyStats holds
+void layoutStatistics() {
+    unsigned long long peakCount = 0, peakDeaths = 0;
+    for(const Statistics& stats : yearlyStats) {
+        peakCount = std::max(peakCount, std::max(stats.cases, stats.prevention));
+        peakDeaths = std::max(peakDeaths, stats.deaths);
+    }
+    statsCountScale = niceChartCeiling(static_cast<double>(peakCount));
+    statsDeathScale = niceChartCeiling(static_cast<double>(peakDeaths));
+
+    char text[128];
+    if(yearlyStats.empty()) {
+        snprintf(text, sizeof(text), "Dengue Statistics");
+    } else {
+        snprintf(text, sizeof(text), "Dengue Statistics (%d-%d)", yearlyStats.front().year, yearlyStats.back().year);
+    }
+    statsTitle = text;
+    snprintf(text, sizeof(text), "Full bar: %.0f cases or prevention, %.0f deaths",
+             statsCountScale, statsDeathScale);
+    statsScaleLabel = text;
+
+    // Bars narrow when there are more than six years
+    statsBarSpacing = std::min(1.2f, 6.8f / std::max(1.0f, yearlyStats.size() - 1.0f + 2.0f / 3.0f));
+    statsBarWidth = statsBarSpacing * 2.0f / 3.0f;
+    statsLabelStep = std::max<size_t>(1, static_cast<size_t>(std::ceil(0.8f / statsBarSpacing)));
+}
+
+// Record the Statistics background, yearly bars and chart panels
+void recordStatistics(StaticMesh& mesh) {
+    meshTransform(mesh, 0.0f, 0.0f, 1.0f);
+
+    // Background
+    meshColor(mesh, 0.2f, 0.2f, 0.2f, 0.8f);
+    meshRect(mesh, -4.5f, -4.5f, 4.5f, 4.5f);
+
+    // Cases (red), deaths (dark red) and prevention (green) bars for each year
     float maxHeight = 3.0f;
     float startX = -3.5f;
-    float spacing = 1.2f;
-
     for(size_t i = 0; i < yearlyStats.size(); i++) {
-        float x = startX + i * spacing;
-
-        // Cases bar (red)
-        glColor3f(1.0f, 0.0f, 0.0f);
-        float casesHeight = (yearlyStats[i].cases / 2000.0f) * maxHeight;
-        glBegin(GL_QUADS);
-        glVertex2f(x, -3.0f);
-        glVertex2f(x + barWidth, -3.0f);
-        glVertex2f(x + barWidth, -3.0f + casesHeight);
-        glVertex2f(x, -3.0f + casesHeight);
-        glEnd();
-
-        // Deaths bar (dark red)
-        glColor3f(0.7f, 0.0f, 0.0f);
-        float deathsHeight = (yearlyStats[i].deaths / 30.0f) * maxHeight;
-        glBegin(GL_QUADS);
-        glVertex2f(x + barWidth * 0.25f, -3.0f);
-        glVertex2f(x + barWidth * 0.75f, -3.0f);
-        glVertex2f(x + barWidth * 0.75f, -3.0f + deathsHeight);
-        glVertex2f(x + barWidth * 0.25f, -3.0f + deathsHeight);
-        glEnd();
-
-        // Prevention bar (green)
-        glColor3f(0.0f, 1.0f, 0.0f);
-        float preventionHeight = (yearlyStats[i].prevention / 2000.0f) * maxHeight;
-        glBegin(GL_QUADS);
-        glVertex2f(x + barWidth * 0.5f, -3.0f);
-        glVertex2f(x + barWidth, -3.0f);
-        glVertex2f(x + barWidth, -3.0f + preventionHeight);
-        glVertex2f(x + barWidth * 0.5f, -3.0f + preventionHeight);
-        glEnd();
-
-        // Year label
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glRasterPos2f(x + barWidth * 0.5f - 0.1f, -3.2f);
-        std::string year = std::to_string(yearlyStats[i].year);
-        for(const char& c : year) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, c);
-        }
+        float x = startX + i * statsBarSpacing;
+        float w = statsBarWidth;
+        meshColor(mesh, 1.0f, 0.0f, 0.0f);
+        meshRect(mesh, x, -3.0f, x + w, -3.0f + (yearlyStats[i].cases / statsCountScale) * maxHeight);
+        meshColor(mesh, 0.7f, 0.0f, 0.0f);
+        meshRect(mesh, x + w * 0.25f, -3.0f, x + w * 0.75f,
+                 -3.0f + (yearlyStats[i].deaths / statsDeathScale) * maxHeight);
+        meshColor(mesh, 0.0f, 1.0f, 0.0f);
+        meshRect(mesh, x + w * 0.5f, -3.0f, x + w,
+                 -3.0f + (yearlyStats[i].prevention / statsCountScale) * maxHeight);
+    }
+
+    // Chart panels; the outbreak shares its space with the daily reports of a case file
+    meshColor(mesh, 0.0f, 0.0f, 0.0f, 0.4f);
+    if(caseStore.dayCount > 0) {
+        meshRect(mesh, -4.3f, 1.6f, 4.3f, 2.5f);
+        meshRect(mesh, -4.3f, 0.4f, 4.3f, 1.3f);
+    } else {
+        meshRect(mesh, -4.3f, 0.4f, 4.3f, 2.5f);
     }
 }
 
-// Modify updateMosquitoes function to control population
-void updateMosquitoes() {
-    mosquitoSpawnTimer += 0.016f;
+// Busiest-district envelope over every report row, summarized off the render thread
+void summarizeDistrictEnvelope() {
+    int32_t firstDay = caseStore.dayTotals[0].key;
+    float span = std::max(1, caseStore.dayTotals[caseStore.dayCount - 1].key - firstDay);
+    summarizeChartSeries(districtEnvelopeSeries, 1, caseStore.rows,
+                         [&](size_t i) { return (caseStore.day[i] - firstDay) / span; },
+                         [&](size_t i) { return static_cast<float>(caseStore.cases[i]); });
+    districtEnvelopeReady.store(true, std::memory_order_release);
+}
 
-    // Spawn new mosquitoes if below maximum
-    if(mosquitoSpawnTimer >= mosquitoSpawnInterval && mosquitoes.size() < MAX_MOSQUITOES) {
-        mosquitoSpawnTimer = 0.0f;
-        float x = -4.5f + static_cast<float>(rand()) / RAND_MAX * 9.0f;
-        float y = -2.5f + static_cast<float>(rand()) / RAND_MAX * 7.0f;
-        float speedX = (static_cast<float>(rand()) / RAND_MAX - 0.5f) * mosquitoSpeed;
-        float speedY = (static_cast<float>(rand()) / RAND_MAX - 0.5f) * mosquitoSpeed;
-        mosquitoes.push_back({x, y, speedX, speedY, 0.0f, true});
-    }
-
-    // Update existing mosquitoes
-    for(auto& m : mosquitoes) {
-        if(!m.alive) continue;
-
-        // Update position with smooth movement
-        m.x += m.speedX;
-        m.y += m.speedY;
-        m.wingAngle += 0.1f;
-
-        // Bounce off boundaries with smooth deceleration
-        if(m.x < -4.5f || m.x > 4.5f) {
-            m.speedX = -m.speedX * 0.95f;
-            m.x = m.x < -4.5f ? -4.5f : 4.5f;
-        }
-        if(m.y < -2.5f || m.y > 4.5f) {
-            m.speedY = -m.speedY * 0.95f;
-            m.y = m.y < -2.5f ? -2.5f : 4.5f;
-        }
+void stopCaseSummary() {
+    if(caseSummaryThread.joinable()) caseSummaryThread.join();
+}
+
+// Replace the built-in figures with the yearly totals of a case-report file
+bool loadCaseReports(const char* path) {
+    auto start = std::chrono::steady_clock::now();
+    if(!loadCaseStore(caseStore, path)) return false;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("cases: %zu rows, %zu districts, %zu years from %s in %.1f ms\n", caseStore.rows,
+           caseStore.districtCount, caseStore.yearCount, path, ms);
+    if(caseStore.skippedRows > 0) {
+        fprintf(stderr, "cases: %zu malformed rows were skipped\n", caseStore.skippedRows);
+    }
 
-        // Add slight random movement
-        m.speedX += (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 0.001f;
-        m.speedY += (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 0.001f;
+    yearlyStats.clear();
+    for(size_t i = 0; i < caseStore.yearCount; i++) {
+        const CaseTotals& total = caseStore.yearTotals[i];
+        yearlyStats.push_back({total.key, total.cases, total.deaths, total.prevention});
+    }
 
-        // Limit maximum speed
-        float maxSpeed = mosquitoSpeed * 1.5f;
-        float currentSpeed = sqrt(m.speedX * m.speedX + m.speedY * m.speedY);
-        if(currentSpeed > maxSpeed) {
-            m.speedX = (m.speedX / currentSpeed) * maxSpeed;
-            m.speedY = (m.speedY / currentSpeed) * maxSpeed;
-        }
+    if(caseStore.dayCount > 0) {
+        int32_t firstDay = caseStore.dayTotals[0].key;
+        float span = std::max(1, caseStore.dayTotals[caseStore.dayCount - 1].key - firstDay);
+        summarizeChartSeries(dailyCasesSeries, 1, caseStore.dayCount,
+                             [&](size_t i) { return (caseStore.dayTotals[i].key - firstDay) / span; },
+                             [&](size_t i) { return static_cast<float>(caseStore.dayTotals[i].cases); });
+        caseSummaryThread = std::thread(summarizeDistrictEnvelope);
+        atexit(stopCaseSummary);
+    }
+    return true;
+}
+
+// Map the illustration archive; only its directory is read here. A missing
+// default archive just leaves the illustrations out.
+bool openAssets() {
+    const char* path = assetsPath ? assetsPath : DEFAULT_ASSETS;
+    struct stat info;
+    if(!assetsPath && stat(path, &info) != 0) return true;
+    auto start = std::chrono::steady_clock::now();
+    if(!openAssetArchive(assetLoader.archive, path)) return false;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("assets: %u images, %zu bytes mapped from %s in %.2f ms\n", assetLoader.archive.count,
+           assetLoader.archive.file.size, path, ms);
+    return true;
+}
+
+void stopAssets() {
+    stopAssetLoader(assetLoader);
+}
+
+// Page in the illustrations on the loader thread; needs a current context
+void startAssets() {
+    const char* names[ILLUSTRATION_COUNT];
+    for(size_t i = 0; i < ILLUSTRATION_COUNT; i++) names[i] = ILLUSTRATIONS[i].name;
+    startAssetLoader(assetLoader, names, ILLUSTRATION_COUNT);
+    if(assetsPending(assetLoader)) atexit(stopAssets);
+}
+
+// Illustrations of the current scene, under everything else that moves
+void drawIllustrations() {
+    for(size_t i = 0; i < ILLUSTRATION_COUNT; i++) {
+        const Illustration& art = ILLUSTRATIONS[i];
+        const AssetSlot& slot = assetLoader.slots[i];
+        if(art.scene != simView->scene || slot.state.load(std::memory_order_relaxed) == ASSET_MISSING) continue;
+        GLuint texture = assetTexture(assetLoader, i);
+        queueBegin(drawQueue, LAYER_POSTERS, DRAW_TRIANGLES, true, texture);
+        queueTransform(drawQueue, 0.0f, 0.0f, 1.0f);
+        if(texture) queueColor(drawQueue, 1.0f, 1.0f, 1.0f);
+        else queueColor(drawQueue, slot.placeholder[0], slot.placeholder[1], slot.placeholder[2], slot.placeholder[3]);
+        queueRect(drawQueue, art.left, art.bottom, art.right, art.top);
+    }
+}
+
+// Pixel columns covered by a chart spanning [left, right] in world units
+int chartColumns(float left, float right) {
+    return static_cast<int>((right - left) / 10.0f * viewWidth);
+}
+
+// Queue a chart line; the vertices live in the series until its next layout
+void drawChartLine(const std::vector<float>& verts, float r, float g, float b) {
+    queueArray(drawQueue, LAYER_CHARTS, DRAW_LINE_STRIP, false, verts.data(), verts.size() / 2, r, g, b);
+}
+
+// Enhanced drawStatistics function
+void drawStatistics() {
+    // Draw title below the scene name banner
+    drawText(textAtlas, FONT_HELVETICA_18, -1.0f, 3.2f, statsTitle.c_str(),
+             1.0f, 1.0f, 1.0f);
+    drawText(textAtlas, FONT_HELVETICA_12, -4.3f, -3.6f, statsScaleLabel.c_str(),
+             0.8f, 0.8f, 0.8f);
+
+    // Year labels
+    for(size_t i = 0; i < yearlyStats.size(); i += statsLabelStep) {
+        float x = -3.5f + i * statsBarSpacing;
+        const char* year = arenaPrintf(frameArena, "%d", yearlyStats[i].year);
+        drawText(textAtlas, FONT_HELVETICA_12, x + statsBarWidth * 0.5f - 0.1f, -3.2f, year, 1.0f, 1.0f, 1.0f);
+    }
+
+    // Live outbreak in the simulated city above the yearly bars, sharing
+    // the space with the daily reports of a loaded case file
+    if(caseStore.dayCount > 0) {
+        drawEpidemicChart(1.6f, 2.5f);
+        drawCaseReportChart(0.4f, 1.3f);
+    } else {
+        drawEpidemicChart(0.4f, 2.5f);
+    }
+}
+
+// Daily cases and deaths of the simulated outbreak over the last EPIDEMIC_CHART_DAYS days,
+// each series scaled to its own peak
+void drawEpidemicChart(float bottom, float top) {
+    const std::vector<EpidemicReport>& days = simView->epidemicDays;
+    const float left = -4.3f, right = 4.3f;
+    if(days.empty()) {
+        drawText(textAtlas, FONT_HELVETICA_12, left + 0.1f, top + 0.15f, "Simulated city outbreak: starting",
+                 1.0f, 1.0f, 1.0f);
+        return;
+    }
+
+    // A new day changes the series, the last day number identifies it
+    unsigned long long version = static_cast<unsigned long long>(days.back().day) + 1;
+    const float step = 1.0f / (EPIDEMIC_CHART_DAYS - 1);
+    summarizeChartSeries(epidemicCasesSeries, version, days.size(), [&](size_t i) { return i * step; },
+                         [&](size_t i) { return static_cast<float>(days[i].newCases); });
+    summarizeChartSeries(epidemicDeathsSeries, version, days.size(), [&](size_t i) { return i * step; },
+                         [&](size_t i) { return static_cast<float>(days[i].deaths); });
+    float peakCases = std::max(1.0f, epidemicCasesSeries.peak);
+    float peakDeaths = std::max(1.0f, epidemicDeathsSeries.peak);
+    int columns = chartColumns(left, right);
+
+    drawChartLine(layoutChartSeries(epidemicCasesSeries, columns, chartDecimation, left, bottom, right, top,
+                                    peakCases), 1.0f, 0.3f, 0.3f);
+    drawChartLine(layoutChartSeries(epidemicDeathsSeries, columns, chartDecimation, left, bottom, right, top,
+                                    peakDeaths), 1.0f, 1.0f, 0.0f);
+
+    // Numbers change every day, so they skip the layout cache
+    const EpidemicReport& today = days.back();
+    char line[160];
+    snprintf(line, sizeof(line), "Simulated city, day %d: %llu infectious people, %llu infectious mosquitoes",
+             today.day, today.infectious, today.infectiousMosquitoes);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, left + 0.1f, top + 0.15f, line, 1.0f, 1.0f, 1.0f);
+    snprintf(line, sizeof(line), "Daily cases (peak %.0f)", peakCases);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, left + 0.1f, top - 0.2f, line, 1.0f, 0.3f, 0.3f);
+    snprintf(line, sizeof(line), "Deaths (peak %.0f)", peakDeaths);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, left + 2.2f, top - 0.2f, line, 1.0f, 1.0f, 0.0f);
+}
+
+// Daily cases of the loaded case file: the total over all districts, and
+// the busiest district of each day decimated from every report row
+void drawCaseReportChart(float bottom, float top) {
+    const float left = -4.3f, right = 4.3f;
+    int columns = chartColumns(left, right);
+
+    char line[160];
+    if(districtEnvelopeReady.load(std::memory_order_acquire)) {
+        float peak = std::max(1.0f, districtEnvelopeSeries.peak);
+        drawChartLine(layoutChartSeries(districtEnvelopeSeries, columns, chartDecimation, left, bottom, right,
+                                        top, peak), 0.6f, 0.35f, 0.35f);
+        snprintf(line, sizeof(line), "Single district (peak %.0f)", peak);
+        drawText(textAtlas, FONT_HELVETICA_12, left + 3.6f, top - 0.2f, line, 0.8f, 0.5f, 0.5f);
     }
 
+    float peak = std::max(1.0f, dailyCasesSeries.peak);
+    drawChartLine(layoutChartSeries(dailyCasesSeries, columns, chartDecimation, left, bottom, right, top, peak),
+                  1.0f, 0.3f, 0.3f);
+    snprintf(line, sizeof(line), "Reported daily cases, %zu districts (peak %.0f)", caseStore.districtCount, peak);
+    drawText(textAtlas, FONT_HELVETICA_12, left + 0.1f, top - 0.2f, line, 1.0f, 0.3f, 0.3f);
+}
+
+// Fill the per-mosquito random velocity kicks for the next tick
+void fillMosquitoJitter(float amplitude) {
+    fillRandomBlocks(jitterRandom, mosquitoes.jitterX.data(), mosquitoes.count, -0.5f * amplitude, 0.5f * amplitude);
+    fillRandomBlocks(jitterRandom, mosquitoes.jitterY.data(), mosquitoes.count, -0.5f * amplitude, 0.5f * amplitude);
+}
+
+// Move the swarm one tick, spawning mosquitoes while fewer than limit
+void updateMosquitoes(float deltaTime, int limit) {
+    // Speeds are tuned per 60 Hz frame, scale them to the tick length
+    float step = simClock.stepScale;
+    mosquitoSpawnTimer += deltaTime;
+
+    // Spawn new mosquitoes if below the limit
+    if(mosquitoSpawnTimer >= mosquitoSpawnInterval && mosquitoes.count < static_cast<size_t>(limit)) {
+        mosquitoSpawnTimer = 0.0f;
+        float x = randomRange(spawnRandom, -4.5f, 4.5f);
+        float y = randomRange(spawnRandom, -2.5f, 4.5f);
+        float speedX = randomRange(spawnRandom, -0.5f, 0.5f) * mosquitoSpeed;
+        float speedY = randomRange(spawnRandom, -0.5f, 0.5f) * mosquitoSpeed;
+        addMosquito(mosquitoes, x, y, speedX, speedY);
+    }
+
+    // Slight random movement, scaled by sqrt(step) so the random walk spreads
+    // the same at every tick rate
+    fillMosquitoJitter(0.001f * sqrtf(step));
+
+    // Keep apart, fly with the mosquitoes around and head for people and water
+    if(steeringEnabled) {
+        SteeringParams steering;
+        steering.step = step;
+        steering.neighborRadius = STEERING_RADIUS;
+        steering.separationRadius = 0.2f;
+        steering.maxNeighbors = STEERING_NEIGHBORS;
+        steering.separation = 0.0002f;
+        steering.alignment = 0.02f;
+        steering.cohesion = 0.0005f;
+        steering.seekHost = 0.01f;
+        steering.seekWater = 0.005f;
+        steering.seekRadius = 2.5f;
+        steering.arriveRadius = 0.5f;
+        steering.cruiseSpeed = mosquitoSpeed;
+        steering.maxForce = 0.001f;
+        steering.hosts = activeScene->hosts;
+        steering.hostCount = activeScene->hostCount;
+        steering.breedingSites = activeScene->breedingSites;
+        steering.breedingSiteCount = activeScene->breedingSiteCount;
+        steerSwarm(mosquitoes, steeringGrid, steering, steeringPool);
+    }
+
+    // Integrate, bounce off the boundaries, jitter and limit the speed
+    SwarmStepParams params;
+    params.step = step;
+    params.wingStep = 0.1f * step;
+    params.minX = -4.5f;
+    params.maxX = 4.5f;
+    params.minY = -2.5f;
+    params.maxY = 4.5f;
+    params.bounceDamping = 0.95f;
+    params.maxSpeed = mosquitoSpeed * 1.5f;
+    updateSwarm(mosquitoes, params, swarmKernel);
+
     // Remove dead mosquitoes after animation
     if(mosquitoDeathAnimation) {
-        mosquitoDeathTimer += 0.016f;
+        mosquitoDeathTimer += deltaTime;
         if(mosquitoDeathTimer >= 1.0f) {
             mosquitoDeathAnimation = false;
             mosquitoDeathTimer = 0.0f;
-            mosquitoes.erase(
-                std::remove_if(mosquitoes.begin(), mosquitoes.end(),
-                    [](const Mosquito& m) { return !m.alive; }),
-                mosquitoes.end()
-            );
+            compactSwarm(mosquitoes);
         }
     }
 }
 
+// Draw a mosquito at its position blended between the last two ticks
+void drawMosquitoInterpolated(size_t i) {
+    const MosquitoSwarm& swarm = simView->mosquitoes;
+    drawMosquito(lerpState(swarm.prevX[i], swarm.x[i], renderAlpha),
+                 lerpState(swarm.prevY[i], swarm.y[i], renderAlpha),
+                 0.5f, swarm.wing[i]);
+}
+
+// Renderer shapes of the batched mosquito path and its instances, reused every frame
+static int mosquitoBodyShape, mosquitoWingShape, mosquitoHeadShape;
+static std::vector<float> mosquitoInstances;
+
+// Body line, wings and head of drawMosquito() around its origin, at scale 1;
+// each wing tip is pushed out by the instance's wing span
+void addMosquitoShapes() {
+    const float body[] = {0.0f, 0.0f, 0.0f,  0.0f, 0.5f, 0.0f};
+    const float wings[] = {0.0f, 0.3f, 0.0f,  0.0f, 0.4f, -1.0f,  0.0f, 0.5f, 0.0f,
+                           0.0f, 0.3f, 0.0f,  0.0f, 0.4f, 1.0f,   0.0f, 0.5f, 0.0f};
+    const float head[] = {0.0f, 0.5f, 0.0f};
+    mosquitoBodyShape = addRenderShape(renderer, GL_LINES, body, 2);
+    mosquitoWingShape = addRenderShape(renderer, GL_TRIANGLES, wings, 6);
+    mosquitoHeadShape = addRenderShape(renderer, GL_POINTS, head, 1);
+    uploadRenderShapes(renderer);
+}
+
+// Queue all live mosquitoes as instances of one shape per part: position,
+// scale and wing span, four floats per mosquito. The legacy renderer places
+// the vertices on the CPU where drawMosquito() would; the core one draws
+// each part with one instanced call. Each part has a single color, so it is
+// set once per draw instead of stored per vertex.
+void drawAllMosquitoesBatched() {
+    const MosquitoSwarm& swarm = simView->mosquitoes;
+    const float scale = 0.5f;
+    // Sized for the whole pool, so the array does not grow with the swarm
+    if(mosquitoInstances.size() < swarm.count * RENDER_INSTANCE_STRIDE) {
+        mosquitoInstances.resize(swarm.capacity * RENDER_INSTANCE_STRIDE);
+    }
+    float* instance = mosquitoInstances.data();
+
+    size_t drawn = 0;
+    for(size_t i = 0; i < swarm.count; i++) {
+        if(!isMosquitoAlive(swarm, i)) continue;
+        float wingAngle1 = sin(swarm.wing[i] * mosquitoWingSpeed) * 0.5f;
+        instance[0] = lerpState(swarm.prevX[i], swarm.x[i], renderAlpha);
+        instance[1] = lerpState(swarm.prevY[i], swarm.y[i], renderAlpha);
+        instance[2] = scale;
+        instance[3] = 0.2f * cos(wingAngle1) * scale;
+        instance += RENDER_INSTANCE_STRIDE;
+        drawn++;
+    }
+    if(drawn == 0) return;
+
+    const float* instances = mosquitoInstances.data();
+    queueInstances(drawQueue, LAYER_MOSQUITOES, DRAW_LINES, false, mosquitoBodyShape, instances, drawn,
+                   0.2f, 0.2f, 0.2f);
+    queueInstances(drawQueue, LAYER_MOSQUITOES, DRAW_TRIANGLES, true, mosquitoWingShape, instances, drawn,
+                   0.3f, 0.3f, 0.3f, 0.8f);
+    queueInstances(drawQueue, LAYER_MOSQUITOES, DRAW_POINTS, false, mosquitoHeadShape, instances, drawn,
+                   0.1f, 0.1f, 0.1f, 1.0f, 3.0f);
+}
+
 void drawAllMosquitoes() {
-    for(const auto& m : mosquitoes) {
-        if(m.alive)
-            drawMosquito(m.x, m.y, 0.5f, m.wingAngle);
+    if(batchedMosquitoes) {
+        drawAllMosquitoesBatched();
+        return;
+    }
+    const MosquitoSwarm& swarm = simView->mosquitoes;
+    for(size_t i = 0; i < swarm.count; i++) {
+        if(isMosquitoAlive(swarm, i))
+            drawMosquitoInterpolated(i);
     }
 }
 
@@ -745,44 +1434,22 @@ void updateInfoMessages(float deltaTime) {
     messageTimer += deltaTime;
     if(messageTimer >= MESSAGE_DURATION) {
         messageTimer = 0.0f;
-        // Find current active message
-        for(size_t i = 0; i < infoMessages.size(); ++i) {
-            if(infoMessages[i].active) {
-                infoMessages[i].active = false;
-                // Activate next message
-                if(i + 1 < infoMessages.size()) {
-                    infoMessages[i + 1].active = true;
-                } else {
-                    infoMessages[0].active = true;
-                }
-                break;
-            }
-        }
+        // Activate the next message, wrapping around to the first
+        activeMessage = (activeMessage + 1) % SCENE_MESSAGES;
     }
 }
 
 void drawInfoMessages() {
-    if(!showInfo) return;
-
-    for(const auto& msg : infoMessages) {
-        if(msg.active) {
-            // Draw message background at bottom
-            glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-            glBegin(GL_QUADS);
-            glVertex2f(-4.5f, -4.5f);
-            glVertex2f(4.5f, -4.5f);
-            glVertex2f(4.5f, -3.5f);
-            glVertex2f(-4.5f, -3.5f);
-            glEnd();
-
-            // Draw message text at bottom
-            glColor3f(1.0f, 1.0f, 1.0f);
-            glRasterPos2f(-4.0f, -4.0f);
-            for(const char& c : msg.text) {
-                glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, c);
-            }
-        }
-    }
+    if(!showInfo || !simView->message) return;
+
+    // Draw message background at bottom
+    queueTransform(drawQueue, 0.0f, 0.0f, 1.0f);
+    queueBegin(drawQueue, LAYER_PANELS, DRAW_TRIANGLES, true);
+    queueColor(drawQueue, 0.0f, 0.0f, 0.0f, 0.7f);
+    queueQuad(drawQueue, -4.5f, -4.5f, 4.5f, -4.5f, 4.5f, -3.5f, -4.5f, -3.5f);
+
+    // Draw message text at bottom
+    drawText(textAtlas, FONT_HELVETICA_18, -4.0f, -4.0f, simView->message, 1.0f, 1.0f, 1.0f);
 }
 
 // Automatic scene transition
@@ -790,156 +1457,206 @@ float sceneTimer = 0.0f;
 const float SCENE_DURATION = 15.0f; // seconds per scene
 
 void updateSceneTransition(float deltaTime) {
+    if(!autoSceneTransition) return;
     sceneTimer += deltaTime;
     if(sceneTimer >= SCENE_DURATION) {
         sceneTimer = 0.0f;
-        currentScene = (currentScene + 1) % TOTAL_SCENES;
-        initInfoMessages();
+        enterScene((currentScene + 1) % TOTAL_SCENES);
     }
 }
 
 // Add function to draw water ripple effect
 void drawWaterRipple(float x, float y, float scale, float time) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+    queueTransform(drawQueue, x, y, scale);
+    queueBegin(drawQueue, LAYER_RIPPLES, DRAW_LINES, true);
 
     // Draw multiple ripple circles
     for(int i = 0; i < 3; i++) {
         float radius = 0.1f + (time + i * 0.5f) * 0.2f;
         float alpha = 1.0f - (time + i * 0.5f) * 0.5f;
 
-        glColor4f(0.0f, 0.5f, 1.0f, alpha);
-        glBegin(GL_LINE_LOOP);
-        for(int j = 0; j < 360; j += 10) {
-            float angle = j * 3.14159f / 180.0f;
-            glVertex2f(radius * cos(angle), radius * sin(angle));
+        const CircleLevel& circle = circleForRadius(radius * scale * pixelsPerUnit);
+        queueColor(drawQueue, 0.0f, 0.5f, 1.0f, alpha);
+        for(int j = 0; j < circle.segments; j++) {
+            queueVertex(drawQueue, radius * circle.cosines[j], radius * circle.sines[j]);
+            queueVertex(drawQueue, radius * circle.cosines[j + 1], radius * circle.sines[j + 1]);
         }
-        glEnd();
     }
-    glPopMatrix();
 }
 
 // Add function to draw mosquito life cycle
 void drawMosquitoLifeCycle(float x, float y, float scale, float cycle) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+    queueTransform(drawQueue, x, y, scale);
 
     // Draw different stages based on cycle
     if(cycle < 0.25f) { // Egg stage
-        glColor3f(0.8f, 0.8f, 0.8f);
-        glBegin(GL_POINTS);
+        queueBegin(drawQueue, LAYER_MOSQUITOES, DRAW_POINTS, false, 0, 3.0f);
+        queueColor(drawQueue, 0.8f, 0.8f, 0.8f);
         for(int i = 0; i < 5; i++) {
-            glVertex2f(i * 0.1f - 0.2f, 0.0f);
+            queueVertex(drawQueue, i * 0.1f - 0.2f, 0.0f);
         }
-        glEnd();
     }
     else if(cycle < 0.5f) { // Larva stage
-        glColor3f(0.6f, 0.6f, 0.6f);
-        glBegin(GL_LINES);
-        glVertex2f(-0.2f, 0.0f);
-        glVertex2f(0.2f, 0.0f);
-        glEnd();
+        queueBegin(drawQueue, LAYER_MOSQUITOES, DRAW_LINES, false);
+        queueColor(drawQueue, 0.6f, 0.6f, 0.6f);
+        queueVertex(drawQueue, -0.2f, 0.0f);
+        queueVertex(drawQueue, 0.2f, 0.0f);
     }
     else if(cycle < 0.75f) { // Pupa stage
-        glColor3f(0.4f, 0.4f, 0.4f);
-        glBegin(GL_TRIANGLES);
-        glVertex2f(-0.1f, -0.1f);
-        glVertex2f(0.1f, -0.1f);
-        glVertex2f(0.0f, 0.1f);
-        glEnd();
+        queueBegin(drawQueue, LAYER_MOSQUITOES, DRAW_TRIANGLES, false);
+        queueColor(drawQueue, 0.4f, 0.4f, 0.4f);
+        queueVertex(drawQueue, -0.1f, -0.1f);
+        queueVertex(drawQueue, 0.1f, -0.1f);
+        queueVertex(drawQueue, 0.0f, 0.1f);
     }
     else { // Adult stage
-        drawMosquito(0.0f, 0.0f, 0.5f, cycle * 10.0f);
+        drawMosquito(x, y, 0.5f * scale, cycle * 10.0f);
     }
-    glPopMatrix();
 }
 
-// Add function to draw rain effect
-void drawRain() {
-    if(!isRaining) return;
+// Move the rain one tick, splashing into the current scene's water containers
+void updateRainStorm(float deltaTime) {
+    RainParams params;
+    params.raining = isRaining;
+    params.targetDrops = static_cast<size_t>(rainDrops);
+    params.minX = -5.5f;
+    params.maxX = 4.5f;
+    params.top = 5.0f;
+    params.ground = RAIN_GROUND;
+    params.minSpeed = 6.0f;
+    params.maxSpeed = 8.0f;
+    params.wind = 0.8f;
+    params.groundRippleStride = std::max(1, rainDrops / 16);
+    params.containerRippleStride = std::max(1, rainDrops / 400);
+    updateRain(rain, params, activeScene->splashTargets, activeScene->splashTargetCount, deltaTime, rainRandom,
+               splashRipples);
+    updateRipples(splashRipples, deltaTime);
+}
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureIDs[8]);
+// Request outbreak days as simulated time passes and collect the finished ones
+void updateEpidemic(float deltaTime) {
+    if(!epidemicRunner.thread.joinable()) return;
+    epidemicClock += deltaTime * epidemicDaysPerSecond;
+    while(epidemicClock >= 1.0f) {
+        epidemicClock -= 1.0f;
+        // A simulation thread never waits, days the engine cannot keep up with are skipped
+        if(epidemicLockstep || pendingEpidemicDays(epidemicRunner) < 2) requestEpidemicDay(epidemicRunner);
+    }
+    if(epidemicLockstep) waitForEpidemicDays(epidemicRunner);
 
-    glBegin(GL_QUADS);
-    for(int i = 0; i < 50; i++) {
-        float x = -4.5f + static_cast<float>(rand()) / RAND_MAX * 9.0f;
-        float y = 4.5f - (rainEffect + static_cast<float>(rand()) / RAND_MAX * 2.0f);
+    EpidemicReport report;
+    while(epidemicRunner.reports.pop(report)) {
+        // Drop days the chart no longer shows in place, keeping the capacity
+        if(epidemicHistory.size() == 2 * EPIDEMIC_CHART_DAYS) {
+            epidemicHistory.erase(epidemicHistory.begin(), epidemicHistory.begin() + EPIDEMIC_CHART_DAYS);
+        }
+        epidemicHistory.push_back(report);
+    }
+}
 
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(x, y);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(x + 0.1f, y);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(x + 0.1f, y - 0.2f);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(x, y - 0.2f);
+// Draw ripples left by splashes, flat ellipses on the ground and rings on water
+void drawSplashRipples() {
+    const RipplePool& pool = simView->ripples;
+    const CircleLevel& circle = CIRCLE_LEVELS[0];
+    queueTransform(drawQueue, 0.0f, 0.0f, 1.0f);
+    queueBegin(drawQueue, LAYER_RAIN, DRAW_LINES, true);
+    for(const Ripple& ripple : pool.ripples) {
+        if(ripple.age >= pool.lifetime) continue;
+        float t = ripple.age / pool.lifetime;
+        float radius = 0.05f + t * (ripple.onWater ? 0.2f : 0.12f);
+        float squash = ripple.onWater ? 0.35f : 0.25f;
+        queueColor(drawQueue, 0.0f, 0.5f, 1.0f, 1.0f - t);
+        for(int j = 0; j < circle.segments; j++) {
+            for(int k = j; k <= j + 1; k++) {
+                queueVertex(drawQueue, ripple.x + radius * circle.cosines[k],
+                            ripple.y + radius * squash * circle.sines[k]);
+            }
+        }
     }
-    glEnd();
+}
 
-    glDisable(GL_TEXTURE_2D);
+// Add function to draw rain effect
+void drawRain() {
+    drawSplashRipples();
+    const RainPool& rain = simView->rain;
+    if(rain.count == 0) return;
+
+    // One streak per drop, trailing back along its velocity
+    const float streak = 0.03f;
+    if(rainVerts.size() < rain.count * 4) rainVerts.resize(rain.capacity * 4);
+    float* v = rainVerts.data();
+    for(size_t i = 0; i < rain.count; i++) {
+        float x = lerpState(rain.prevX[i], rain.x[i], renderAlpha);
+        float y = lerpState(rain.prevY[i], rain.y[i], renderAlpha);
+        v[0] = x;
+        v[1] = y;
+        v[2] = x - rain.vx[i] * streak;
+        v[3] = y - rain.vy[i] * streak;
+        v += 4;
+    }
+
+    queueArray(drawQueue, LAYER_RAIN, DRAW_LINES, true, rainVerts.data(), rain.count * 2,
+               0.78f, 0.78f, 1.0f, 0.5f);
 }
 
 // Add function to draw pulse effect
 void drawPulseEffect(float x, float y, float scale) {
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+    queueTransform(drawQueue, x, y, scale);
 
-    float radius = 0.2f + pulseEffect * 0.1f;
-    float alpha = 1.0f - pulseEffect;
+    float radius = 0.2f + simView->pulseEffect * 0.1f;
+    float alpha = 1.0f - simView->pulseEffect;
 
-    glColor4f(1.0f, 0.0f, 0.0f, alpha);
-    glBegin(GL_LINE_LOOP);
-    for(int i = 0; i < 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
-        glVertex2f(radius * cos(angle), radius * sin(angle));
+    const CircleLevel& circle = circleForRadius(radius * scale * pixelsPerUnit);
+    queueBegin(drawQueue, LAYER_EFFECTS, DRAW_LINES, true);
+    queueColor(drawQueue, 1.0f, 0.0f, 0.0f, alpha);
+    for(int i = 0; i < circle.segments; i++) {
+        queueVertex(drawQueue, radius * circle.cosines[i], radius * circle.sines[i]);
+        queueVertex(drawQueue, radius * circle.cosines[i + 1], radius * circle.sines[i + 1]);
     }
-    glEnd();
-    glPopMatrix();
 }
 
 // Add function to draw mosquito kill effect
 void drawMosquitoKillEffect(float x, float y, float scale, float time) {
     if(time > 1.0f) return;
 
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, scale);
+    queueTransform(drawQueue, x, y, scale);
 
     // Draw expanding circle with gradient
     float radius = time * 0.5f;
-    glBegin(GL_TRIANGLE_FAN);
-    glColor4f(1.0f, 0.0f, 0.0f, 1.0f - time);
-    glVertex2f(0.0f, 0.0f);
-    glColor4f(1.0f, 0.0f, 0.0f, 0.0f);
-    for(int i = 0; i <= 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
-        glVertex2f(radius * cos(angle), radius * sin(angle));
+    const CircleLevel& circle = circleForRadius(radius * scale * pixelsPerUnit);
+    queueBegin(drawQueue, LAYER_EFFECTS, DRAW_TRIANGLES, true);
+    for(int i = 0; i < circle.segments; i++) {
+        queueColor(drawQueue, 1.0f, 0.0f, 0.0f, 1.0f - time);
+        queueVertex(drawQueue, 0.0f, 0.0f);
+        queueColor(drawQueue, 1.0f, 0.0f, 0.0f, 0.0f);
+        queueVertex(drawQueue, radius * circle.cosines[i], radius * circle.sines[i]);
+        queueVertex(drawQueue, radius * circle.cosines[i + 1], radius * circle.sines[i + 1]);
     }
-    glEnd();
 
     // Draw X mark with fade
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f - time);
-    glLineWidth(2.0f);
-    glBegin(GL_LINES);
-    glVertex2f(-0.2f, -0.2f);
-    glVertex2f(0.2f, 0.2f);
-    glVertex2f(-0.2f, 0.2f);
-    glVertex2f(0.2f, -0.2f);
-    glEnd();
-
-    glPopMatrix();
+    queueBegin(drawQueue, LAYER_EFFECTS, DRAW_LINES, true, 0, 2.0f);
+    queueColor(drawQueue, 1.0f, 1.0f, 1.0f, 1.0f - time);
+    queueVertex(drawQueue, -0.2f, -0.2f);
+    queueVertex(drawQueue, 0.2f, 0.2f);
+    queueVertex(drawQueue, -0.2f, 0.2f);
+    queueVertex(drawQueue, 0.2f, -0.2f);
 }
 
-// Modify updateAnimations function to include new animations
-void updateAnimations(float deltaTime) {
-    if(!isAnimating) return;
-
-    // Update existing animations
-    updateMosquitoes();
-    updateInfoMessages(deltaTime);
-    updateSceneTransition(deltaTime);
+// Swat animation; the mosquito dies when it ends
+void updateSwat(float deltaTime) {
+    if(!isKillingMosquito) return;
+    killEffectTime += deltaTime * 2.0f;
+    if(killEffectTime > 1.0f) {
+        isKillingMosquito = false;
+        killEffectTime = 0.0f;
+        if(mosquitoToKill >= 0 && static_cast<size_t>(mosquitoToKill) < mosquitoes.count) {
+            killMosquito(mosquitoes, mosquitoToKill);
+        }
+        mosquitoToKill = -1;
+    }
+}
 
-    // Update water level
+void updateWaterLevel(float deltaTime) {
     if(waterRising) {
         waterLevel += 0.01f * deltaTime;
         if(waterLevel > 1.0f) waterRising = false;
@@ -947,35 +1664,430 @@ void updateAnimations(float deltaTime) {
         waterLevel -= 0.01f * deltaTime;
         if(waterLevel < 0.0f) waterRising = true;
     }
+}
 
-    // Update kill effect
-    if(isKillingMosquito) {
-        killEffectTime += deltaTime * 2.0f;
-        if(killEffectTime > 1.0f) {
-            isKillingMosquito = false;
-            killEffectTime = 0.0f;
-            if(mosquitoToKill >= 0 && static_cast<size_t>(mosquitoToKill) < mosquitoes.size()) {
-                mosquitoes[mosquitoToKill].alive = false;
-            }
-            mosquitoToKill = -1;
-        }
-    }
+// Scene update hooks
+void updateLifeCycle(float deltaTime) {
+    mosquitoLifeCycle += 0.1f * deltaTime;
+    if(mosquitoLifeCycle > 1.0f) mosquitoLifeCycle = 0.0f;
+}
 
-    // Update new animations
+void updateRipplePhase(float deltaTime) {
     rippleTime += deltaTime;
     if(rippleTime > 2.0f) rippleTime = 0.0f;
+}
 
-    mosquitoLifeCycle += 0.1f * deltaTime;
-    if(mosquitoLifeCycle > 1.0f) mosquitoLifeCycle = 0.0f;
-
+void updatePulse(float deltaTime) {
     pulseEffect += 0.5f * deltaTime;
     if(pulseEffect > 1.0f) pulseEffect = 0.0f;
+}
+
+// Advance the messages, the scene timer and the systems the scene shown needs
+void updateAnimations(float deltaTime) {
+    if(!isAnimating) return;
+
+    ProfileScope scope(PHASE_UPDATE);
+
+    {
+        ProfileScope infoScope(PHASE_UPDATE_INFO);
+        updateInfoMessages(deltaTime);
+    }
+    {
+        ProfileScope transitionScope(PHASE_UPDATE_TRANSITION);
+        updateSceneTransition(deltaTime);
+    }
+
+    const Scene& scene = SCENES[currentScene];
+    if(scene.systems & SYSTEM_MOSQUITOES) {
+        ProfileScope mosquitoScope(PHASE_UPDATE_MOSQUITOES);
+        updateMosquitoes(deltaTime, scene.mosquitoLimit > 0 ? scene.mosquitoLimit : maxMosquitoes);
+        updateSwat(deltaTime);
+    }
+    if(scene.systems & SYSTEM_WATER) {
+        updateWaterLevel(deltaTime);
+    }
+    if(scene.systems & SYSTEM_PEOPLE) {
+        for(auto& person : people) {
+            person.animationTime += deltaTime;
+        }
+    }
+    if(scene.systems & SYSTEM_RAIN) {
+        ProfileScope rainScope(PHASE_UPDATE_RAIN);
+        updateRainStorm(deltaTime);
+        // Randomly toggle rain, about once per 1000 reference frames
+        if(randomChance(weatherRandom, 0.001f * simClock.stepScale)) isRaining = !isRaining;
+    }
+    if(scene.systems & SYSTEM_EPIDEMIC) {
+        ProfileScope epidemicScope(PHASE_UPDATE_EPIDEMIC);
+        updateEpidemic(deltaTime);
+    }
+    if(scene.update) scene.update(deltaTime);
+}
+
+// Remember the state of the last tick so rendering can interpolate
+void saveSimulationState() {
+    saveSwarmState(mosquitoes);
+    saveRainState(rain);
+    for(auto& person : people) {
+        person.prevAnimationTime = person.animationTime;
+    }
+    prevWaterLevel = waterLevel;
+}
+
+// Copy the first count elements of src. dst grows to all of src when the
+// count outgrows it, so a pool that fills up gradually reallocates it once.
+template<typename T>
+void copyPrefix(std::vector<T>& dst, const std::vector<T>& src, size_t count) {
+    if(dst.size() < count) dst.resize(src.size());
+    std::copy(src.begin(), src.begin() + count, dst.begin());
+}
+
+// Copy what the renderer needs into the back snapshot and hand it over
+void publishSnapshot(double now) {
+    SimSnapshot& snapshot = simSnapshots.writeSlot();
+    snapshot.publishTime = now;
+    snapshot.commandsApplied = simCommandsApplied;
+    snapshot.scene = currentScene;
+    snapshot.animating = isAnimating;
+    snapshot.raining = isRaining;
+    snapshot.killing = isKillingMosquito;
+    snapshot.waterLevel = waterLevel;
+    snapshot.prevWaterLevel = prevWaterLevel;
+    snapshot.rippleTime = rippleTime;
+    snapshot.mosquitoLifeCycle = mosquitoLifeCycle;
+    snapshot.pulseEffect = pulseEffect;
+
+    // Messages point into the scene table, which never changes
+    snapshot.message = SCENES[currentScene].messages[activeMessage];
+
+    MosquitoSwarm& swarm = snapshot.mosquitoes;
+    swarm.count = mosquitoes.count;
+    swarm.capacity = mosquitoes.capacity;
+    copyPrefix(swarm.x, mosquitoes.x, mosquitoes.count);
+    copyPrefix(swarm.y, mosquitoes.y, mosquitoes.count);
+    copyPrefix(swarm.prevX, mosquitoes.prevX, mosquitoes.count);
+    copyPrefix(swarm.prevY, mosquitoes.prevY, mosquitoes.count);
+    copyPrefix(swarm.wing, mosquitoes.wing, mosquitoes.count);
+    copyPrefix(swarm.aliveMask, mosquitoes.aliveMask, mosquitoes.aliveMask.size());
+
+    copyPrefix(snapshot.people, people, people.size());
+    snapshot.people.resize(people.size());
+
+    // Suspended systems are not drawn, so their state is not copied
+    if(sceneNeeds(currentScene, SYSTEM_RAIN)) {
+        RainPool& drops = snapshot.rain;
+        drops.count = rain.count;
+        drops.capacity = rain.capacity;
+        copyPrefix(drops.x, rain.x, rain.count);
+        copyPrefix(drops.y, rain.y, rain.count);
+        copyPrefix(drops.prevX, rain.prevX, rain.count);
+        copyPrefix(drops.prevY, rain.prevY, rain.count);
+        copyPrefix(drops.vx, rain.vx, rain.count);
+        copyPrefix(drops.vy, rain.vy, rain.count);
+
+        copyPrefix(snapshot.ripples.ripples, splashRipples.ripples, splashRipples.ripples.size());
+        snapshot.ripples.next = splashRipples.next;
+        snapshot.ripples.lifetime = splashRipples.lifetime;
+    }
+
+    if(sceneNeeds(currentScene, SYSTEM_EPIDEMIC)) {
+        size_t firstDay = epidemicHistory.size() - std::min(epidemicHistory.size(), EPIDEMIC_CHART_DAYS);
+        snapshot.epidemicDays.assign(epidemicHistory.begin() + firstDay, epidemicHistory.end());
+    }
+
+    simSnapshots.publish();
+}
+
+// Apply one input command to the simulation state
+void applySimCommand(const SimCommand& command) {
+    switch(command.type) {
+        case SIM_SET_SCENE:
+            enterScene(command.scene);
+            rebuildPickGrid();
+            break;
+
+        case SIM_TOGGLE_ANIMATION:
+            isAnimating = !isAnimating;
+            break;
+
+        case SIM_KILL_NEAREST:
+            if(!isKillingMosquito) {
+                swatMosquito(findNearestMosquito(command.x, command.y, VIEW_DIAGONAL));
+            }
+            break;
+
+        case SIM_POINTER_CLICK: {
+            // Select the clicked interactive element, and swat a mosquito under the cursor
+            int element = pickInteractiveElement(command.x, command.y);
+            if(element >= 0) selectedItem = element;
+            swatMosquito(findNearestMosquito(command.x, command.y, SWAT_RADIUS));
+            break;
+        }
+
+        case SIM_POINTER_MOVE: {
+            // Update hover state for interactive elements
+            int hovered = pickInteractiveElement(command.x, command.y);
+            for(size_t i = 0; i < interactiveElements.size(); i++) {
+                interactiveElements[i].isHovered = static_cast<int>(i) == hovered;
+            }
+            break;
+        }
+    }
+    simCommandsApplied++;
+}
+
+// Drain the command queue, returns whether anything was applied
+bool applySimCommands() {
+    SimCommand command;
+    bool applied = false;
+    while(simCommands.pop(command)) {
+        applySimCommand(command);
+        applied = true;
+    }
+    return applied;
+}
+
+// Queue input for the simulation, called from the render thread only
+void sendSimCommand(SimCommandType type, int scene = 0, float x = 0.0f, float y = 0.0f) {
+    SimCommand command = {type, scene, x, y};
+    while(!simCommands.push(command)) {
+        // Full: without a simulation thread nobody else will drain it
+        if(simThread) std::this_thread::yield();
+        else applySimCommands();
+    }
+    simCommandsSent++;
+}
+
+double simNow() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - simEpoch).count();
+}
+
+// One fixed tick, then re-bucket what moved for picking
+void stepSimulation() {
+    saveSimulationState();
+    updateAnimations(simClock.tickDelta);
+    ProfileScope scope(PHASE_UPDATE_PICK_GRID);
+    rebuildPickGrid();
+}
+
+// Simulation thread: apply input, tick at the fixed rate and publish a
+// snapshot whenever something changed, sleeping until the next tick
+void runSimulationThread() {
+    profileThreadId() = 1;
+    std::chrono::steady_clock::duration tick =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(simClock.tickDelta));
+    std::chrono::steady_clock::time_point nextTick = std::chrono::steady_clock::now();
+    while(simRunning.load(std::memory_order_acquire)) {
+        bool changed = applySimCommands();
+        if(isAnimating) {
+            stepSimulation();
+            changed = true;
+        }
+        if(changed) publishSnapshot(simNow());
+
+        // Fell several ticks behind, drop the backlog instead of catching up
+        nextTick += tick;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(nextTick < now - 4 * tick) nextTick = now;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void stopEpidemic() {
+    stopEpidemicRunner(epidemicRunner);
+}
+
+// Build the simulated city and start stepping its outbreak
+void startEpidemic() {
+    if(epidemicParams.humans == 0 || epidemicDaysPerSecond <= 0.0f) return;
+    unsigned workers = epidemicWorkers >= 0 ? static_cast<unsigned>(epidemicWorkers) : defaultWorkerCount();
+    startEpidemicRunner(epidemicRunner, epidemicParams, randomSeed, workers);
+    atexit(stopEpidemic);
+    // Sized once, so collecting days and publishing them never allocates
+    epidemicHistory.reserve(2 * EPIDEMIC_CHART_DAYS);
+    for(SimSnapshot& snapshot : simSnapshots.slots) snapshot.epidemicDays.reserve(EPIDEMIC_CHART_DAYS);
+}
+
+void stopSteering() {
+    stopWorkerPool(steeringPool);
+}
+
+// Steer swarms too big for one block on every core. Before the simulation
+// thread starts, so the pool is stopped after it on exit.
+void startSteering() {
+    if(!steeringEnabled || static_cast<size_t>(maxMosquitoes) <= STEERING_BLOCK) return;
+    startWorkerPool(steeringPool, defaultWorkerCount());
+    atexit(stopSteering);
+}
+
+void stopSimulationThread() {
+    if(!simThread) return;
+    simRunning.store(false, std::memory_order_release);
+    simThread->join();
+    delete simThread;
+    simThread = NULL;
+}
+
+void startSimulationThread() {
+    epidemicLockstep = false;
+    simRunning.store(true, std::memory_order_release);
+    simThread = new std::thread(runSimulationThread);
+    atexit(stopSimulationThread);
+}
 
-    rainEffect += 0.2f * deltaTime;
-    if(rainEffect > 2.0f) rainEffect = 0.0f;
+// Pick up the newest snapshot and the interpolation factor to draw it with.
+// Without a simulation thread, first run as many fixed ticks as the elapsed
+// frame time allows.
+void advanceSimulation(float frameTime) {
+    if(simThread) {
+        simSnapshots.acquireLatest();
+        simView = &simSnapshots.readSlot();
+        // Blend from the previous tick towards the newest as time passes since it was published
+        float alpha = static_cast<float>((simNow() - simView->publishTime) / simClock.tickDelta);
+        renderAlpha = std::max(0.0f, std::min(alpha, 1.0f));
+        return;
+    }
 
-    // Randomly toggle rain
-    if(rand() % 1000 < 1) isRaining = !isRaining;
+    bool changed = applySimCommands();
+    addFrameTime(simClock, frameTime);
+    while(consumeTick(simClock)) {
+        saveSimulationState();
+        updateAnimations(simClock.tickDelta);
+        changed = true;
+    }
+    if(changed) {
+        {
+            ProfileScope scope(PHASE_UPDATE_PICK_GRID);
+            rebuildPickGrid();
+        }
+        publishSnapshot(0.0);
+    }
+    simSnapshots.acquireLatest();
+    simView = &simSnapshots.readSlot();
+    renderAlpha = interpolationAlpha(simClock);
+}
+
+// Draw rolling p50/p95/p99 timings of each frame phase
+void drawProfilerHud() {
+    if(!showUpdates) return;
+
+    // Percentiles are recomputed a few times a second, not every frame
+    static PhaseStats stats[PROFILE_THREAD_COUNT][PHASE_COUNT];
+    static PacingStats pacing;
+    static int rows = 0;
+    static uint64_t lastRefresh = 0;
+    uint64_t now = profileNow();
+    if(lastRefresh == 0 || now - lastRefresh > 250000000ULL) {
+        computePhaseStats(profilerHudBuffers, stats);
+        computePacingStats(framePacer, pacing);
+        lastRefresh = now;
+
+        // One row per thread with samples, then one per phase timed on it
+        rows = 0;
+        for(int t = 0; t < PROFILE_THREAD_COUNT; t++) {
+            int phases = 0;
+            for(int p = 0; p < PHASE_COUNT; p++) phases += stats[t][p].count > 0;
+            if(phases > 0) rows += phases + 1;
+        }
+    }
+
+    float lineSpacing = 0.25f;
+    float top = 3.3f;
+    float bottom = top - (rows + 7) * lineSpacing - 0.1f;
+    queueTransform(drawQueue, 0.0f, 0.0f, 1.0f);
+    queueBegin(drawQueue, LAYER_PANELS, DRAW_TRIANGLES, true);
+    queueColor(drawQueue, 0.0f, 0.0f, 0.0f, 0.7f);
+    queueQuad(drawQueue, -4.9f, bottom, -0.9f, bottom, -0.9f, top, -4.9f, top);
+
+    // One column per percentile, in milliseconds
+    const float columns[3] = {-2.9f, -2.2f, -1.5f};
+    const char* headers[3] = {"p50", "p95", "p99"};
+    float y = top - lineSpacing;
+    drawText(textAtlas, FONT_HELVETICA_12, -4.8f, y, "Frame phase (ms)", 1.0f, 1.0f, 0.0f);
+    for(int c = 0; c < 3; c++) {
+        drawText(textAtlas, FONT_HELVETICA_12, columns[c], y, headers[c], 1.0f, 1.0f, 0.0f);
+    }
+
+    // Timings change every refresh, so they skip the layout cache
+    char value[32];
+    for(int t = 0; t < PROFILE_THREAD_COUNT; t++) {
+        bool heading = false;
+        for(int p = 0; p < PHASE_COUNT; p++) {
+            const PhaseStats& s = stats[t][p];
+            if(s.count == 0) continue;
+            if(!heading) {
+                y -= lineSpacing;
+                drawText(textAtlas, FONT_HELVETICA_12, -4.8f, y, PROFILE_THREAD_NAMES[t], 0.6f, 0.8f, 1.0f);
+                heading = true;
+            }
+            y -= lineSpacing;
+            drawText(textAtlas, FONT_HELVETICA_12, -4.7f, y, PROFILE_PHASE_NAMES[p], 1.0f, 1.0f, 1.0f);
+            const double values[3] = {s.p50, s.p95, s.p99};
+            for(int c = 0; c < 3; c++) {
+                snprintf(value, sizeof(value), "%.2f", values[c]);
+                drawTextUncached(textAtlas, FONT_HELVETICA_12, columns[c], y, value, 1.0f, 1.0f, 1.0f);
+            }
+        }
+    }
+
+    // Achieved frame pacing (windowed only)
+    char line[128];
+    y -= lineSpacing;
+    snprintf(line, sizeof(line), "Pacing jitter %.2f ms, p99 off %.2f ms, %llu missed",
+             pacing.jitterMs, pacing.p99DeviationMs, pacing.missed);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, -4.8f, y, line, 1.0f, 1.0f, 0.0f);
+
+    // Static geometry so far this frame, the HUD is drawn after the scene
+    const MeshStats& meshes = meshStats();
+    y -= lineSpacing;
+    snprintf(line, sizeof(line), "Static vertices: %zu retained, %zu re-submitted",
+             meshes.retainedVertices, meshes.submittedVertices);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, -4.8f, y, line, 1.0f, 1.0f, 0.0f);
+
+    // Layers composited from their textures and drawn again this frame
+    y -= lineSpacing;
+    snprintf(line, sizeof(line), "Layers: %zu cached, %zu redrawn", layerCache.composited, layerCache.redrawn);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, -4.8f, y, line, 1.0f, 1.0f, 0.0f);
+
+    // Queued drawing of the scene and the rain, flushed before the HUD
+    const DrawStats& draws = drawQueue.stats;
+    y -= lineSpacing;
+    snprintf(line, sizeof(line), "Draw queue: %zu submissions, %zu draws, %zu state changes",
+             draws.commands, draws.drawCalls, draws.stateChanges);
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, -4.8f, y, line, 1.0f, 1.0f, 0.0f);
+
+    // Renderer backend and what it streamed so far this frame
+    y -= lineSpacing;
+    if(renderer.backend == RENDER_GL33) {
+        snprintf(line, sizeof(line), "Renderer: gl33, %s stream, %zu KB streamed, %zu instances",
+                 renderer.persistent ? "persistent" : "orphaned", renderer.streamedBytes / 1024,
+                 renderer.instancesDrawn);
+    } else {
+        snprintf(line, sizeof(line), "Renderer: legacy, %zu instances expanded on the CPU",
+                 renderer.instancesDrawn);
+    }
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, -4.8f, y, line, 1.0f, 1.0f, 0.0f);
+
+    // Heap use of the previous frame and the frame arena
+    y -= lineSpacing;
+    if(trackAllocations) {
+        snprintf(line, sizeof(line), "Heap: %llu allocations last frame, arena %zu of %zu bytes",
+                 static_cast<unsigned long long>(lastAllocations.total), frameArena.peak, frameArena.capacity);
+    } else {
+        snprintf(line, sizeof(line), "Heap: not tracked (--track-allocations on), arena %zu of %zu bytes",
+                 frameArena.peak, frameArena.capacity);
+    }
+    drawTextUncached(textAtlas, FONT_HELVETICA_12, -4.8f, y, line, 1.0f, 1.0f, 0.0f);
+}
+
+// Write the profiler ring as a Chrome trace
+void saveTrace(const char* path) {
+    if(writeChromeTrace(path)) {
+        printf("Saved frame trace to %s\n", path);
+    } else {
+        fprintf(stderr, "Cannot write frame trace %s\n", path);
+    }
 }
 
 // Add function to draw options box
@@ -983,16 +2095,12 @@ void drawOptionsBox() {
     if(!showOptions) return;
 
     // Draw options background at top
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(-4.5f, 3.5f);
-    glVertex2f(4.5f, 3.5f);
-    glVertex2f(4.5f, 4.5f);
-    glVertex2f(-4.5f, 4.5f);
-    glEnd();
+    queueTransform(drawQueue, 0.0f, 0.0f, 1.0f);
+    queueBegin(drawQueue, LAYER_PANELS, DRAW_TRIANGLES, true);
+    queueColor(drawQueue, 0.0f, 0.0f, 0.0f, 0.7f);
+    queueQuad(drawQueue, -4.5f, 3.5f, 4.5f, 3.5f, 4.5f, 4.5f, -4.5f, 4.5f);
 
     // Draw options text, each on its own line
-    glColor3f(1.0f, 1.0f, 1.0f);
     float y = 4.3f;
     float lineSpacing = 0.18f;
     const char* options[] = {
@@ -1012,40 +2120,42 @@ void drawOptionsBox() {
         "E/e: Emergency contacts",
         "I/i: Show information",
         "O/o: Show options",
-        "U/u: Show updates"
+        "U/u: Frame profiler",
+        "P/p: Save frame trace"
     };
-    for(int i = 0; i < 17; ++i) {
-        glRasterPos2f(-4.3f, y - i * lineSpacing);
-        const char* str = options[i];
-        while(*str) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *str);
-            ++str;
-        }
+    for(int i = 0; i < static_cast<int>(sizeof(options) / sizeof(options[0])); ++i) {
+        drawText(textAtlas, FONT_HELVETICA_18, -4.3f, y - i * lineSpacing, options[i], 1.0f, 1.0f, 1.0f);
     }
 }
 
-// Draw scene name at the top in the red box
+// Draw scene name at the top in the red box, from its layer unless the scene
+// or the window changed
 void drawSceneNameBox() {
+    if(compositeLayer(layerCache, sceneNameLayer, renderer, simView->scene, -4.5f, 3.5f, 4.5f, 4.5f)) return;
+
     // Draw red background at top
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(-4.5f, 3.5f);
-    glVertex2f(4.5f, 3.5f);
-    glVertex2f(4.5f, 4.5f);
-    glVertex2f(-4.5f, 4.5f);
-    glEnd();
+    const float box[6][RENDER_STRIDE] = {
+        {-4.5f, 3.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}, {4.5f, 3.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+        {4.5f, 4.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}, {-4.5f, 3.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+        {4.5f, 4.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}, {-4.5f, 4.5f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f}
+    };
+    drawRenderVertices(renderer, GL_TRIANGLES, box[0], 6);
 
     // Get current scene name
-    std::string sceneName = SCENE_NAMES.at(currentScene);
+    const char* sceneName = SCENES[simView->scene].name;
 
     // Draw scene name centered
-    glColor3f(1.0f, 1.0f, 1.0f);
-    float nameLength = sceneName.length();
-    float x = -0.15f * nameLength / 2.0f; // Centering adjustment
-    glRasterPos2f(x, 4.0f);
-    for (const char& c : sceneName) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, c);
+    float x = -measureText(textAtlas, FONT_HELVETICA_18, sceneName) / 2.0f;
+    if(!layerCache.enabled) {
+        drawText(textAtlas, FONT_HELVETICA_18, x, 4.0f, sceneName, 1.0f, 1.0f, 1.0f);
+        return;
     }
+
+    // The layer holds the name, so draw it now and leave the text queued so far
+    size_t queued = textAtlas.batch.size();
+    drawText(textAtlas, FONT_HELVETICA_18, x, 4.0f, sceneName, 1.0f, 1.0f, 1.0f);
+    flushTextFrom(textAtlas, renderer, queued);
+    captureLayer(layerCache, sceneNameLayer);
 }
 
 // Add function to initialize people
@@ -1055,169 +2165,323 @@ void initPeople() {
     // Add fighters
     for(int i = 0; i < 3; i++) {
         float x = -3.0f + i * 3.0f;
-        people.push_back({x, 0.0f, 1.0f, true, 1.0f, 0.0f, 0});
+        people.push_back({x, 0.0f, 1.0f, true, 1.0f, 0.0f, 0.0f, 0});
     }
 
     // Add cleaners
     for(int i = 0; i < 2; i++) {
         float x = -2.0f + i * 4.0f;
-        people.push_back({x, -1.0f, 1.0f, true, -1.0f, 0.0f, 1});
+        people.push_back({x, -1.0f, 1.0f, true, -1.0f, 0.0f, 0.0f, 1});
     }
 
     // Add inspectors
     for(int i = 0; i < 2; i++) {
         float x = -3.0f + i * 6.0f;
-        people.push_back({x, 0.0f, 1.0f, true, 1.0f, 0.0f, 2});
+        people.push_back({x, 0.0f, 1.0f, true, 1.0f, 0.0f, 0.0f, 2});
     }
 
     // Add patients
     for(int i = 0; i < 3; i++) {
         float x = -2.0f + i * 2.0f;
-        people.push_back({x, 0.0f, 1.0f, false, 0.0f, 0.0f, 3});
+        people.push_back({x, 0.0f, 1.0f, false, 0.0f, 0.0f, 0.0f, 3});
     }
 }
 
-// Modify display function to include new scene elements
-static void display(void)
+// Record the static geometry of every scene and move it to the GPU. Needs the
+// textures and, for the Statistics scene, layoutStatistics().
+void recordSceneGeometry() {
+    for(StaticMesh& mesh : sceneMeshes) clearMesh(mesh);
+
+    // Mosquito Journey Scene
+    recordHouse(sceneMeshes[0], -3.0f, -2.0f, 1.0f);
+
+    // Clean Environment Scene
+    recordHouse(sceneMeshes[1], -3.0f, 0.0f, 1.0f);
+    recordHouse(sceneMeshes[1], 3.0f, 0.0f, 1.0f);
+    recordWaterContainer(sceneMeshes[1], 0.0f, -2.0f, 1.0f);
+
+    // Stagnant Water Scene
+    recordWaterContainer(sceneMeshes[3], -3.0f, 1.0f, 1.0f);
+    recordWaterContainer(sceneMeshes[3], 0.0f, 1.0f, 1.0f);
+    recordWaterContainer(sceneMeshes[3], 3.0f, 1.0f, 1.0f);
+
+    // Home Inspection Scene
+    recordHouse(sceneMeshes[4], -3.0f, 0.0f, 1.0f);
+    recordWaterContainer(sceneMeshes[4], 3.0f, -2.0f, 1.0f);
+
+    // Prevention Methods Scene
+    recordWaterContainer(sceneMeshes[6], 0.0f, -2.0f, 1.0f);
+
+    // Statistics Scene
+    recordStatistics(sceneMeshes[8]);
+
+    // Toggled props
+    clearMesh(ambulanceMesh);
+    recordAmbulance(ambulanceMesh, -2.0f, 0.0f, 1.0f);
+    clearMesh(emergencyMesh);
+    recordEmergencyContacts(emergencyMesh);
+
+    // Display lists need the fixed-function pipeline, the core backend keeps meshes in buffers
+    MeshPath path = requestedMeshPath;
+    if(path == MESH_LIST && renderer.backend == RENDER_GL33) path = MESH_BUFFER;
+    meshPath = initMeshPath(path);
+    for(StaticMesh& mesh : sceneMeshes) uploadMesh(mesh, meshPath);
+    uploadMesh(ambulanceMesh, meshPath);
+    uploadMesh(emergencyMesh, meshPath);
+}
+
+// Scene draw hooks, queueing what moves
+void drawJourneyScene(float waterLevel) {
+    (void)waterLevel;
+    const MosquitoSwarm& swarm = simView->mosquitoes;
+    for(size_t i = 0; i < swarm.count; i++) {
+        if(isMosquitoAlive(swarm, i)) drawMosquitoInterpolated(i);
+    }
+    drawMosquitoLifeCycle(-3.0f, 2.0f, 1.0f, simView->mosquitoLifeCycle);
+}
+
+// People of one type (0 fighters, 1 cleaners, 2 inspectors, 3 patients)
+void drawPeopleOfType(int type) {
+    for(const auto& person : simView->people) {
+        if(person.type == type) {
+            drawPersonInterpolated(person);
+        }
+    }
+}
+
+void drawCleanEnvironmentScene(float waterLevel) {
+    (void)waterLevel;
+    drawWaterRipple(0.0f, -2.0f, 1.0f, simView->rippleTime);
+    drawPeopleOfType(1);
+}
+
+void drawFighterScene(float waterLevel) {
+    (void)waterLevel;
+    drawPeopleOfType(0);
+    drawAllMosquitoes();
+    drawPulseEffect(0.0f, 0.0f, 1.0f);
+}
+
+void drawStagnantWaterScene(float waterLevel) {
+    drawContainerWater(-3.0f, 1.0f, 1.0f, waterLevel);
+    drawContainerWater(0.0f, 1.0f, 1.0f, waterLevel);
+    drawContainerWater(3.0f, 1.0f, 1.0f, waterLevel);
+    drawWaterRipple(-3.0f, 1.0f, 1.0f, simView->rippleTime);
+    drawWaterRipple(0.0f, 1.0f, 1.0f, simView->rippleTime + 0.5f);
+    drawWaterRipple(3.0f, 1.0f, 1.0f, simView->rippleTime + 1.0f);
+    drawAllMosquitoes();
+    drawPeopleOfType(2);
+}
+
+void drawHomeInspectionScene(float waterLevel) {
+    drawPeopleOfType(2);
+    drawContainerWater(3.0f, -2.0f, 1.0f, waterLevel);
+}
+
+void drawSymptomsScene(float waterLevel) {
+    (void)waterLevel;
+    drawPeopleOfType(3);
+}
+
+void drawPreventionScene(float waterLevel) {
+    (void)waterLevel;
+    drawPerson(-3.0f, 0.0f, 1.0f, true, 1.0f);
+    drawPerson(0.0f, 0.0f, 1.0f, true, 1.0f);
+    drawPerson(3.0f, 0.0f, 1.0f, true, 1.0f);
+}
+
+void drawTreatmentScene(float waterLevel) {
+    (void)waterLevel;
+    if(showAmbulance) drawMesh(ambulanceMesh, renderer);
+    drawPerson(2.0f, 0.0f, 1.5f, false, 1.0f);
+}
+
+void drawStatisticsScene(float waterLevel) {
+    (void)waterLevel;
+    drawStatistics();
+}
+
+// Draw the current scene; the recorded static geometry goes first, then
+// everything that moves
+void drawScene(float drawWaterLevel) {
+    drawMesh(sceneMeshes[simView->scene], renderer);
+    drawIllustrations();
+    if(SCENES[simView->scene].draw) SCENES[simView->scene].draw(drawWaterLevel);
+}
+
+// Drop the transient data of the last frame and start counting allocations
+void beginFrame() {
+    resetFrameArena(frameArena);
+    if(trackAllocations) beginAllocationFrame();
+}
+
+// Collect the allocations of the frame just drawn; frames right after a scene
+// change, resize, day/night switch, HUD toggle or the start of a shower may
+// fill caches, so only settled frames must not allocate
+void endFrame() {
+    if(!trackAllocations) return;
+    bool rainShown = simView->rain.count > 0;
+    if(simView->scene != allocationScene || viewWidth != allocationWidth || viewHeight != allocationHeight ||
+       isDayMode != allocationDayMode || showUpdates != allocationHud || rainShown != allocationRain) {
+        allocationScene = simView->scene;
+        allocationWidth = viewWidth;
+        allocationHeight = viewHeight;
+        allocationDayMode = isDayMode;
+        allocationHud = showUpdates;
+        allocationRain = rainShown;
+        allocationWarmup = ALLOCATION_WARMUP_FRAMES;
+    }
+    bool steady = allocationWarmup == 0;
+    if(allocationWarmup > 0) allocationWarmup--;
+    endAllocationFrame(lastAllocations, steady);
+}
+
+// Advance the simulation by frameTime seconds and draw one frame
+void renderFrame(float frameTime)
 {
-    static float lastTime = 0.0f;
-    float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
-    float deltaTime = currentTime - lastTime;
-    lastTime = currentTime;
+    // The view spans 10 units across the shorter side
+    pixelsPerUnit = std::min(viewWidth, viewHeight) / 10.0f;
+
+    beginTextFrame(textAtlas, -5.0f, 5.0f, -5.0f, 5.0f, viewWidth, viewHeight);
+    beginLayerFrame(layerCache, -5.0f, 5.0f, -5.0f, 5.0f, viewWidth, viewHeight);
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glLoadIdentity();
+    meshStats() = MeshStats();
+    drawQueue.stats = DrawStats();
 
     // Set up orthographic projection for 2D rendering
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(-5.0, 5.0, -5.0, 5.0, -1.0, 1.0);
-    glMatrixMode(GL_MODELVIEW);
+    beginRenderFrame(renderer, -5.0f, 5.0f, -5.0f, 5.0f);
 
     // Draw background
-    drawBackground();
+    {
+        ProfileScope scope(PHASE_BACKGROUND);
+        drawBackground();
+    }
 
-    // Always update animations
-    updateAnimations(deltaTime);
+    // Upload the illustrations paged in since the last frame, a little at a time
+    pumpAssets(assetLoader);
 
-    // Draw current scene with new animations
-    switch(currentScene) {
-        case 0: // Mosquito Journey Scene
-            if (!mosquitoes.empty()) {
-                for (int i = 0; i < std::min(3, (int)mosquitoes.size()); ++i) {
-                    drawMosquito(mosquitoes[i].x, mosquitoes[i].y, 0.5f, mosquitoes[i].wingAngle);
-                }
-            }
-            drawMosquitoLifeCycle(-3.0f, 2.0f, 1.0f, mosquitoLifeCycle);
-            drawHouse(-3.0f, -2.0f, 1.0f);
-            break;
+    // Take the newest simulation snapshot, then draw between its last two ticks
+    advanceSimulation(frameTime);
+    float drawWaterLevel = lerpState(simView->prevWaterLevel, simView->waterLevel, renderAlpha);
 
-        case 1: // Clean Environment Scene
-            drawHouse(-3.0f, 0.0f, 1.0f);
-            drawHouse(3.0f, 0.0f, 1.0f);
-            drawWaterContainer(0.0f, -2.0f, 1.0f, 0.0f);
-            drawWaterRipple(0.0f, -2.0f, 1.0f, rippleTime);
-            // Add cleaners
-            for(const auto& person : people) {
-                if(person.type == 1) {
-                    drawPerson(person.x, person.y, person.scale, person.type, person.animationTime);
-                }
-            }
-            break;
+    {
+        ProfileScope scope(PHASE_SCENE);
+        drawScene(drawWaterLevel);
+    }
 
-        case 2: // Dengue Fighter Scene
-            // Add fighters
-            for(const auto& person : people) {
-                if(person.type == 0) {
-                    drawPerson(person.x, person.y, person.scale, person.type, person.animationTime);
-                }
-            }
-            drawAllMosquitoes();
-            drawPulseEffect(0.0f, 0.0f, 1.0f);
-            break;
+    if(sceneNeeds(simView->scene, SYSTEM_RAIN)) {
+        ProfileScope scope(PHASE_RAIN);
+        drawRain();
+    }
 
-        case 3: // Stagnant Water Scene
-            drawWaterContainer(-3.0f, 1.0f, 1.0f, waterLevel);
-            drawWaterContainer(0.0f, 1.0f, 1.0f, waterLevel);
-            drawWaterContainer(3.0f, 1.0f, 1.0f, waterLevel);
-            drawWaterRipple(-3.0f, 1.0f, 1.0f, rippleTime);
-            drawWaterRipple(0.0f, 1.0f, 1.0f, rippleTime + 0.5f);
-            drawWaterRipple(3.0f, 1.0f, 1.0f, rippleTime + 1.0f);
-            drawAllMosquitoes();
-            // Add inspectors
-            for(const auto& person : people) {
-                if(person.type == 2) {
-                    drawPerson(person.x, person.y, person.scale, person.type, person.animationTime);
-                }
-            }
-            break;
+    // Draw the moving parts queued by the scene and the rain
+    {
+        ProfileScope scope(PHASE_FLUSH);
+        flushDrawQueue(drawQueue, renderer);
+    }
 
-        case 4: // Home Inspection Scene
-            drawHouse(-3.0f, 0.0f, 1.0f);
-            // Add inspectors with spray
-            for(const auto& person : people) {
-                if(person.type == 2) {
-                    drawPerson(person.x, person.y, person.scale, person.type, person.animationTime);
-                }
-            }
-            drawWaterContainer(3.0f, -2.0f, 1.0f, waterLevel);
-            break;
+    {
+        ProfileScope scope(PHASE_TEXT);
 
-        case 5: // Symptoms Scene
-            // Add patients
-            for(const auto& person : people) {
-                if(person.type == 3) {
-                    drawPerson(person.x, person.y, person.scale, person.type, person.animationTime);
-                }
-            }
-            break;
+        // Draw emergency contacts and the scene name box at top; the name is
+        // part of its layer, so the box goes over the emergency banner
+        drawEmergencyContacts();
+        drawSceneNameBox();
 
-        case 6: // Prevention Methods Scene
-            drawPerson(-3.0f, 0.0f, 1.0f, true, 1.0f);
-            drawPerson(0.0f, 0.0f, 1.0f, true, 1.0f);
-            drawPerson(3.0f, 0.0f, 1.0f, true, 1.0f);
-            drawWaterContainer(0.0f, -2.0f, 1.0f, 0.0f);
-            break;
+        // Draw options box if toggled, and info messages
+        drawOptionsBox();
+        drawInfoMessages();
 
-        case 7: // Treatment Options Scene
-            drawAmbulance(-2.0f, 0.0f, 1.0f);
-            drawPerson(2.0f, 0.0f, 1.5f, false, 1.0f);
-            break;
+        // Draw frame timings if toggled
+        drawProfilerHud();
 
-        case 8: // Statistics Scene
-            drawStatistics();
-            break;
+        // Draw the boxes, then all text queued this frame over them
+        flushDrawQueue(drawQueue, renderer);
+        flushText(textAtlas, renderer);
+    }
+    endRenderFrame(renderer);
+}
+// Whether anything on screen moves without input
+PacingMode currentPacingMode() {
+    // Keep redrawing until the simulation has caught up with the input sent to it
+    if(simView->commandsApplied < simCommandsSent) return PACING_CONTINUOUS;
+    // Keep drawing until the illustrations have replaced their placeholders
+    if(assetsPending(assetLoader)) return PACING_CONTINUOUS;
+    if(!simView->animating) return PACING_EVENT;
+    if(simView->killing || showUpdates) return PACING_CONTINUOUS;
+    int scene = simView->scene;
+    if(sceneNeeds(scene, SYSTEM_RAIN) &&
+       (simView->raining || simView->rain.count > 0 || hasLiveRipples(simView->ripples))) {
+        return PACING_CONTINUOUS;
     }
+    // The outbreak chart moves while the epidemic runs
+    if(sceneNeeds(scene, SYSTEM_EPIDEMIC) && epidemicRunner.thread.joinable()) return PACING_CONTINUOUS;
+    return SCENES[scene].pacing;
+}
 
-    // Draw rain effect
-    drawRain();
+static void frameTimer(int value)
+{
+    (void)value;
+    frameTimerPending = false;
+    glutPostRedisplay();
+}
 
-    // Draw scene name box at top
-    drawSceneNameBox();
+// Modify display function to include new scene elements
+static void display(void)
+{
+    float frameTime = beginPacedFrame(framePacer);
+    beginFrame();
 
-    // Draw options box if toggled
-    drawOptionsBox();
+    {
+        ProfileScope scope(PHASE_FRAME);
+        renderFrame(frameTime);
+        {
+            ProfileScope swapScope(PHASE_SWAP);
+            glutSwapBuffers();
+        }
+    }
+    endFrame();
+
+    // Sleep until the next deadline instead of redrawing immediately; with
+    // nothing animating, wait for input to post the next redisplay
+    setPacingMode(framePacer, currentPacingMode());
+    int delay = scheduleNextFrame(framePacer);
+    if(delay >= 0 && !frameTimerPending) {
+        frameTimerPending = true;
+        glutTimerFunc(delay, frameTimer, 0);
+    }
+}
 
-    // Draw emergency contacts and info messages
-    drawEmergencyContacts();
-    drawInfoMessages();
+// Print how closely frames kept to the target rate
+void reportPacing() {
+    PacingStats stats;
+    computePacingStats(framePacer, stats);
+    if(stats.frames == 0) return;
+    fprintf(stderr, "Frame pacing: target %.0f Hz, interval %.2f ms, jitter %.2f ms, p99 deviation %.2f ms, "
+                    "%llu missed deadlines\n",
+            framePacer.targetRate, stats.meanMs, stats.jitterMs, stats.p99DeviationMs, stats.missed);
+}
 
-    // Force continuous redisplay
-    glutPostRedisplay();
-    glutSwapBuffers();
+static void resize(int width, int height)
+{
+    viewWidth = std::max(width, 1);
+    viewHeight = std::max(height, 1);
+    glViewport(0, 0, viewWidth, viewHeight);
 }
 
-static void key(unsigned char key, int x, int y)
+// Apply a keyboard command, shared by the GLUT callback and the benchmark script
+void handleKey(unsigned char key)
 {
     switch (key)
     {
         case '1': case '2': case '3': case '4': case '5':
         case '6': case '7': case '8': case '9':
-            currentScene = key - '1';
+            sendSimCommand(SIM_SET_SCENE, key - '1');
             break;
 
         case 'm': case 'M':
-            isAnimating = !isAnimating;
+            sendSimCommand(SIM_TOGGLE_ANIMATION);
             break;
 
         case 'n': case 'N':
@@ -1225,18 +2489,8 @@ static void key(unsigned char key, int x, int y)
             break;
 
         case 'd': case 'D':
-            if(!isKillingMosquito) {
-                // Find next alive mosquito
-                for(size_t i = 0; i < mosquitoes.size(); i++) {
-                    if(mosquitoes[i].alive) {
-                        mosquitoToKill = i;
-                        isKillingMosquito = true;
-                        killEffectTime = 0.0f;
-                        killedMosquitoes++;
-                        break;
-                    }
-                }
-            }
+            // Kill the alive mosquito nearest the cursor
+            sendSimCommand(SIM_KILL_NEAREST, 0, cursorX, cursorY);
             break;
 
         case 'a': case 'A':
@@ -1259,68 +2513,425 @@ static void key(unsigned char key, int x, int y)
             showUpdates = !showUpdates;
             break;
 
+        case 'b': case 'B':
+            batchedMosquitoes = !batchedMosquitoes;
+            break;
+
+        case 'p': case 'P':
+            saveTrace(traceOutput ? traceOutput : DEFAULT_TRACE_OUTPUT);
+            break;
+
         case 27: // ESC
+            if(traceOutput) saveTrace(traceOutput);
             exit(0);
             break;
     }
+}
+
+// Convert window coordinates to OpenGL coordinates
+void windowToWorld(int x, int y, float& worldX, float& worldY) {
+    worldX = (x / (float)viewWidth) * 10.0f - 5.0f;
+    worldY = 5.0f - (y / (float)viewHeight) * 10.0f;
+}
 
+static void key(unsigned char key, int x, int y)
+{
+    windowToWorld(x, y, cursorX, cursorY);
+    handleKey(key);
     glutPostRedisplay();
 }
 
 static void mouse(int button, int state, int x, int y)
 {
-    // Convert window coordinates to OpenGL coordinates
-    float glX = (x / (float)glutGet(GLUT_WINDOW_WIDTH)) * 10.0f - 5.0f;
-    float glY = 5.0f - (y / (float)glutGet(GLUT_WINDOW_HEIGHT)) * 10.0f;
+    windowToWorld(x, y, cursorX, cursorY);
 
     if(button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
-        // Check if any interactive element was clicked
-        for(size_t i = 0; i < interactiveElements.size(); i++) {
-            if(isPointInside(glX, glY, interactiveElements[i])) {
-                selectedItem = i;
-                break;
-            }
-        }
+        sendSimCommand(SIM_POINTER_CLICK, 0, cursorX, cursorY);
+        glutPostRedisplay();
     }
 }
 
 static void motion(int x, int y)
 {
-    // Convert window coordinates to OpenGL coordinates
-    float glX = (x / (float)glutGet(GLUT_WINDOW_WIDTH)) * 10.0f - 5.0f;
-    float glY = 5.0f - (y / (float)glutGet(GLUT_WINDOW_HEIGHT)) * 10.0f;
+    windowToWorld(x, y, cursorX, cursorY);
+    sendSimCommand(SIM_POINTER_MOVE, 0, cursorX, cursorY);
+}
 
-    // Update hover state for interactive elements
-    for(auto& element : interactiveElements) {
-        element.isHovered = isPointInside(glX, glY, element);
+// Parse command line options left over after glutInit
+void parseOptions(int argc, char *argv[]) {
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = atoi(argv[++i]);
+            if(!isSupportedTickRate(tickRate)) {
+                fprintf(stderr, "Unsupported tick rate %d, use 60, 120 or 240\n", tickRate);
+                tickRate = DEFAULT_TICK_RATE;
+            }
+        } else if(strcmp(argv[i], "--mosquitoes") == 0 && i + 1 < argc) {
+            initialMosquitoes = std::max(0, atoi(argv[++i]));
+            maxMosquitoes = std::max(MAX_MOSQUITOES, initialMosquitoes);
+        } else if(strcmp(argv[i], "--swarm-kernel") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if(strcmp(name, "scalar") == 0) swarmKernel = SWARM_KERNEL_SCALAR;
+            else if(strcmp(name, "sse2") == 0) swarmKernel = SWARM_KERNEL_SSE2;
+            else if(strcmp(name, "avx2") == 0) swarmKernel = SWARM_KERNEL_AVX2;
+        } else if(strcmp(argv[i], "--mosquito-renderer") == 0 && i + 1 < argc) {
+            batchedMosquitoes = strcmp(argv[++i], "immediate") != 0;
+        } else if(strcmp(argv[i], "--headless") == 0) {
+            headlessMode = true;
+        } else if(strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if(sscanf(argv[++i], "%dx%d", &viewWidth, &viewHeight) != 2 || viewWidth <= 0 || viewHeight <= 0) {
+                fprintf(stderr, "Invalid size %s, use WIDTHxHEIGHT\n", argv[i]);
+                viewWidth = 800;
+                viewHeight = 600;
+            }
+        } else if(strcmp(argv[i], "--scenes") == 0 && i + 1 < argc) {
+            // Scenes are numbered 1-9 as on the keyboard
+            int first = 1, last = TOTAL_SCENES;
+            if(sscanf(argv[++i], "%d-%d", &first, &last) == 1) last = first;
+            headlessFirstScene = std::max(1, std::min(first, TOTAL_SCENES)) - 1;
+            headlessLastScene = std::max(headlessFirstScene + 1, std::min(last, TOTAL_SCENES)) - 1;
+        } else if(strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headlessFramesPerScene = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            headlessFrameRate = std::max(1.0f, static_cast<float>(atof(argv[++i])));
+        } else if(strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            headlessOutput = argv[++i];
+        } else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceOutput = argv[++i];
+        } else if(strcmp(argv[i], "--target-fps") == 0 && i + 1 < argc) {
+            targetFrameRate = std::max(0.0f, static_cast<float>(atof(argv[++i])));
+        } else if(strcmp(argv[i], "--idle-fps") == 0 && i + 1 < argc) {
+            // Below 4 fps the simulation clock would drop time between frames
+            idleFrameRate = std::max(4.0f, static_cast<float>(atof(argv[++i])));
+        } else if(strcmp(argv[i], "--swap-interval") == 0 && i + 1 < argc) {
+            swapInterval = std::max(0, atoi(argv[++i]));
+        } else if(strcmp(argv[i], "--rain-drops") == 0 && i + 1 < argc) {
+            rainDrops = std::max(0, atoi(argv[++i]));
+        } else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            randomSeed = strtoull(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--sim-thread") == 0 && i + 1 < argc) {
+            useSimThread = strcmp(argv[++i], "off") != 0;
+        } else if(strcmp(argv[i], "--epi-humans") == 0 && i + 1 < argc) {
+            epidemicParams.humans = strtoull(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--epi-mosquitoes") == 0 && i + 1 < argc) {
+            epidemicParams.mosquitoes = strtoull(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--epi-threads") == 0 && i + 1 < argc) {
+            // Total threads stepping the epidemic, the runner included
+            epidemicWorkers = std::max(1, atoi(argv[++i])) - 1;
+        } else if(strcmp(argv[i], "--epi-days-per-second") == 0 && i + 1 < argc) {
+            epidemicDaysPerSecond = std::max(0.0f, static_cast<float>(atof(argv[++i])));
+        } else if(strcmp(argv[i], "--cases") == 0 && i + 1 < argc) {
+            casesPath = argv[++i];
+        } else if(strcmp(argv[i], "--assets") == 0 && i + 1 < argc) {
+            assetsPath = argv[++i];
+        } else if(strcmp(argv[i], "--track-allocations") == 0 && i + 1 < argc) {
+            trackAllocations = strcmp(argv[++i], "off") != 0;
+        } else if(strcmp(argv[i], "--retained") == 0 && i + 1 < argc) {
+            const char* path = argv[++i];
+            requestedMeshPath = strcmp(path, "off") == 0 ? MESH_CLIENT
+                              : strcmp(path, "lists") == 0 ? MESH_LIST : MESH_BUFFER;
+        } else if(strcmp(argv[i], "--renderer") == 0 && i + 1 < argc) {
+            requestedRenderBackend = strcmp(argv[++i], "gl33") == 0 ? RENDER_GL33 : RENDER_LEGACY;
+        } else if(strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            persistentStream = strcmp(argv[++i], "orphan") != 0;
+        } else if(strcmp(argv[i], "--steering") == 0 && i + 1 < argc) {
+            steeringEnabled = strcmp(argv[++i], "off") != 0;
+        } else if(strcmp(argv[i], "--sort-draws") == 0 && i + 1 < argc) {
+            drawQueue.sorted = strcmp(argv[++i], "off") != 0;
+        } else if(strcmp(argv[i], "--layer-cache") == 0 && i + 1 < argc) {
+            layerCache.enabled = strcmp(argv[++i], "off") != 0;
+        } else if(strcmp(argv[i], "--chart-decimation") == 0 && i + 1 < argc) {
+            chartDecimation = strcmp(argv[++i], "lttb") == 0 ? CHART_LTTB : CHART_MINMAX;
+        } else if(strcmp(argv[i], "--bench") == 0) {
+            benchMode = true;
+        } else if(strcmp(argv[i], "--bench-out") == 0 && i + 1 < argc) {
+            benchOutput = argv[++i];
+        } else if(strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            benchBaseline = argv[++i];
+        } else if(strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            benchThreshold = std::max(0.0f, static_cast<float>(atof(argv[++i])));
+        }
     }
 }
 
+// Lay out the scene names and info messages up front; messages rotate in long
+// after a scene has settled, and laying one out fills the text cache
+void layoutSceneText() {
+    for(int scene = 0; scene < TOTAL_SCENES; scene++) {
+        layoutText(textAtlas, FONT_HELVETICA_18, SCENES[scene].name);
+        for(int m = 0; m < SCENE_MESSAGES; m++) {
+            layoutText(textAtlas, FONT_HELVETICA_18, SCENES[scene].messages[m]);
+        }
+    }
+}
+
+// OpenGL state shared by the windowed and headless paths
+void initGLState() {
+    initRenderer(renderer, requestedRenderBackend, persistentStream);
+    buildTextAtlas(textAtlas, renderer);
+    layoutSceneText();
+    addMosquitoShapes();
+    initTextures();
+    recordSceneGeometry();
+    startAssets();
+
+    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+#ifdef DENGUE_HAS_HEADLESS
+// Render the chosen scene range offscreen on a virtual clock, optionally
+// writing every frame as a numbered PPM image
+int runHeadless() {
+    HeadlessContext context = {};
+    if(!createHeadlessContext(context, viewWidth, viewHeight, requestedRenderBackend == RENDER_GL33)) {
+        return EXIT_FAILURE;
+    }
+    initGLState();
+    // Frames must not depend on how fast the illustrations load
+    finishAssets(assetLoader);
+    startAutomaticDisplay();
+
+    // Scenes are switched here, not by the scene timer
+    autoSceneTransition = false;
+    VirtualClock clock;
+    initVirtualClock(clock, headlessFrameRate);
+    int framesPerScene = headlessFramesPerScene > 0 ? headlessFramesPerScene
+                                                    : static_cast<int>(SCENE_DURATION * headlessFrameRate);
+
+    char path[1024];
+    int frameNumber = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int scene = headlessFirstScene; scene <= headlessLastScene; scene++) {
+        sendSimCommand(SIM_SET_SCENE, scene);
+        for(int frame = 0; frame < framesPerScene; frame++) {
+            beginFrame();
+            {
+                ProfileScope scope(PHASE_FRAME);
+                renderFrame(tickVirtualClock(clock));
+            }
+            endFrame();
+            if(headlessOutput) {
+                snprintf(path, sizeof(path), "%s%05d.ppm", headlessOutput, frameNumber);
+                if(!writeFramePPM(context, path)) {
+                    fprintf(stderr, "headless: cannot write %s\n", path);
+                    destroyHeadlessContext(context);
+                    return EXIT_FAILURE;
+                }
+            }
+            frameNumber++;
+        }
+    }
+    glFinish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Rendered %d frames (%.1f s of scene time) in %.2f s, %.1f frames/s\n",
+           frameNumber, clock.now, seconds, seconds > 0.0 ? frameNumber / seconds : 0.0);
+    if(traceOutput) saveTrace(traceOutput);
+    destroyHeadlessContext(context);
+    return EXIT_SUCCESS;
+}
+
+// Keys pressed during each benchmarked scene, at a fraction of the scene length
+struct BenchInput {
+    float at;
+    unsigned char key;
+};
+
+static const BenchInput BENCH_SCRIPT[] = {
+    {0.10f, 'd'},
+    {0.25f, 'n'},
+    {0.40f, 'd'},
+    {0.55f, 'd'},
+    {0.75f, 'n'},
+    {0.90f, 'd'}
+};
+
+// Time one scene with the scripted input; frameMs is reused between scenes
+SceneBenchResult benchScene(VirtualClock& clock, int scene, int framesPerScene, std::vector<double>& frameMs) {
+    size_t scriptLength = sizeof(BENCH_SCRIPT) / sizeof(BENCH_SCRIPT[0]);
+    sendSimCommand(SIM_SET_SCENE, scene);
+    frameMs.clear();
+    resetPeakRss();
+
+    size_t nextInput = 0;
+    double retainedVertices = 0.0, submittedVertices = 0.0;
+    double drawCalls = 0.0, stateChanges = 0.0, allocations = 0.0;
+    for(int frame = 0; frame < framesPerScene; frame++) {
+        while(nextInput < scriptLength &&
+              frame >= static_cast<int>(BENCH_SCRIPT[nextInput].at * framesPerScene)) {
+            handleKey(BENCH_SCRIPT[nextInput++].key);
+        }
+
+        // Wait for the frame to finish rendering so GPU time is included
+        auto start = std::chrono::steady_clock::now();
+        beginFrame();
+        {
+            ProfileScope scope(PHASE_FRAME);
+            renderFrame(tickVirtualClock(clock));
+            glFinish();
+        }
+        endFrame();
+        auto end = std::chrono::steady_clock::now();
+        frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        retainedVertices += meshStats().retainedVertices;
+        submittedVertices += meshStats().submittedVertices;
+        drawCalls += drawQueue.stats.drawCalls;
+        stateChanges += drawQueue.stats.stateChanges;
+        allocations += lastAllocations.total;
+    }
+    SceneBenchResult result = summarizeScene(scene + 1, SCENES[scene].name, frameMs, readPeakRssKb());
+    result.retainedVertices = retainedVertices / std::max(framesPerScene, 1);
+    result.submittedVertices = submittedVertices / std::max(framesPerScene, 1);
+    result.drawCalls = drawCalls / std::max(framesPerScene, 1);
+    result.stateChanges = stateChanges / std::max(framesPerScene, 1);
+    result.allocations = allocations / std::max(framesPerScene, 1);
+    return result;
+}
+
+// Run every scene offscreen with a fixed seed and scripted input, report frame
+// times and peak RSS per scene as JSON and optionally compare with a baseline
+int runBenchmark() {
+    HeadlessContext context = {};
+    if(!createHeadlessContext(context, viewWidth, viewHeight, requestedRenderBackend == RENDER_GL33)) {
+        return EXIT_FAILURE;
+    }
+    seedRandomStreams();
+    initGLState();
+    finishAssets(assetLoader);
+    startAutomaticDisplay();
+    autoSceneTransition = false;
+
+    VirtualClock clock;
+    initVirtualClock(clock, headlessFrameRate);
+    int framesPerScene = headlessFramesPerScene > 0 ? headlessFramesPerScene
+                                                    : static_cast<int>(SCENE_DURATION * headlessFrameRate);
+
+    // Warm up caches (text atlas, first-use allocations) before measuring
+    for(int frame = 0; frame < BENCH_WARMUP_FRAMES; frame++) {
+        beginFrame();
+        renderFrame(tickVirtualClock(clock));
+        endFrame();
+    }
+    glFinish();
+
+    std::vector<SceneBenchResult> results;
+    std::vector<double> frameMs;
+    frameMs.reserve(framesPerScene);
+    for(int scene = headlessFirstScene; scene <= headlessLastScene; scene++) {
+        results.push_back(benchScene(clock, scene, framesPerScene, frameMs));
+        fprintf(stderr, "scene %d: %.1f frames/s, p95 %.3f ms\n", scene + 1,
+                results.back().framesPerSecond, results.back().p95Ms);
+    }
+
+    // The last scene again with the profiler HUD open, so its refreshes are
+    // timed and checked for allocations; reported as scene 10
+    showUpdates = true;
+    results.push_back(benchScene(clock, headlessLastScene, framesPerScene, frameMs));
+    results.back().scene = TOTAL_SCENES + 1;
+    results.back().name = std::string(SCENES[headlessLastScene].name) + " with profiler HUD";
+    showUpdates = false;
+    fprintf(stderr, "profiler HUD: %.1f frames/s, p95 %.3f ms\n",
+            results.back().framesPerSecond, results.back().p95Ms);
+
+    destroyHeadlessContext(context);
+    if(traceOutput) saveTrace(traceOutput);
+
+    FILE* file = benchOutput ? fopen(benchOutput, "w") : stdout;
+    if(!file) {
+        fprintf(stderr, "bench: cannot write %s\n", benchOutput);
+        return EXIT_FAILURE;
+    }
+    writeBenchJson(file, results, viewWidth, viewHeight, initialMosquitoes, randomSeed,
+                   renderBackendName(renderer.backend));
+    if(file != stdout) fclose(file);
+
+    if(benchBaseline) {
+        std::vector<SceneBenchResult> baseline;
+        if(!readBenchBaseline(benchBaseline, baseline)) {
+            fprintf(stderr, "bench: cannot read baseline %s\n", benchBaseline);
+            return EXIT_FAILURE;
+        }
+        if(!compareWithBaseline(results, baseline, benchThreshold)) {
+            fprintf(stderr, "bench: frame times regressed by more than %.1f%%\n", benchThreshold);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+#endif
+
 // Modify main function to initialize textures
 int main(int argc, char *argv[])
 {
+    parseOptions(argc, argv);
+    initFrameArena(frameArena, FRAME_ARENA_SIZE);
+    initPhaseStatsBuffers(profilerHudBuffers, PROFILER_HUD_WINDOW);
+    // The benchmark reports allocations per frame
+    if(benchMode) trackAllocations = true;
+    allocationTracker().enabled.store(trackAllocations);
+    // Only frames are checked, so only the thread that draws them is counted
+    allocationTrackedThread() = true;
+    initSimClock(simClock, tickRate);
+    seedRandomStreams();
+    swarmKernel = resolveSwarmKernel(swarmKernel);
+    if(casesPath && !loadCaseReports(casesPath)) {
+        return EXIT_FAILURE;
+    }
+    if(!openAssets()) return EXIT_FAILURE;
+    layoutStatistics();
+    startEpidemic();
+    startSteering();
+
+    if(headlessMode || benchMode) {
+#ifdef DENGUE_HAS_HEADLESS
+        // Offscreen runs need no window system, the fonts are embedded
+        return benchMode ? runBenchmark() : runHeadless();
+#else
+        fprintf(stderr, "Headless rendering and benchmarks are only available on Linux\n");
+        return EXIT_FAILURE;
+#endif
+    }
+
     glutInit(&argc, argv);
-    glutInitWindowSize(800, 600);
+    glutInitWindowSize(viewWidth, viewHeight);
     glutInitWindowPosition(10, 10);
     glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
+    if(requestedRenderBackend == RENDER_GL33) {
+#ifdef GLUT_CORE_PROFILE
+        // Ask for the same 3.3 core context the headless runs use
+        glutInitContextVersion(3, 3);
+        glutInitContextProfile(GLUT_CORE_PROFILE);
+#else
+        fprintf(stderr, "This GLUT cannot ask for a core context, so gl33 runs in a compatibility context\n");
+#endif
+    }
 
     glutCreateWindow("Interactive Dengue Awareness");
 
     // Initialize textures
-    initTextures();
+    initGLState();
+
+    // Pace frames with a timer, optionally with vsync on or off
+    initFramePacer(framePacer, targetFrameRate, idleFrameRate);
+    if(swapInterval >= 0 && !setSwapInterval(swapInterval)) {
+        fprintf(stderr, "Swap interval control is not supported by this driver\n");
+    }
+    atexit(reportPacing);
 
     glutDisplayFunc(display);
+    glutReshapeFunc(resize);
     glutKeyboardFunc(key);
     glutMouseFunc(mouse);
     glutMotionFunc(motion);
 
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
     // Start automatic display
     startAutomaticDisplay();
 
+    // Simulate on its own thread, input reaches it through the command queue
+    if(useSimThread) startSimulationThread();
+
     glutMainLoop();
     return EXIT_SUCCESS;
 }
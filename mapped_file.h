@@ -0,0 +1,82 @@
+/*
+ * Memory-mapped files
+ * Read-only mappings of whole files, so large data files are used in place
+ * and paged in on demand instead of being read into buffers.
+ */
+
+#ifndef DENGUE_MAPPED_FILE_H
+#define DENGUE_MAPPED_FILE_H
+
+#include <stddef.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Read-only view of a whole file
+struct MappedFile {
+    const char* data;
+    size_t size;
+};
+
+inline bool mapFile(MappedFile& map, const char* path) {
+    map.data = NULL;
+    map.size = 0;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    map.size = static_cast<size_t>(size.QuadPart);
+    if(map.size > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(mapping) {
+            map.data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return false;
+    struct stat info;
+    if(fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    map.size = static_cast<size_t>(info.st_size);
+    if(map.size > 0) {
+        void* data = mmap(NULL, map.size, PROT_READ, MAP_SHARED, fd, 0);
+        map.data = data == MAP_FAILED ? NULL : static_cast<const char*>(data);
+    }
+    close(fd); // The mapping keeps the file open
+#endif
+    if(map.size > 0 && !map.data) {
+        map.size = 0;
+        return false;
+    }
+    return true;
+}
+
+inline void unmapFile(MappedFile& map) {
+    if(map.data) {
+#if defined(_WIN32)
+        UnmapViewOfFile(map.data);
+#else
+        munmap(const_cast<char*>(map.data), map.size);
+#endif
+    }
+    map.data = NULL;
+    map.size = 0;
+}
+
+#endif
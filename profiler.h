@@ -0,0 +1,235 @@
+/*
+ * Per-phase frame profiler
+ * Scoped timers record how long each phase of a frame takes into a lock-free
+ * ring buffer. The ring is read for rolling percentiles (the on-screen HUD) and
+ * can be dumped as Chrome trace_event JSON for chrome://tracing or Perfetto.
+ */
+
+#ifndef DENGUE_PROFILER_H
+#define DENGUE_PROFILER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+enum ProfilePhase {
+    PHASE_FRAME = 0,
+    PHASE_BACKGROUND,
+    PHASE_UPDATE,
+    PHASE_UPDATE_MOSQUITOES,
+    PHASE_UPDATE_INFO,
+    PHASE_UPDATE_TRANSITION,
+    PHASE_UPDATE_RAIN,
+    PHASE_UPDATE_PICK_GRID,
+    PHASE_UPDATE_EPIDEMIC,
+    PHASE_EPIDEMIC_DAY,
+    PHASE_SCENE,
+    PHASE_RAIN,
+    PHASE_FLUSH,
+    PHASE_TEXT,
+    PHASE_SWAP,
+    PHASE_COUNT
+};
+
+const char* const PROFILE_PHASE_NAMES[PHASE_COUNT] = {
+    "frame",
+    "drawBackground",
+    "updateAnimations",
+    "update.mosquitoes",
+    "update.infoMessages",
+    "update.sceneTransition",
+    "update.rain",
+    "update.pickGrid",
+    "update.epidemic",
+    "epidemic.day",
+    "scene",
+    "drawRain",
+    "flushDrawQueue",
+    "text overlays",
+    "swapBuffers"
+};
+
+const size_t PROFILE_RING_SIZE = 1 << 14;
+
+// One timing sample. The sequence number works as a per-slot seqlock: odd while
+// a writer fills the slot, 2 * index + 2 once sample number index is complete.
+struct ProfileSlot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> start;  // Nanoseconds since the profiler epoch
+    std::atomic<uint64_t> packed; // duration ns << 32 | phase << 16 | thread
+};
+
+struct ProfileRing {
+    std::atomic<uint64_t> head;
+    std::chrono::steady_clock::time_point epoch;
+    ProfileSlot slots[PROFILE_RING_SIZE];
+};
+
+inline ProfileRing& profileRing() {
+    static ProfileRing* ring = [] {
+        ProfileRing* r = new ProfileRing();
+        r->head.store(0);
+        r->epoch = std::chrono::steady_clock::now();
+        return r;
+    }();
+    return *ring;
+}
+
+inline uint64_t profileNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - profileRing().epoch).count();
+}
+
+// Threads that record samples, by the id stored with each sample
+const int PROFILE_THREAD_COUNT = 3;
+const char* const PROFILE_THREAD_NAMES[PROFILE_THREAD_COUNT] = {"render", "simulation", "epidemic"};
+
+// Thread id recorded with samples, 0 for the main thread
+inline uint16_t& profileThreadId() {
+    static thread_local uint16_t id = 0;
+    return id;
+}
+
+inline void recordProfileSample(ProfilePhase phase, uint64_t start, uint64_t end) {
+    ProfileRing& ring = profileRing();
+    uint64_t index = ring.head.fetch_add(1, std::memory_order_relaxed);
+    ProfileSlot& slot = ring.slots[index & (PROFILE_RING_SIZE - 1)];
+    uint64_t duration = std::min<uint64_t>(end - start, 0xFFFFFFFFu);
+
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.packed.store(duration << 32 | static_cast<uint64_t>(phase) << 16 | profileThreadId(),
+                      std::memory_order_relaxed);
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+// Innermost phase running on this thread, PHASE_COUNT outside every phase
+inline int& currentProfilePhase() {
+    static thread_local int phase = PHASE_COUNT;
+    return phase;
+}
+
+// Times the enclosing block
+struct ProfileScope {
+    ProfilePhase phase;
+    int outer;
+    uint64_t start;
+
+    explicit ProfileScope(ProfilePhase p) : phase(p), outer(currentProfilePhase()), start(profileNow()) {
+        currentProfilePhase() = p;
+    }
+    ~ProfileScope() {
+        currentProfilePhase() = outer;
+        recordProfileSample(phase, start, profileNow());
+    }
+};
+
+struct ProfileSample {
+    uint64_t start;
+    uint32_t duration;
+    uint16_t phase;
+    uint16_t thread;
+};
+
+// Copy up to maxSamples of the most recent complete samples, oldest first
+inline void readProfileSamples(std::vector<ProfileSample>& out, size_t maxSamples) {
+    ProfileRing& ring = profileRing();
+    out.clear();
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    size_t count = std::min<uint64_t>(std::min(maxSamples, PROFILE_RING_SIZE), head);
+    for(uint64_t index = head - count; index < head; index++) {
+        ProfileSlot& slot = ring.slots[index & (PROFILE_RING_SIZE - 1)];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if(sequence != index * 2 + 2) continue; // Still being written or overwritten
+        uint64_t start = slot.start.load(std::memory_order_relaxed);
+        uint64_t packed = slot.packed.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        ProfileSample sample;
+        sample.start = start;
+        sample.duration = static_cast<uint32_t>(packed >> 32);
+        sample.phase = static_cast<uint16_t>(packed >> 16);
+        sample.thread = static_cast<uint16_t>(packed);
+        if(sample.phase < PHASE_COUNT) out.push_back(sample);
+    }
+}
+
+struct PhaseStats {
+    size_t count;
+    double p50, p95, p99; // Milliseconds
+};
+
+// Sample and duration buffers for computePhaseStats, sized once so the HUD
+// refresh does not allocate
+struct PhaseStatsBuffers {
+    size_t window;
+    std::vector<ProfileSample> samples;
+    std::vector<uint32_t> durations[PROFILE_THREAD_COUNT][PHASE_COUNT];
+};
+
+inline void initPhaseStatsBuffers(PhaseStatsBuffers& buffers, size_t window) {
+    buffers.window = std::min(window, PROFILE_RING_SIZE);
+    buffers.samples.reserve(buffers.window);
+    for(int t = 0; t < PROFILE_THREAD_COUNT; t++) {
+        for(int p = 0; p < PHASE_COUNT; p++) buffers.durations[t][p].reserve(buffers.window);
+    }
+}
+
+// Rolling percentiles per phase and thread over the most recent samples, so a
+// phase timed on two threads (the pick grid rebuild) does not mix both
+inline void computePhaseStats(PhaseStatsBuffers& buffers, PhaseStats stats[PROFILE_THREAD_COUNT][PHASE_COUNT]) {
+    std::vector<ProfileSample>& samples = buffers.samples;
+    readProfileSamples(samples, buffers.window);
+    for(int t = 0; t < PROFILE_THREAD_COUNT; t++) {
+        for(int p = 0; p < PHASE_COUNT; p++) buffers.durations[t][p].clear();
+    }
+    for(const ProfileSample& sample : samples) {
+        if(sample.thread >= PROFILE_THREAD_COUNT) continue;
+        buffers.durations[sample.thread][sample.phase].push_back(sample.duration);
+    }
+
+    for(int t = 0; t < PROFILE_THREAD_COUNT; t++) {
+        for(int p = 0; p < PHASE_COUNT; p++) {
+            std::vector<uint32_t>& d = buffers.durations[t][p];
+            PhaseStats& s = stats[t][p];
+            s.count = d.size();
+            if(d.empty()) {
+                s.p50 = s.p95 = s.p99 = 0.0;
+                continue;
+            }
+            std::sort(d.begin(), d.end());
+            s.p50 = d[(d.size() - 1) * 50 / 100] / 1e6;
+            s.p95 = d[(d.size() - 1) * 95 / 100] / 1e6;
+            s.p99 = d[(d.size() - 1) * 99 / 100] / 1e6;
+        }
+    }
+}
+
+// Write every sample still in the ring as Chrome trace_event JSON
+inline bool writeChromeTrace(const char* path) {
+    std::vector<ProfileSample> samples;
+    readProfileSamples(samples, PROFILE_RING_SIZE);
+
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+    fprintf(file, "{\"traceEvents\":[\n");
+    for(int t = 0; t < PROFILE_THREAD_COUNT; t++) {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                t == 0 ? "" : ",\n", t, PROFILE_THREAD_NAMES[t]);
+    }
+    for(const ProfileSample& sample : samples) {
+        fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                      "\"ts\":%.3f,\"dur\":%.3f}",
+                PROFILE_PHASE_NAMES[sample.phase], sample.thread,
+                sample.start / 1000.0, sample.duration / 1000.0);
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(file) == 0;
+}
+
+#endif
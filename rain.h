@@ -0,0 +1,179 @@
+/*
+ * Pooled rain particles
+ * Drops live in a fixed-capacity structure-of-arrays pool and fall with their
+ * own velocities. Drops that reach the ground line or the opening of a water
+ * container are recycled in place at the top of the sky, and some of those
+ * splashes leave ripples behind.
+ */
+
+#ifndef DENGUE_RAIN_H
+#define DENGUE_RAIN_H
+
+#include <stddef.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "random.h"
+
+struct RainPool {
+    size_t count;      // Drops falling, packed at the front
+    size_t capacity;
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY; // Position at the previous tick
+    std::vector<float> vx, vy;       // World units per second
+    unsigned long long splashes;     // Splashes so far, for thinning ripples
+};
+
+struct RainParams {
+    bool raining;      // Recycle landed drops and spawn new ones
+    size_t targetDrops;
+    float minX, maxX;
+    float top, ground;
+    float minSpeed, maxSpeed;
+    float wind;
+    int groundRippleStride;    // One ripple per this many ground splashes
+    int containerRippleStride; // One ripple per this many splashes into water
+};
+
+// Opening of a water container that catches drops
+struct SplashTarget {
+    float minX, maxX;
+    float top;
+};
+
+struct Ripple {
+    float x, y;
+    float age;  // Seconds, the ripple is gone once it reaches the pool lifetime
+    bool onWater;
+};
+
+// Fixed ring of ripples, the oldest is replaced when it is full
+struct RipplePool {
+    std::vector<Ripple> ripples;
+    size_t next;
+    float lifetime;
+};
+
+inline void initRainPool(RainPool& rain, size_t capacity) {
+    rain.count = 0;
+    rain.capacity = capacity;
+    rain.x.assign(capacity, 0.0f);
+    rain.y.assign(capacity, 0.0f);
+    rain.prevX.assign(capacity, 0.0f);
+    rain.prevY.assign(capacity, 0.0f);
+    rain.vx.assign(capacity, 0.0f);
+    rain.vy.assign(capacity, 0.0f);
+    rain.splashes = 0;
+}
+
+inline void initRipplePool(RipplePool& pool, size_t capacity, float lifetime) {
+    Ripple dead = {0.0f, 0.0f, lifetime, false};
+    pool.ripples.assign(capacity, dead);
+    pool.next = 0;
+    pool.lifetime = lifetime;
+}
+
+inline void addRipple(RipplePool& pool, float x, float y, bool onWater) {
+    if(pool.ripples.empty()) return;
+    Ripple& ripple = pool.ripples[pool.next];
+    ripple.x = x;
+    ripple.y = y;
+    ripple.age = 0.0f;
+    ripple.onWater = onWater;
+    pool.next = (pool.next + 1) % pool.ripples.size();
+}
+
+inline void updateRipples(RipplePool& pool, float deltaTime) {
+    for(Ripple& ripple : pool.ripples) {
+        if(ripple.age < pool.lifetime) ripple.age += deltaTime;
+    }
+}
+
+inline bool hasLiveRipples(const RipplePool& pool) {
+    for(const Ripple& ripple : pool.ripples) {
+        if(ripple.age < pool.lifetime) return true;
+    }
+    return false;
+}
+
+// Put drop i at the top of the sky. The height is spread over one tick of
+// fall so drops spawned together do not line up in a sheet.
+inline void spawnDrop(RainPool& rain, size_t i, const RainParams& params, float deltaTime,
+                      RandomStream& random) {
+    float speed = randomRange(random, params.minSpeed, params.maxSpeed);
+    rain.vx[i] = params.wind * randomRange(random, 0.8f, 1.2f);
+    rain.vy[i] = -speed;
+    rain.x[i] = randomRange(random, params.minX, params.maxX);
+    rain.y[i] = params.top + randomRange(random, 0.0f, speed * deltaTime);
+    rain.prevX[i] = rain.x[i];
+    rain.prevY[i] = rain.y[i];
+}
+
+inline void saveRainState(RainPool& rain) {
+    std::copy(rain.x.begin(), rain.x.begin() + rain.count, rain.prevX.begin());
+    std::copy(rain.y.begin(), rain.y.begin() + rain.count, rain.prevY.begin());
+}
+
+// Move every drop, splash the ones that landed and top the pool up while it rains
+inline void updateRain(RainPool& rain, const RainParams& params, const SplashTarget* targets,
+                       size_t targetCount, float deltaTime, RandomStream& random, RipplePool& ripples) {
+    size_t target = std::min(params.targetDrops, rain.capacity);
+    size_t i = 0;
+    while(i < rain.count) {
+        float oldY = rain.y[i];
+        float x = rain.x[i] + rain.vx[i] * deltaTime;
+        float y = oldY + rain.vy[i] * deltaTime;
+        rain.x[i] = x;
+        rain.y[i] = y;
+
+        // Caught by a container opening on the way down, or hit the ground
+        bool landed = false;
+        bool onWater = false;
+        float splashY = params.ground;
+        for(size_t t = 0; t < targetCount; t++) {
+            if(oldY >= targets[t].top && y < targets[t].top &&
+               x >= targets[t].minX && x <= targets[t].maxX) {
+                landed = onWater = true;
+                splashY = targets[t].top;
+                break;
+            }
+        }
+        if(!landed) landed = y < params.ground;
+        if(!landed) {
+            i++;
+            continue;
+        }
+
+        rain.splashes++;
+        int stride = onWater ? params.containerRippleStride : params.groundRippleStride;
+        if(stride > 0 && rain.splashes % stride == 0) addRipple(ripples, x, splashY, onWater);
+
+        // The count never passes the target, so while it rains every landed drop is reused
+        if(params.raining) {
+            spawnDrop(rain, i, params, deltaTime, random);
+            i++;
+        } else {
+            // Rain stopped, retire the drop by moving the last one here
+            size_t last = --rain.count;
+            rain.x[i] = rain.x[last];
+            rain.y[i] = rain.y[last];
+            rain.prevX[i] = rain.prevX[last];
+            rain.prevY[i] = rain.prevY[last];
+            rain.vx[i] = rain.vx[last];
+            rain.vy[i] = rain.vy[last];
+        }
+    }
+
+    // Spawn at the rate drops fall out, so the sky fills evenly from the top
+    if(params.raining && rain.count < target) {
+        float fallTime = (params.top - params.ground) / (0.5f * (params.minSpeed + params.maxSpeed));
+        size_t spawn = static_cast<size_t>(std::ceil(target * deltaTime / fallTime));
+        spawn = std::min(spawn, target - rain.count);
+        for(size_t s = 0; s < spawn; s++) {
+            spawnDrop(rain, rain.count++, params, deltaTime, random);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * Seeded random number streams
+ * xoshiro128+ generators seeded from one global seed with splitmix64, one
+ * stream per subsystem so they never disturb each other. Bulk jitter comes
+ * from blocks of interleaved lanes whose state lives in plain arrays, which
+ * compilers turn into SIMD code, and every block of entities has its own
+ * lanes so blocks can be filled in any order or in parallel with equal results.
+ */
+
+#ifndef DENGUE_RANDOM_H
+#define DENGUE_RANDOM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <vector>
+
+const uint64_t DEFAULT_RANDOM_SEED = 1;
+
+// Independent streams derived from the global seed
+enum RandomStreamId {
+    RANDOM_STREAM_SPAWN = 1,   // Mosquito placement and spawning
+    RANDOM_STREAM_JITTER,      // Per-tick mosquito velocity kicks
+    RANDOM_STREAM_WEATHER,     // Rain on/off
+    RANDOM_STREAM_RAIN,        // Spawned rain drop positions and speeds in the simulated storm
+    RANDOM_STREAM_BENCH,       // Benchmarks
+    RANDOM_STREAM_EPIDEMIC,    // Dengue transmission model
+    RANDOM_STREAM_LAYOUT       // Starting mosquitoes of each scene, one block per scene
+};
+
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline uint32_t rotateLeft32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// Upper 24 bits as a float in [0, 1), exact in single precision
+inline float unitFloat(uint32_t bits) {
+    return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+struct RandomStream {
+    uint32_t s[4];
+};
+
+// Seed a stream from the global seed and a stream id (and optionally a block index)
+inline void seedRandomStream(RandomStream& stream, uint64_t seed, uint64_t streamId, uint64_t block = 0) {
+    uint64_t state = seed ^ (streamId * 0xD1B54A32D192ED03ULL) ^ (block * 0x8CB92BA72F3D8DD7ULL);
+    uint64_t a = splitMix64(state), b = splitMix64(state);
+    stream.s[0] = static_cast<uint32_t>(a);
+    stream.s[1] = static_cast<uint32_t>(a >> 32);
+    stream.s[2] = static_cast<uint32_t>(b);
+    stream.s[3] = static_cast<uint32_t>(b >> 32);
+    if((stream.s[0] | stream.s[1] | stream.s[2] | stream.s[3]) == 0) stream.s[0] = 1;
+}
+
+// xoshiro128+: fast, with good upper bits, which is all unitFloat uses
+inline uint32_t nextRandom(RandomStream& stream) {
+    uint32_t* s = stream.s;
+    uint32_t result = s[0] + s[3];
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft32(s[3], 11);
+    return result;
+}
+
+inline float randomFloat(RandomStream& stream) {
+    return unitFloat(nextRandom(stream));
+}
+
+inline float randomRange(RandomStream& stream, float low, float high) {
+    return low + randomFloat(stream) * (high - low);
+}
+
+inline bool randomBool(RandomStream& stream) {
+    return nextRandom(stream) >> 31;
+}
+
+// True with the given probability
+inline bool randomChance(RandomStream& stream, float probability) {
+    return randomFloat(stream) < probability;
+}
+
+const size_t RANDOM_LANES = 8;
+
+// RANDOM_LANES xoshiro128+ generators stepped together, stored by state word
+struct RandomLanes {
+    uint32_t s0[RANDOM_LANES], s1[RANDOM_LANES], s2[RANDOM_LANES], s3[RANDOM_LANES];
+};
+
+inline void seedRandomLanes(RandomLanes& lanes, uint64_t seed, uint64_t streamId, uint64_t block) {
+    for(size_t lane = 0; lane < RANDOM_LANES; lane++) {
+        RandomStream stream;
+        seedRandomStream(stream, seed, streamId, block * RANDOM_LANES + lane);
+        lanes.s0[lane] = stream.s[0];
+        lanes.s1[lane] = stream.s[1];
+        lanes.s2[lane] = stream.s[2];
+        lanes.s3[lane] = stream.s[3];
+    }
+}
+
+// Fill out[0..count) with floats in [low, high), RANDOM_LANES at a time
+inline void fillRandomLanes(RandomLanes& lanes, float* out, size_t count, float low, float high) {
+    float scale = (high - low) * (1.0f / 16777216.0f);
+    uint32_t result[RANDOM_LANES];
+    for(size_t i = 0; i < count; i += RANDOM_LANES) {
+        for(size_t lane = 0; lane < RANDOM_LANES; lane++) {
+            result[lane] = lanes.s0[lane] + lanes.s3[lane];
+            uint32_t t = lanes.s1[lane] << 9;
+            lanes.s2[lane] ^= lanes.s0[lane];
+            lanes.s3[lane] ^= lanes.s1[lane];
+            lanes.s1[lane] ^= lanes.s2[lane];
+            lanes.s0[lane] ^= lanes.s3[lane];
+            lanes.s2[lane] ^= t;
+            lanes.s3[lane] = (lanes.s3[lane] << 11) | (lanes.s3[lane] >> 21);
+        }
+        size_t n = std::min(RANDOM_LANES, count - i);
+        for(size_t lane = 0; lane < n; lane++) {
+            out[i + lane] = low + static_cast<float>(result[lane] >> 8) * scale;
+        }
+    }
+}
+
+// One set of lanes per block of blockSize entities
+struct RandomBlocks {
+    uint64_t seed;
+    uint64_t streamId;
+    size_t blockSize;
+    std::vector<RandomLanes> blocks;
+};
+
+inline void seedRandomBlocks(RandomBlocks& random, uint64_t seed, uint64_t streamId, size_t blockSize) {
+    random.seed = seed;
+    random.streamId = streamId;
+    random.blockSize = blockSize;
+    random.blocks.clear();
+}
+
+// Fill out[0..count) with floats in [low, high); entity i always draws from block i / blockSize
+inline void fillRandomBlocks(RandomBlocks& random, float* out, size_t count, float low, float high) {
+    size_t blockCount = (count + random.blockSize - 1) / random.blockSize;
+    while(random.blocks.size() < blockCount) {
+        random.blocks.push_back(RandomLanes());
+        seedRandomLanes(random.blocks.back(), random.seed, random.streamId, random.blocks.size() - 1);
+    }
+    for(size_t b = 0; b < blockCount; b++) {
+        size_t first = b * random.blockSize;
+        fillRandomLanes(random.blocks[b], out + first, std::min(random.blockSize, count - first), low, high);
+    }
+}
+
+#endif
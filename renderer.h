@@ -0,0 +1,687 @@
+/*
+ * Renderer backends
+ * Everything the app draws goes through these calls: interleaved vertex
+ * arrays, x, y arrays in one color, retained vertex buffers and instanced
+ * shapes. The legacy backend maps them onto the fixed-function pipeline and
+ * client arrays, the way the app has always drawn. The OpenGL 3.3 core
+ * backend draws with one shader program, streams each frame's vertices
+ * through a single buffer (mapped once where GL 4.4 or ARB_buffer_storage
+ * allow, orphaned when full otherwise) and draws repeated shapes such as the
+ * mosquitoes as instances of one shape, so a swarm uploads four floats per
+ * mosquito instead of every vertex.
+ */
+
+#ifndef DENGUE_RENDERER_H
+#define DENGUE_RENDERER_H
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#elif defined(__APPLE__)
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glx.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#if !defined(__APPLE__)
+// The framework only hands out core contexts through its own pixel formats
+#define DENGUE_HAS_GL33 1
+#endif
+
+enum RenderBackend {
+    RENDER_LEGACY = 0, // Fixed-function pipeline and client arrays
+    RENDER_GL33        // OpenGL 3.3 core: shaders, streamed buffers, instancing
+};
+
+// How the bound texture colors what is drawn
+enum RenderTexture {
+    RENDER_UNTEXTURED = 0,
+    RENDER_RGBA,      // Color times the texel
+    RENDER_COVERAGE   // Alpha times a one-channel coverage texture (glyphs)
+};
+
+const size_t RENDER_STRIDE = 8;             // Floats per vertex: x, y, u, v, r, g, b, a
+const size_t RENDER_INSTANCE_STRIDE = 4;    // Floats per instance: x, y, scale, stretch
+const size_t RENDER_SHAPE_STRIDE = 3;       // Floats per shape vertex: x, y, stretch weight
+const int RENDER_STREAM_REGIONS = 3;        // Frames the persistent stream buffer keeps in flight
+const size_t RENDER_STREAM_SIZE = 4 << 20;  // Initial stream bytes per frame
+const size_t RENDER_STREAM_ALIGN = 16;
+
+// Enabled arrays: client states for the legacy backend, attributes for the core one
+const unsigned RENDER_POSITIONS = 1;
+const unsigned RENDER_TEXCOORDS = 2;
+const unsigned RENDER_COLORS = 4;
+const unsigned RENDER_INSTANCES = 8; // Core only
+
+inline const char* renderBackendName(RenderBackend backend) {
+    return backend == RENDER_GL33 ? "gl33" : "legacy";
+}
+
+// Vertices of a repeated shape. Each vertex is placed at the instance's
+// (x, y) + (vx, vy) * scale + (weight * stretch, 0), so one shape covers
+// every mosquito however its wings beat.
+struct RenderShape {
+    GLenum mode;   // GL_LINES, GL_TRIANGLES or GL_POINTS, which stay apart between instances
+    GLint first;
+    GLsizei count;
+};
+
+// Where the renderer reads an array: the caller's memory for the legacy
+// backend, a buffer object and byte offset for the core one and retained meshes
+struct RenderArrays {
+    const float* client;
+    GLuint buffer;
+    size_t offset;
+};
+
+#ifdef DENGUE_HAS_GL33
+struct RenderFunctions {
+    PFNGLGENBUFFERSPROC genBuffers;
+    PFNGLDELETEBUFFERSPROC deleteBuffers;
+    PFNGLBINDBUFFERPROC bindBuffer;
+    PFNGLBUFFERDATAPROC bufferData;
+    PFNGLBUFFERSTORAGEPROC bufferStorage; // NULL without GL 4.4 or ARB_buffer_storage
+    PFNGLMAPBUFFERRANGEPROC mapBufferRange;
+    PFNGLUNMAPBUFFERPROC unmapBuffer;
+    PFNGLFENCESYNCPROC fenceSync;
+    PFNGLCLIENTWAITSYNCPROC clientWaitSync;
+    PFNGLDELETESYNCPROC deleteSync;
+    PFNGLGENVERTEXARRAYSPROC genVertexArrays;
+    PFNGLBINDVERTEXARRAYPROC bindVertexArray;
+    PFNGLENABLEVERTEXATTRIBARRAYPROC enableVertexAttribArray;
+    PFNGLDISABLEVERTEXATTRIBARRAYPROC disableVertexAttribArray;
+    PFNGLVERTEXATTRIBPOINTERPROC vertexAttribPointer;
+    PFNGLVERTEXATTRIBDIVISORPROC vertexAttribDivisor;
+    PFNGLVERTEXATTRIB4FPROC vertexAttrib4f;
+    PFNGLDRAWARRAYSINSTANCEDPROC drawArraysInstanced;
+    PFNGLCREATESHADERPROC createShader;
+    PFNGLSHADERSOURCEPROC shaderSource;
+    PFNGLCOMPILESHADERPROC compileShader;
+    PFNGLGETSHADERIVPROC getShaderiv;
+    PFNGLGETSHADERINFOLOGPROC getShaderInfoLog;
+    PFNGLDELETESHADERPROC deleteShader;
+    PFNGLCREATEPROGRAMPROC createProgram;
+    PFNGLATTACHSHADERPROC attachShader;
+    PFNGLLINKPROGRAMPROC linkProgram;
+    PFNGLGETPROGRAMIVPROC getProgramiv;
+    PFNGLGETPROGRAMINFOLOGPROC getProgramInfoLog;
+    PFNGLUSEPROGRAMPROC useProgram;
+    PFNGLGETUNIFORMLOCATIONPROC getUniformLocation;
+    PFNGLUNIFORM1IPROC uniform1i;
+    PFNGLUNIFORM4FPROC uniform4f;
+    PFNGLGETSTRINGIPROC getStringi;
+};
+#endif
+
+struct Renderer {
+    RenderBackend backend;
+    bool coreProfile; // The context has no fixed-function pipeline
+    bool persistent;  // Stream buffer mapped once, otherwise orphaned when full
+    unsigned arrays;  // Enabled arrays
+    int textureMode;  // RenderTexture the program is set up for
+    std::vector<float> shapeVertices;
+    std::vector<RenderShape> shapes;
+    std::vector<float> expanded; // Legacy: instances expanded into x, y pairs
+
+    // Core backend objects
+    GLuint program, vertexArray, shapeBuffer, streamBuffer;
+    GLint projectionLocation, textureModeLocation;
+    size_t regionSize;             // Stream bytes one frame may use
+    size_t streamOffset, streamEnd; // Free bytes of the current frame
+    int region;
+    unsigned char* mapped;         // Persistent mapping of the whole stream buffer
+#ifdef DENGUE_HAS_GL33
+    GLsync fences[RENDER_STREAM_REGIONS]; // Set when the GPU is done with a region
+    RenderFunctions gl;
+#endif
+
+    // This frame
+    size_t streamedBytes, instancesDrawn;
+
+    Renderer() : backend(RENDER_LEGACY), coreProfile(false), persistent(false), arrays(0),
+                 textureMode(RENDER_UNTEXTURED), program(0), vertexArray(0), shapeBuffer(0), streamBuffer(0),
+                 projectionLocation(-1), textureModeLocation(-1), regionSize(0), streamOffset(0), streamEnd(0),
+                 region(0), mapped(NULL), streamedBytes(0), instancesDrawn(0) {
+#ifdef DENGUE_HAS_GL33
+        for(int i = 0; i < RENDER_STREAM_REGIONS; i++) fences[i] = 0;
+        memset(&gl, 0, sizeof(gl));
+#endif
+    }
+};
+
+inline void* renderProcAddress(const char* name) {
+#if defined(_WIN32)
+    return (void*)wglGetProcAddress(name);
+#elif defined(__APPLE__)
+    (void)name;
+    return NULL;
+#else
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+}
+
+inline size_t alignRenderStream(size_t bytes) {
+    return (bytes + RENDER_STREAM_ALIGN - 1) & ~(RENDER_STREAM_ALIGN - 1);
+}
+
+// Array base pointer as glVertexPointer and glVertexAttribPointer take it
+inline const float* renderArrayBase(const RenderArrays& arrays) {
+    return arrays.buffer ? reinterpret_cast<const float*>(static_cast<uintptr_t>(arrays.offset)) : arrays.client;
+}
+
+inline void bindRenderBuffer(Renderer& r, GLuint buffer) {
+#ifdef DENGUE_HAS_GL33
+    r.gl.bindBuffer(GL_ARRAY_BUFFER, buffer);
+#else
+    (void)r;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+#endif
+}
+
+#ifdef DENGUE_HAS_GL33
+// Attribute 0 takes shape vertices as well, whose third component is the
+// stretch weight; plain vertices leave it 0, and attribute 3 is the constant
+// instance (0, 0, 1, 0) when it is not an array
+const char* const RENDER_VERTEX_SHADER =
+    "#version 330 core\n"
+    "uniform vec4 projection;\n" // x and y scale, then offset
+    "layout(location = 0) in vec3 position;\n"
+    "layout(location = 1) in vec2 texcoord;\n"
+    "layout(location = 2) in vec4 color;\n"
+    "layout(location = 3) in vec4 instance;\n"
+    "out vec2 fragmentTexcoord;\n"
+    "out vec4 fragmentColor;\n"
+    "void main() {\n"
+    "    vec2 p = instance.xy + position.xy * instance.z + vec2(position.z * instance.w, 0.0);\n"
+    "    gl_Position = vec4(p * projection.xy + projection.zw, 0.0, 1.0);\n"
+    "    fragmentTexcoord = texcoord;\n"
+    "    fragmentColor = color;\n"
+    "}\n";
+
+const char* const RENDER_FRAGMENT_SHADER =
+    "#version 330 core\n"
+    "uniform sampler2D image;\n"
+    "uniform int textureMode;\n"
+    "in vec2 fragmentTexcoord;\n"
+    "in vec4 fragmentColor;\n"
+    "out vec4 fragment;\n"
+    "void main() {\n"
+    "    fragment = fragmentColor;\n"
+    "    if(textureMode == 1) fragment *= texture(image, fragmentTexcoord);\n"
+    "    else if(textureMode == 2) fragment.a *= texture(image, fragmentTexcoord).r;\n"
+    "}\n";
+
+inline GLuint compileRenderShader(RenderFunctions& gl, GLenum type, const char* source) {
+    GLuint shader = gl.createShader(type);
+    gl.shaderSource(shader, 1, &source, NULL);
+    gl.compileShader(shader);
+    GLint compiled = 0;
+    gl.getShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if(!compiled) {
+        char log[1024] = "";
+        gl.getShaderInfoLog(shader, sizeof(log), NULL, log);
+        fprintf(stderr, "renderer: shader does not compile: %s\n", log);
+        gl.deleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+inline bool hasRenderExtension(Renderer& r, const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for(GLint i = 0; i < count; i++) {
+        const char* extension = (const char*)r.gl.getStringi(GL_EXTENSIONS, i);
+        if(extension && strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
+
+// Create the stream buffer with room for regionSize bytes per frame. A
+// buffer being replaced is deleted at once; draws still reading it keep its
+// storage alive until they finish.
+inline void createRenderStream(Renderer& r, size_t regionSize) {
+    RenderFunctions& gl = r.gl;
+    if(r.streamBuffer) {
+        if(r.mapped) {
+            gl.bindBuffer(GL_ARRAY_BUFFER, r.streamBuffer);
+            gl.unmapBuffer(GL_ARRAY_BUFFER);
+            r.mapped = NULL;
+        }
+        gl.deleteBuffers(1, &r.streamBuffer);
+    }
+    for(int i = 0; i < RENDER_STREAM_REGIONS; i++) {
+        if(r.fences[i]) gl.deleteSync(r.fences[i]);
+        r.fences[i] = 0;
+    }
+
+    r.regionSize = alignRenderStream(regionSize);
+    r.region = 0;
+    r.streamOffset = 0;
+    r.streamEnd = r.regionSize;
+    gl.genBuffers(1, &r.streamBuffer);
+    gl.bindBuffer(GL_ARRAY_BUFFER, r.streamBuffer);
+    if(r.persistent) {
+        GLsizeiptr size = static_cast<GLsizeiptr>(r.regionSize * RENDER_STREAM_REGIONS);
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        gl.bufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+        r.mapped = static_cast<unsigned char*>(gl.mapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+        if(r.mapped) return;
+        fprintf(stderr, "renderer: cannot map the stream buffer persistently, orphaning it instead\n");
+        r.persistent = false;
+        gl.deleteBuffers(1, &r.streamBuffer);
+        gl.genBuffers(1, &r.streamBuffer);
+        gl.bindBuffer(GL_ARRAY_BUFFER, r.streamBuffer);
+    }
+    gl.bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(r.regionSize), NULL, GL_STREAM_DRAW);
+}
+
+inline bool initCoreRenderer(Renderer& r, bool preferPersistent, int major, int minor) {
+    RenderFunctions& gl = r.gl;
+    bool found = true;
+    auto load = [&](const char* name) {
+        void* address = renderProcAddress(name);
+        found = found && address != NULL;
+        return address;
+    };
+    gl.genBuffers = (PFNGLGENBUFFERSPROC)load("glGenBuffers");
+    gl.deleteBuffers = (PFNGLDELETEBUFFERSPROC)load("glDeleteBuffers");
+    gl.bufferData = (PFNGLBUFFERDATAPROC)load("glBufferData");
+    gl.mapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+    gl.unmapBuffer = (PFNGLUNMAPBUFFERPROC)load("glUnmapBuffer");
+    gl.fenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+    gl.clientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+    gl.deleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+    gl.genVertexArrays = (PFNGLGENVERTEXARRAYSPROC)load("glGenVertexArrays");
+    gl.bindVertexArray = (PFNGLBINDVERTEXARRAYPROC)load("glBindVertexArray");
+    gl.enableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)load("glEnableVertexAttribArray");
+    gl.disableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)load("glDisableVertexAttribArray");
+    gl.vertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)load("glVertexAttribPointer");
+    gl.vertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)load("glVertexAttribDivisor");
+    gl.vertexAttrib4f = (PFNGLVERTEXATTRIB4FPROC)load("glVertexAttrib4f");
+    gl.drawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)load("glDrawArraysInstanced");
+    gl.createShader = (PFNGLCREATESHADERPROC)load("glCreateShader");
+    gl.shaderSource = (PFNGLSHADERSOURCEPROC)load("glShaderSource");
+    gl.compileShader = (PFNGLCOMPILESHADERPROC)load("glCompileShader");
+    gl.getShaderiv = (PFNGLGETSHADERIVPROC)load("glGetShaderiv");
+    gl.getShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)load("glGetShaderInfoLog");
+    gl.deleteShader = (PFNGLDELETESHADERPROC)load("glDeleteShader");
+    gl.createProgram = (PFNGLCREATEPROGRAMPROC)load("glCreateProgram");
+    gl.attachShader = (PFNGLATTACHSHADERPROC)load("glAttachShader");
+    gl.linkProgram = (PFNGLLINKPROGRAMPROC)load("glLinkProgram");
+    gl.getProgramiv = (PFNGLGETPROGRAMIVPROC)load("glGetProgramiv");
+    gl.getProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)load("glGetProgramInfoLog");
+    gl.useProgram = (PFNGLUSEPROGRAMPROC)load("glUseProgram");
+    gl.getUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)load("glGetUniformLocation");
+    gl.uniform1i = (PFNGLUNIFORM1IPROC)load("glUniform1i");
+    gl.uniform4f = (PFNGLUNIFORM4FPROC)load("glUniform4f");
+    gl.getStringi = (PFNGLGETSTRINGIPROC)load("glGetStringi");
+    if(!found || !gl.bindBuffer) {
+        fprintf(stderr, "renderer: OpenGL 3.3 entry points are missing\n");
+        return false;
+    }
+
+    GLuint vertexShader = compileRenderShader(gl, GL_VERTEX_SHADER, RENDER_VERTEX_SHADER);
+    GLuint fragmentShader = compileRenderShader(gl, GL_FRAGMENT_SHADER, RENDER_FRAGMENT_SHADER);
+    if(!vertexShader || !fragmentShader) return false;
+    r.program = gl.createProgram();
+    gl.attachShader(r.program, vertexShader);
+    gl.attachShader(r.program, fragmentShader);
+    gl.linkProgram(r.program);
+    gl.deleteShader(vertexShader);
+    gl.deleteShader(fragmentShader);
+    GLint linked = 0;
+    gl.getProgramiv(r.program, GL_LINK_STATUS, &linked);
+    if(!linked) {
+        char log[1024] = "";
+        gl.getProgramInfoLog(r.program, sizeof(log), NULL, log);
+        fprintf(stderr, "renderer: shader program does not link: %s\n", log);
+        return false;
+    }
+    r.projectionLocation = gl.getUniformLocation(r.program, "projection");
+    r.textureModeLocation = gl.getUniformLocation(r.program, "textureMode");
+    // Left unbound until the first frame binds it with the rest of the frame state
+    gl.useProgram(r.program);
+    gl.uniform1i(gl.getUniformLocation(r.program, "image"), 0);
+    gl.uniform1i(r.textureModeLocation, RENDER_UNTEXTURED);
+    gl.useProgram(0);
+
+    // Core profiles draw nothing without a vertex array object; one serves every draw
+    gl.genVertexArrays(1, &r.vertexArray);
+    gl.bindVertexArray(r.vertexArray);
+    gl.vertexAttribDivisor(3, 1);
+    gl.vertexAttrib4f(3, 0.0f, 0.0f, 1.0f, 0.0f);
+
+    bool hasStorage = major > 4 || (major == 4 && minor >= 4) || hasRenderExtension(r, "GL_ARB_buffer_storage");
+    gl.bufferStorage = hasStorage ? (PFNGLBUFFERSTORAGEPROC)renderProcAddress("glBufferStorage") : NULL;
+    r.persistent = preferPersistent && gl.bufferStorage != NULL;
+    createRenderStream(r, RENDER_STREAM_SIZE);
+    gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+#endif
+
+// Set up the requested backend, or the legacy one where OpenGL 3.3 is
+// missing; needs a current context. preferPersistent picks a persistently
+// mapped stream buffer over orphaning where the driver has one.
+inline RenderBackend initRenderer(Renderer& r, RenderBackend requested, bool preferPersistent = true) {
+    r.backend = RENDER_LEGACY;
+    int major = 0, minor = 0;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if(version) sscanf(version, "%d.%d", &major, &minor);
+#ifdef DENGUE_HAS_GL33
+    r.gl.bindBuffer = (PFNGLBINDBUFFERPROC)renderProcAddress("glBindBuffer");
+    if(major > 3 || (major == 3 && minor >= 2)) {
+        GLint profile = 0;
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile);
+        r.coreProfile = (profile & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+    }
+    if(requested != RENDER_GL33) return r.backend;
+    if(major < 3 || (major == 3 && minor < 3)) {
+        fprintf(stderr, "renderer: OpenGL %s is older than 3.3, using the legacy backend\n",
+                version ? version : "(unknown)");
+        return r.backend;
+    }
+    if(!initCoreRenderer(r, preferPersistent, major, minor)) {
+        fprintf(stderr, "renderer: using the legacy backend\n");
+        return r.backend;
+    }
+    r.backend = RENDER_GL33;
+#else
+    (void)preferPersistent;
+    if(requested == RENDER_GL33) {
+        fprintf(stderr, "renderer: the OpenGL 3.3 backend is not available here, using the legacy backend\n");
+    }
+#endif
+    return r.backend;
+}
+
+// Register a shape of count vertices (RENDER_SHAPE_STRIDE floats each),
+// returns its index for drawRenderInstances
+inline int addRenderShape(Renderer& r, GLenum mode, const float* vertices, size_t count) {
+    RenderShape shape = {mode, static_cast<GLint>(r.shapeVertices.size() / RENDER_SHAPE_STRIDE),
+                         static_cast<GLsizei>(count)};
+    r.shapeVertices.insert(r.shapeVertices.end(), vertices, vertices + count * RENDER_SHAPE_STRIDE);
+    r.shapes.push_back(shape);
+    return static_cast<int>(r.shapes.size() - 1);
+}
+
+// Move the registered shapes to the GPU
+inline void uploadRenderShapes(Renderer& r) {
+#ifdef DENGUE_HAS_GL33
+    if(r.backend != RENDER_GL33 || r.shapeVertices.empty()) return;
+    RenderFunctions& gl = r.gl;
+    if(!r.shapeBuffer) gl.genBuffers(1, &r.shapeBuffer);
+    gl.bindBuffer(GL_ARRAY_BUFFER, r.shapeBuffer);
+    gl.bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(r.shapeVertices.size() * sizeof(float)),
+                  r.shapeVertices.data(), GL_STATIC_DRAW);
+    gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+#else
+    (void)r;
+#endif
+}
+
+// Room for up to this many instances per draw, so drawing them does not
+// allocate or grow the stream buffer mid-frame
+inline void reserveRenderInstances(Renderer& r, size_t instances) {
+    if(r.backend == RENDER_LEGACY) {
+        GLsizei largest = 0;
+        for(const RenderShape& shape : r.shapes) largest = std::max(largest, shape.count);
+        if(r.expanded.size() < instances * largest * 2) r.expanded.resize(instances * largest * 2);
+        return;
+    }
+#ifdef DENGUE_HAS_GL33
+    size_t needed = alignRenderStream(instances * RENDER_INSTANCE_STRIDE * sizeof(float)) + RENDER_STREAM_SIZE;
+    if(r.regionSize < needed) createRenderStream(r, needed);
+#endif
+}
+
+// Make sure the next bytes of uploads land in one piece, so arrays streamed
+// for one batch of draws are not overwritten while that batch still uses them
+inline void reserveRenderStream(Renderer& r, size_t bytes) {
+#ifdef DENGUE_HAS_GL33
+    if(r.backend != RENDER_GL33 || r.streamOffset + bytes <= r.streamEnd) return;
+    if(r.persistent) {
+        // This frame outgrew its region and the GPU may still read the others
+        createRenderStream(r, std::max(r.regionSize * 2, bytes));
+        return;
+    }
+    // Orphan: the driver hands out new storage and frees the old one after its draws
+    r.regionSize = std::max(r.regionSize, alignRenderStream(bytes));
+    r.gl.bindBuffer(GL_ARRAY_BUFFER, r.streamBuffer);
+    r.gl.bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(r.regionSize), NULL, GL_STREAM_DRAW);
+    r.streamOffset = 0;
+    r.streamEnd = r.regionSize;
+#else
+    (void)r;
+    (void)bytes;
+#endif
+}
+
+// Hand floats to the renderer for this frame's draws. The legacy backend reads
+// them where they are, the core one copies them into the stream buffer.
+inline RenderArrays streamRenderArrays(Renderer& r, const float* data, size_t floats) {
+    RenderArrays arrays = {data, 0, 0};
+#ifdef DENGUE_HAS_GL33
+    if(r.backend != RENDER_GL33 || floats == 0) return arrays;
+    RenderFunctions& gl = r.gl;
+    size_t bytes = floats * sizeof(float);
+    reserveRenderStream(r, bytes);
+    arrays.client = NULL;
+    arrays.buffer = r.streamBuffer;
+    arrays.offset = r.streamOffset;
+    if(r.persistent) {
+        memcpy(r.mapped + r.streamOffset, data, bytes);
+    } else {
+        // Only ranges no queued draw reads are written, so there is nothing to wait for
+        gl.bindBuffer(GL_ARRAY_BUFFER, r.streamBuffer);
+        void* target = gl.mapBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(r.streamOffset),
+                                         static_cast<GLsizeiptr>(bytes),
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                         GL_MAP_UNSYNCHRONIZED_BIT);
+        if(target) memcpy(target, data, bytes);
+        gl.unmapBuffer(GL_ARRAY_BUFFER);
+    }
+    r.streamOffset += alignRenderStream(bytes);
+    r.streamedBytes += bytes;
+#else
+    (void)r;
+    (void)floats;
+#endif
+    return arrays;
+}
+
+// Arrays in a retained vertex buffer
+inline RenderArrays bufferRenderArrays(GLuint buffer) {
+    RenderArrays arrays = {NULL, buffer, 0};
+    return arrays;
+}
+
+// Start a frame showing [left, right] x [bottom, top]
+inline void beginRenderFrame(Renderer& r, float left, float right, float bottom, float top) {
+    r.streamedBytes = r.instancesDrawn = 0;
+    if(r.backend == RENDER_LEGACY) {
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(left, right, bottom, top, -1.0, 1.0);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+        return;
+    }
+#ifdef DENGUE_HAS_GL33
+    RenderFunctions& gl = r.gl;
+    gl.useProgram(r.program);
+    gl.bindVertexArray(r.vertexArray);
+    gl.uniform4f(r.projectionLocation, 2.0f / (right - left), 2.0f / (top - bottom),
+                 -(right + left) / (right - left), -(top + bottom) / (top - bottom));
+    if(r.persistent) {
+        // Write into the region of three frames ago once the GPU is done with it
+        r.region = (r.region + 1) % RENDER_STREAM_REGIONS;
+        GLsync& fence = r.fences[r.region];
+        if(fence) {
+            while(gl.clientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ULL) == GL_TIMEOUT_EXPIRED) {}
+            gl.deleteSync(fence);
+            fence = 0;
+        }
+        r.streamOffset = r.region * r.regionSize;
+        r.streamEnd = r.streamOffset + r.regionSize;
+    }
+#endif
+}
+
+inline void endRenderFrame(Renderer& r) {
+#ifdef DENGUE_HAS_GL33
+    if(r.backend == RENDER_GL33 && r.persistent) {
+        r.fences[r.region] = r.gl.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#else
+    (void)r;
+#endif
+}
+
+inline void setRenderTexture(Renderer& r, GLuint texture, RenderTexture kind) {
+    if(r.backend == RENDER_LEGACY) {
+        if(kind == RENDER_UNTEXTURED) {
+            glDisable(GL_TEXTURE_2D);
+            return;
+        }
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        // Alpha textures modulate only the alpha, which is the coverage mode
+        if(kind == RENDER_COVERAGE) glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        return;
+    }
+#ifdef DENGUE_HAS_GL33
+    if(kind != RENDER_UNTEXTURED) glBindTexture(GL_TEXTURE_2D, texture);
+    if(kind != r.textureMode) {
+        r.gl.uniform1i(r.textureModeLocation, kind);
+        r.textureMode = kind;
+    }
+#endif
+}
+
+inline void enableRenderArrays(Renderer& r, unsigned mask) {
+    static const GLenum clientStates[3] = {GL_VERTEX_ARRAY, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY};
+    unsigned changed = mask ^ r.arrays;
+    for(GLuint a = 0; a < 4; a++) {
+        if(!(changed & (1u << a))) continue;
+        bool enable = (mask & (1u << a)) != 0;
+        if(r.backend == RENDER_LEGACY) {
+            if(a == 3) continue;
+            if(enable) glEnableClientState(clientStates[a]);
+            else glDisableClientState(clientStates[a]);
+        } else {
+#ifdef DENGUE_HAS_GL33
+            if(enable) r.gl.enableVertexAttribArray(a);
+            else r.gl.disableVertexAttribArray(a);
+#endif
+        }
+    }
+    r.arrays = mask;
+}
+
+// Draw the following drawRenderArrays() calls from vertices of RENDER_STRIDE floats
+inline void setRenderVertices(Renderer& r, const RenderArrays& arrays) {
+    const GLsizei stride = static_cast<GLsizei>(RENDER_STRIDE * sizeof(float));
+    const float* base = renderArrayBase(arrays);
+    enableRenderArrays(r, RENDER_POSITIONS | RENDER_TEXCOORDS | RENDER_COLORS);
+    if(arrays.buffer) bindRenderBuffer(r, arrays.buffer);
+    if(r.backend == RENDER_LEGACY) {
+        glVertexPointer(2, GL_FLOAT, stride, base);
+        glTexCoordPointer(2, GL_FLOAT, stride, base + 2);
+        glColorPointer(4, GL_FLOAT, stride, base + 4);
+        // The pointers keep the buffer they were set with
+        if(arrays.buffer) bindRenderBuffer(r, 0);
+        return;
+    }
+#ifdef DENGUE_HAS_GL33
+    r.gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, base);
+    r.gl.vertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, base + 2);
+    r.gl.vertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, base + 4);
+#endif
+}
+
+// Draw the following drawRenderArrays() calls from x, y pairs in one color
+inline void setRenderPositions(Renderer& r, const RenderArrays& arrays, const float color[4]) {
+    const float* base = renderArrayBase(arrays);
+    enableRenderArrays(r, RENDER_POSITIONS);
+    if(arrays.buffer) bindRenderBuffer(r, arrays.buffer);
+    if(r.backend == RENDER_LEGACY) {
+        glColor4f(color[0], color[1], color[2], color[3]);
+        glVertexPointer(2, GL_FLOAT, 0, base);
+        if(arrays.buffer) bindRenderBuffer(r, 0);
+        return;
+    }
+#ifdef DENGUE_HAS_GL33
+    r.gl.vertexAttrib4f(2, color[0], color[1], color[2], color[3]);
+    r.gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, base);
+#endif
+}
+
+inline void drawRenderArrays(Renderer& r, GLenum mode, size_t first, size_t count) {
+    (void)r;
+    glDrawArrays(mode, static_cast<GLint>(first), static_cast<GLsizei>(count));
+}
+
+// Disable the arrays again, for code drawing without the renderer
+inline void endRenderArrays(Renderer& r) {
+    enableRenderArrays(r, 0);
+}
+
+// Draw a registered shape once per instance of RENDER_INSTANCE_STRIDE floats, in one color
+inline void drawRenderInstances(Renderer& r, int shapeIndex, const RenderArrays& instances, size_t count,
+                                const float color[4]) {
+    if(count == 0) return;
+    const RenderShape& shape = r.shapes[shapeIndex];
+    r.instancesDrawn += count;
+    if(r.backend == RENDER_LEGACY) {
+        // Place every vertex on the CPU, in the order the instances come
+        size_t floats = count * shape.count * 2;
+        if(r.expanded.size() < floats) r.expanded.resize(floats);
+        const float* instance = instances.client;
+        const float* vertices = &r.shapeVertices[shape.first * RENDER_SHAPE_STRIDE];
+        float* out = r.expanded.data();
+        for(size_t i = 0; i < count; i++, instance += RENDER_INSTANCE_STRIDE) {
+            for(GLsizei v = 0; v < shape.count; v++) {
+                const float* vertex = &vertices[v * RENDER_SHAPE_STRIDE];
+                *out++ = instance[0] + vertex[0] * instance[2] + vertex[2] * instance[3];
+                *out++ = instance[1] + vertex[1] * instance[2];
+            }
+        }
+        RenderArrays expanded = {r.expanded.data(), 0, 0};
+        setRenderPositions(r, expanded, color);
+        drawRenderArrays(r, shape.mode, 0, count * shape.count);
+        return;
+    }
+#ifdef DENGUE_HAS_GL33
+    RenderFunctions& gl = r.gl;
+    enableRenderArrays(r, RENDER_POSITIONS | RENDER_INSTANCES);
+    gl.vertexAttrib4f(2, color[0], color[1], color[2], color[3]);
+    gl.bindBuffer(GL_ARRAY_BUFFER, r.shapeBuffer);
+    gl.vertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(RENDER_SHAPE_STRIDE * sizeof(float)),
+                           NULL);
+    gl.bindBuffer(GL_ARRAY_BUFFER, instances.buffer);
+    gl.vertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(RENDER_INSTANCE_STRIDE * sizeof(float)),
+                           renderArrayBase(instances));
+    gl.drawArraysInstanced(shape.mode, shape.first, shape.count, static_cast<GLsizei>(count));
+#endif
+}
+
+// Stream and draw vertices of RENDER_STRIDE floats in one go
+inline void drawRenderVertices(Renderer& r, GLenum mode, const float* vertices, size_t count) {
+    setRenderVertices(r, streamRenderArrays(r, vertices, count * RENDER_STRIDE));
+    drawRenderArrays(r, mode, 0, count);
+    endRenderArrays(r);
+}
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * Retained static geometry
+ * Geometry that never changes is recorded once into a mesh of coloured,
+ * optionally textured triangles and uploaded to a vertex buffer object, or
+ * compiled into a display list where buffer objects are missing. Drawing a
+ * mesh then submits no vertices from the CPU at all.
+ */
+
+#ifndef DENGUE_RETAINED_H
+#define DENGUE_RETAINED_H
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <GL/gl.h>
+#elif defined(__APPLE__)
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#include <GL/glx.h>
+#endif
+
+#include <stddef.h>
+#include <vector>
+
+#include "renderer.h"
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+const GLenum MESH_ARRAY_BUFFER = 0x8892; // GL_ARRAY_BUFFER
+const GLenum MESH_STATIC_DRAW = 0x88E4;  // GL_STATIC_DRAW
+const size_t MESH_STRIDE = RENDER_STRIDE; // Floats per vertex: x, y, u, v, r, g, b, a
+
+// Consecutive triangles sharing one texture, 0 for untextured
+struct MeshBatch {
+    GLuint texture;
+    GLint first;
+    GLsizei count;
+};
+
+struct StaticMesh {
+    std::vector<float> vertices;
+    std::vector<MeshBatch> batches;
+    GLuint buffer;  // Vertex buffer object, 0 if none
+    GLuint list;    // Display list when buffer objects are missing, 0 if none
+
+    // Recording state
+    float originX, originY, scale;
+    float color[4];
+    GLuint texture;
+};
+
+enum MeshPath {
+    MESH_CLIENT = 0, // Re-submit the vertices from client memory every draw
+    MESH_BUFFER,     // Vertex buffer objects
+    MESH_LIST        // Display lists
+};
+
+// Vertices drawn from meshes this frame, by whether they crossed the bus again
+struct MeshStats {
+    size_t retainedVertices;
+    size_t submittedVertices;
+};
+
+inline MeshStats& meshStats() {
+    static MeshStats stats = {0, 0};
+    return stats;
+}
+
+typedef void (APIENTRY *GenBuffersProc)(GLsizei, GLuint*);
+typedef void (APIENTRY *DeleteBuffersProc)(GLsizei, const GLuint*);
+typedef void (APIENTRY *BindBufferProc)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataProc)(GLenum, ptrdiff_t, const void*, GLenum);
+
+struct MeshBufferFunctions {
+    GenBuffersProc genBuffers;
+    DeleteBuffersProc deleteBuffers;
+    BindBufferProc bindBuffer;
+    BufferDataProc bufferData;
+};
+
+inline MeshBufferFunctions& meshBufferFunctions() {
+    static MeshBufferFunctions functions = {NULL, NULL, NULL, NULL};
+    return functions;
+}
+
+inline void* meshProcAddress(const char* name) {
+#if defined(_WIN32)
+    return (void*)wglGetProcAddress(name);
+#elif defined(__APPLE__)
+    (void)name;
+    return NULL;
+#else
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+}
+
+// The requested path, or display lists when buffer objects are requested but
+// missing; needs a current context
+inline MeshPath initMeshPath(MeshPath requested) {
+    if(requested != MESH_BUFFER) return requested;
+    MeshBufferFunctions& gl = meshBufferFunctions();
+#if defined(__APPLE__)
+    // Buffer objects are core in every OpenGL the framework ships
+    gl.genBuffers = glGenBuffers;
+    gl.deleteBuffers = glDeleteBuffers;
+    gl.bindBuffer = glBindBuffer;
+    gl.bufferData = (BufferDataProc)glBufferData;
+#else
+    gl.genBuffers = (GenBuffersProc)meshProcAddress("glGenBuffers");
+    gl.deleteBuffers = (DeleteBuffersProc)meshProcAddress("glDeleteBuffers");
+    gl.bindBuffer = (BindBufferProc)meshProcAddress("glBindBuffer");
+    gl.bufferData = (BufferDataProc)meshProcAddress("glBufferData");
+#endif
+    // Entry points can resolve on contexts older than OpenGL 1.5, so check the version too
+    const char* version = (const char*)glGetString(GL_VERSION);
+    bool hasBuffers = version && (version[0] > '1' || (version[0] == '1' && version[2] >= '5'));
+    if(hasBuffers && gl.genBuffers && gl.deleteBuffers && gl.bindBuffer && gl.bufferData) {
+        return MESH_BUFFER;
+    }
+    return MESH_LIST;
+}
+
+inline void clearMesh(StaticMesh& mesh) {
+    mesh.vertices.clear();
+    mesh.batches.clear();
+    mesh.originX = mesh.originY = 0.0f;
+    mesh.scale = 1.0f;
+    mesh.color[0] = mesh.color[1] = mesh.color[2] = mesh.color[3] = 1.0f;
+    mesh.texture = 0;
+}
+
+// Place the following shapes like glTranslatef(x, y) then glScalef(scale)
+inline void meshTransform(StaticMesh& mesh, float x, float y, float scale) {
+    mesh.originX = x;
+    mesh.originY = y;
+    mesh.scale = scale;
+}
+
+inline void meshColor(StaticMesh& mesh, float r, float g, float b, float a = 1.0f) {
+    mesh.color[0] = r;
+    mesh.color[1] = g;
+    mesh.color[2] = b;
+    mesh.color[3] = a;
+}
+
+inline void meshTexture(StaticMesh& mesh, GLuint texture) {
+    mesh.texture = texture;
+}
+
+inline void meshVertex(StaticMesh& mesh, float x, float y, float u = 0.0f, float v = 0.0f) {
+    GLint index = static_cast<GLint>(mesh.vertices.size() / MESH_STRIDE);
+    if(mesh.batches.empty() || mesh.batches.back().texture != mesh.texture) {
+        MeshBatch batch = {mesh.texture, index, 0};
+        mesh.batches.push_back(batch);
+    }
+    mesh.batches.back().count++;
+    const float vertex[MESH_STRIDE] = {mesh.originX + x * mesh.scale, mesh.originY + y * mesh.scale, u, v,
+                                       mesh.color[0], mesh.color[1], mesh.color[2], mesh.color[3]};
+    mesh.vertices.insert(mesh.vertices.end(), vertex, vertex + MESH_STRIDE);
+}
+
+inline void meshTriangle(StaticMesh& mesh, float x0, float y0, float x1, float y1, float x2, float y2) {
+    meshVertex(mesh, x0, y0);
+    meshVertex(mesh, x1, y1);
+    meshVertex(mesh, x2, y2);
+}
+
+// Axis-aligned rectangle, texture coordinates running from (u0, v0) to (u1, v1)
+inline void meshRect(StaticMesh& mesh, float left, float bottom, float right, float top,
+                     float u0 = 0.0f, float v0 = 0.0f, float u1 = 1.0f, float v1 = 1.0f) {
+    meshVertex(mesh, left, bottom, u0, v0);
+    meshVertex(mesh, right, bottom, u1, v0);
+    meshVertex(mesh, right, top, u1, v1);
+    meshVertex(mesh, left, bottom, u0, v0);
+    meshVertex(mesh, right, top, u1, v1);
+    meshVertex(mesh, left, top, u0, v1);
+}
+
+inline size_t meshVertexCount(const StaticMesh& mesh) {
+    return mesh.vertices.size() / MESH_STRIDE;
+}
+
+// Issue the batches with client arrays pointing at base, for compiling display lists
+inline void drawMeshBatches(const StaticMesh& mesh, const float* base) {
+    GLsizei stride = static_cast<GLsizei>(MESH_STRIDE * sizeof(float));
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, stride, base);
+    glTexCoordPointer(2, GL_FLOAT, stride, base + 2);
+    glColorPointer(4, GL_FLOAT, stride, base + 4);
+    for(const MeshBatch& batch : mesh.batches) {
+        if(batch.texture) {
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, batch.texture);
+        } else {
+            glDisable(GL_TEXTURE_2D);
+        }
+        glDrawArrays(GL_TRIANGLES, batch.first, batch.count);
+    }
+    glDisable(GL_TEXTURE_2D);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+// Move a recorded mesh to the GPU; the client copy is kept for the stats and re-uploads
+inline void uploadMesh(StaticMesh& mesh, MeshPath path) {
+    if(mesh.vertices.empty() || path == MESH_CLIENT) return;
+    if(path == MESH_BUFFER) {
+        MeshBufferFunctions& gl = meshBufferFunctions();
+        if(!mesh.buffer) gl.genBuffers(1, &mesh.buffer);
+        gl.bindBuffer(MESH_ARRAY_BUFFER, mesh.buffer);
+        gl.bufferData(MESH_ARRAY_BUFFER, static_cast<ptrdiff_t>(mesh.vertices.size() * sizeof(float)),
+                      mesh.vertices.data(), MESH_STATIC_DRAW);
+        gl.bindBuffer(MESH_ARRAY_BUFFER, 0);
+    } else {
+        // Display lists copy the array contents when they are compiled
+        if(!mesh.list) mesh.list = glGenLists(1);
+        glNewList(mesh.list, GL_COMPILE);
+        drawMeshBatches(mesh, mesh.vertices.data());
+        glEndList();
+    }
+}
+
+// Draws leave the current color undefined, so set it again before immediate-mode
+// drawing. Display lists are legacy only; without a buffer the core backend
+// streams the vertices like any other frame data.
+inline void drawMesh(const StaticMesh& mesh, Renderer& renderer) {
+    if(mesh.vertices.empty()) return;
+    MeshStats& stats = meshStats();
+    if(mesh.list && !mesh.buffer) {
+        glCallList(mesh.list);
+        stats.retainedVertices += meshVertexCount(mesh);
+        return;
+    }
+    if(mesh.buffer) {
+        setRenderVertices(renderer, bufferRenderArrays(mesh.buffer));
+        stats.retainedVertices += meshVertexCount(mesh);
+    } else {
+        setRenderVertices(renderer, streamRenderArrays(renderer, mesh.vertices.data(), mesh.vertices.size()));
+        stats.submittedVertices += meshVertexCount(mesh);
+    }
+    for(const MeshBatch& batch : mesh.batches) {
+        setRenderTexture(renderer, batch.texture, batch.texture ? RENDER_RGBA : RENDER_UNTEXTURED);
+        drawRenderArrays(renderer, GL_TRIANGLES, batch.first, batch.count);
+    }
+    setRenderTexture(renderer, 0, RENDER_UNTEXTURED);
+    endRenderArrays(renderer);
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Lock-free channels between the render and simulation threads
+ * A triple buffer hands complete state snapshots from the simulation to the
+ * renderer, and a single-producer single-consumer ring carries input commands
+ * the other way. Neither side ever blocks or waits for the other.
+ */
+
+#ifndef DENGUE_SIM_CHANNEL_H
+#define DENGUE_SIM_CHANNEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Three slots: the writer fills its back slot and swaps it into the middle,
+// the reader swaps the middle into its front slot when a newer one is there
+template<typename T>
+struct TripleBuffer {
+    static const uint8_t FRESH = 4; // Set on the middle index when it holds an unread snapshot
+
+    T slots[3];
+    std::atomic<uint8_t> middle;
+    uint8_t back;   // Owned by the writer
+    uint8_t front;  // Owned by the reader
+
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    T& writeSlot() { return slots[back]; }
+
+    // Publish the back slot as the newest snapshot
+    void publish() {
+        uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+        back = previous & 3;
+    }
+
+    // Take the newest snapshot if one was published since the last call
+    bool acquireLatest() {
+        if(!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & 3;
+        return true;
+    }
+
+    const T& readSlot() const { return slots[front]; }
+};
+
+// Bounded ring for one producer and one consumer thread; N must be a power of two
+template<typename T, size_t N>
+struct SpscQueue {
+    T items[N];
+    std::atomic<size_t> head; // Next slot to read, written by the consumer
+    std::atomic<size_t> tail; // Next slot to write, written by the producer
+
+    SpscQueue() : head(0), tail(0) {}
+
+    // False when the queue is full
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if(t - head.load(std::memory_order_acquire) == N) return false;
+        items[t & (N - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // False when the queue is empty
+    bool pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if(h == tail.load(std::memory_order_acquire)) return false;
+        item = items[h & (N - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Fixed-timestep simulation clock
+ * Frame time is collected in an accumulator and consumed in whole ticks, so the
+ * simulation advances the same way on any display rate. Rendering interpolates
+ * between the last two ticks using the leftover fraction.
+ */
+
+#ifndef DENGUE_SIM_CLOCK_H
+#define DENGUE_SIM_CLOCK_H
+
+// Rate the original per-frame constants (speeds, wing flaps) were tuned for
+const float SIM_REFERENCE_RATE = 60.0f;
+const int DEFAULT_TICK_RATE = 60;
+
+struct SimClock {
+    int tickRate;          // Ticks per second: 60, 120 or 240
+    float tickDelta;       // Seconds per tick
+    float stepScale;       // Tick length relative to a 60 Hz reference frame
+    float accumulator;     // Frame time not yet consumed by ticks
+    float maxFrameTime;    // Longest frame we catch up on before dropping time
+    unsigned long long tickCount;
+};
+
+inline bool isSupportedTickRate(int rate) {
+    return rate == 60 || rate == 120 || rate == 240;
+}
+
+inline void initSimClock(SimClock& clock, int tickRate) {
+    if(!isSupportedTickRate(tickRate)) tickRate = DEFAULT_TICK_RATE;
+    clock.tickRate = tickRate;
+    clock.tickDelta = 1.0f / tickRate;
+    clock.stepScale = SIM_REFERENCE_RATE / tickRate;
+    clock.accumulator = 0.0f;
+    clock.maxFrameTime = 0.25f;
+    clock.tickCount = 0;
+}
+
+// Add the wall time of one rendered frame
+inline void addFrameTime(SimClock& clock, float frameTime) {
+    if(frameTime < 0.0f) frameTime = 0.0f;
+    // A very long stall (debugger, window drag) is dropped rather than replayed
+    if(frameTime > clock.maxFrameTime) frameTime = clock.maxFrameTime;
+    clock.accumulator += frameTime;
+}
+
+// Take one tick from the accumulator, returns false when not enough time is left
+inline bool consumeTick(SimClock& clock) {
+    if(clock.accumulator < clock.tickDelta) return false;
+    clock.accumulator -= clock.tickDelta;
+    clock.tickCount++;
+    return true;
+}
+
+// Fraction of a tick left over, used to blend the previous and current state
+inline float interpolationAlpha(const SimClock& clock) {
+    float alpha = clock.accumulator / clock.tickDelta;
+    return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+}
+
+inline float lerpState(float previous, float current, float alpha) {
+    return previous + (current - previous) * alpha;
+}
+
+#endif
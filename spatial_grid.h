@@ -0,0 +1,165 @@
+/*
+ * Uniform-grid spatial index
+ * Points and boxes are bucketed into fixed-size cells over the world rectangle
+ * with a counting sort, so a rebuild is two linear passes and point, radius
+ * and nearest-neighbour queries only look at the few cells around the query.
+ */
+
+#ifndef DENGUE_SPATIAL_GRID_H
+#define DENGUE_SPATIAL_GRID_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// An entry waiting for the next build, covering cells [c0, c1] x [r0, r1]
+struct GridItem {
+    uint32_t id;
+    uint16_t c0, r0, c1, r1;
+};
+
+struct SpatialGrid {
+    float minX, minY;
+    float cellSize, invCellSize;
+    int columns, rows;
+    std::vector<GridItem> items;
+    std::vector<uint32_t> cellStart; // Entries of cell c are [cellStart[c], cellStart[c + 1])
+    std::vector<uint32_t> entries;   // Item ids sorted by cell
+    std::vector<uint32_t> cursor;    // Next free entry per cell while building
+};
+
+// Cover [minX, maxX] x [minY, maxY] with square cells; anything outside is
+// clamped into the border cells
+inline void initSpatialGrid(SpatialGrid& grid, float minX, float minY, float maxX, float maxY,
+                            float cellSize) {
+    grid.minX = minX;
+    grid.minY = minY;
+    grid.cellSize = cellSize;
+    grid.invCellSize = 1.0f / cellSize;
+    grid.columns = std::max(1, static_cast<int>(std::ceil((maxX - minX) / cellSize)));
+    grid.rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) / cellSize)));
+    grid.items.clear();
+    grid.entries.clear();
+    grid.cellStart.assign(grid.columns * grid.rows + 1, 0);
+}
+
+inline int gridColumn(const SpatialGrid& grid, float x) {
+    int c = static_cast<int>(std::floor((x - grid.minX) * grid.invCellSize));
+    return std::max(0, std::min(c, grid.columns - 1));
+}
+
+inline int gridRow(const SpatialGrid& grid, float y) {
+    int r = static_cast<int>(std::floor((y - grid.minY) * grid.invCellSize));
+    return std::max(0, std::min(r, grid.rows - 1));
+}
+
+// Start collecting entries for a rebuild
+inline void clearSpatialGrid(SpatialGrid& grid) {
+    grid.items.clear();
+}
+
+inline void addGridPoint(SpatialGrid& grid, uint32_t id, float x, float y) {
+    uint16_t c = static_cast<uint16_t>(gridColumn(grid, x));
+    uint16_t r = static_cast<uint16_t>(gridRow(grid, y));
+    grid.items.push_back({id, c, r, c, r});
+}
+
+inline void addGridBox(SpatialGrid& grid, uint32_t id, float minX, float minY, float maxX, float maxY) {
+    grid.items.push_back({id,
+                          static_cast<uint16_t>(gridColumn(grid, minX)),
+                          static_cast<uint16_t>(gridRow(grid, minY)),
+                          static_cast<uint16_t>(gridColumn(grid, maxX)),
+                          static_cast<uint16_t>(gridRow(grid, maxY))});
+}
+
+// Sort the collected entries into their cells
+inline void buildSpatialGrid(SpatialGrid& grid) {
+    std::vector<uint32_t>& start = grid.cellStart;
+    std::fill(start.begin(), start.end(), 0);
+    for(const GridItem& item : grid.items) {
+        for(int r = item.r0; r <= item.r1; r++) {
+            for(int c = item.c0; c <= item.c1; c++) {
+                start[r * grid.columns + c + 1]++;
+            }
+        }
+    }
+    for(size_t i = 1; i < start.size(); i++) {
+        start[i] += start[i - 1];
+    }
+
+    grid.cursor.assign(start.begin(), start.end() - 1);
+    // Boxes take more than one entry; keep room for every item the caller reserved
+    grid.entries.reserve(start.back() - grid.items.size() + grid.items.capacity());
+    grid.entries.resize(start.back());
+    for(const GridItem& item : grid.items) {
+        for(int r = item.r0; r <= item.r1; r++) {
+            for(int c = item.c0; c <= item.c1; c++) {
+                grid.entries[grid.cursor[r * grid.columns + c]++] = item.id;
+            }
+        }
+    }
+}
+
+// Visit the ids stored in the cell containing (x, y)
+template<typename Visit>
+inline void forEachAtPoint(const SpatialGrid& grid, float x, float y, Visit visit) {
+    int cell = gridRow(grid, y) * grid.columns + gridColumn(grid, x);
+    for(uint32_t e = grid.cellStart[cell]; e < grid.cellStart[cell + 1]; e++) {
+        visit(grid.entries[e]);
+    }
+}
+
+// Visit the ids in every cell overlapping the circle. Boxes spanning several
+// of those cells are visited once per cell; callers test the exact shape.
+template<typename Visit>
+inline void forEachInRadius(const SpatialGrid& grid, float x, float y, float radius, Visit visit) {
+    int c0 = gridColumn(grid, x - radius), c1 = gridColumn(grid, x + radius);
+    int r0 = gridRow(grid, y - radius), r1 = gridRow(grid, y + radius);
+    for(int r = r0; r <= r1; r++) {
+        for(int c = c0; c <= c1; c++) {
+            int cell = r * grid.columns + c;
+            for(uint32_t e = grid.cellStart[cell]; e < grid.cellStart[cell + 1]; e++) {
+                visit(grid.entries[e]);
+            }
+        }
+    }
+}
+
+// Id with the smallest distanceSq(id) within maxRadius of (x, y), or -1.
+// distanceSq returns a negative value for ids that should be skipped.
+// Cells are searched in growing square rings around the query point and the
+// search stops once no unvisited cell can hold anything closer.
+template<typename DistanceSq>
+inline long findNearestInGrid(const SpatialGrid& grid, float x, float y, float maxRadius,
+                              DistanceSq distanceSq) {
+    int cx = gridColumn(grid, x), cy = gridRow(grid, y);
+    int maxRing = std::max(grid.columns, grid.rows);
+    long best = -1;
+    float bestDistanceSq = maxRadius * maxRadius;
+    for(int ring = 0; ring <= maxRing; ring++) {
+        // Everything in this ring or beyond is at least (ring - 1) cells away
+        float reach = std::max(0, ring - 1) * grid.cellSize;
+        if(reach * reach > bestDistanceSq) break;
+
+        for(int r = cy - ring; r <= cy + ring; r++) {
+            if(r < 0 || r >= grid.rows) continue;
+            bool edgeRow = r == cy - ring || r == cy + ring;
+            int step = edgeRow ? 1 : 2 * ring;
+            for(int c = cx - ring; c <= cx + ring; c += step) {
+                if(c < 0 || c >= grid.columns) continue;
+                int cell = r * grid.columns + c;
+                for(uint32_t e = grid.cellStart[cell]; e < grid.cellStart[cell + 1]; e++) {
+                    float d = distanceSq(grid.entries[e]);
+                    if(d >= 0.0f && d <= bestDistanceSq) {
+                        bestDistanceSq = d;
+                        best = grid.entries[e];
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * Mosquito steering
+ * Flocking (separation, alignment, cohesion) and seeking people to bite and
+ * water to breed in, added to the swarm velocities before updateSwarm()
+ * moves it. Neighbours come from a cell list rebuilt every tick: a counting
+ * sort groups the live mosquitoes by cell and copies their positions and
+ * velocities next to each other, so the three cells of a row are one run of
+ * memory. Each mosquito weighs at most maxNeighbors others, which keeps the
+ * cost per mosquito flat however dense the swarm gets.
+ */
+
+#ifndef DENGUE_STEERING_H
+#define DENGUE_STEERING_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "swarm.h"
+#include "worker_pool.h"
+
+const size_t STEERING_BLOCK = 4096; // Sorted mosquitoes per parallel task
+
+struct SteeringTarget {
+    float x, y;
+};
+
+// Per-tick constants. Weights turn each rule into a velocity change per 60 Hz
+// frame; the sum is limited to maxForce and then scaled by step.
+struct SteeringParams {
+    float step;             // Tick length relative to a 60 Hz frame
+    float neighborRadius;   // Flockmates are seen within this distance
+    float separationRadius; // and pushed apart within this one
+    int maxNeighbors;       // Most flockmates weighed per mosquito
+    float separation, alignment, cohesion;
+    float seekHost, seekWater;
+    float seekRadius;       // Hosts and water farther away are not noticed
+    float arriveRadius;     // and closer ones are circled instead of closed in on
+    float cruiseSpeed;      // Speed a seeking mosquito aims for
+    float maxForce;
+    const SteeringTarget* hosts;
+    size_t hostCount;
+    const SteeringTarget* breedingSites;
+    size_t breedingSiteCount;
+};
+
+struct SteeringGrid {
+    float minX, minY;
+    float invCellSize;
+    int columns, rows;
+    size_t count;                    // Live mosquitoes sorted in at the last build
+    std::vector<uint32_t> cellStart; // Sorted mosquitoes of cell c are [cellStart[c], cellStart[c + 1])
+    std::vector<uint32_t> cursor;    // Next free sorted slot per cell while building
+    std::vector<uint32_t> cellOf;    // Cell of each swarm slot, UINT32_MAX when dead
+    std::vector<uint32_t> index;     // Swarm slot of each sorted mosquito
+    std::vector<float> x, y;         // Copied in sorted order
+    std::vector<float> vx, vy;
+};
+
+inline void resizeSteeringGrid(SteeringGrid& grid, size_t capacity) {
+    grid.cellOf.resize(capacity);
+    grid.index.resize(capacity);
+    grid.x.resize(capacity);
+    grid.y.resize(capacity);
+    grid.vx.resize(capacity);
+    grid.vy.resize(capacity);
+}
+
+// Cover [minX, maxX] x [minY, maxY] with cells as wide as the neighbour
+// radius, sized for capacity mosquitoes; anything outside is clamped into the
+// border cells
+inline void initSteeringGrid(SteeringGrid& grid, float minX, float minY, float maxX, float maxY,
+                             float cellSize, size_t capacity) {
+    grid.minX = minX;
+    grid.minY = minY;
+    grid.invCellSize = 1.0f / cellSize;
+    grid.columns = std::max(1, static_cast<int>(std::ceil((maxX - minX) / cellSize)));
+    grid.rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) / cellSize)));
+    grid.count = 0;
+    grid.cellStart.assign(grid.columns * grid.rows + 1, 0);
+    grid.cursor.assign(grid.columns * grid.rows, 0);
+    resizeSteeringGrid(grid, capacity);
+}
+
+inline int steeringColumn(const SteeringGrid& grid, float x) {
+    int c = static_cast<int>(std::floor((x - grid.minX) * grid.invCellSize));
+    return std::max(0, std::min(c, grid.columns - 1));
+}
+
+inline int steeringRow(const SteeringGrid& grid, float y) {
+    int r = static_cast<int>(std::floor((y - grid.minY) * grid.invCellSize));
+    return std::max(0, std::min(r, grid.rows - 1));
+}
+
+// Counting sort of the live mosquitoes into their cells: count, prefix sum,
+// scatter. Only allocates if the swarm outgrew the grid.
+inline void buildSteeringGrid(SteeringGrid& grid, const MosquitoSwarm& swarm) {
+    if(grid.cellOf.size() < swarm.count) resizeSteeringGrid(grid, swarm.capacity);
+
+    std::vector<uint32_t>& start = grid.cellStart;
+    std::fill(start.begin(), start.end(), 0);
+    for(size_t i = 0; i < swarm.count; i++) {
+        if(!isMosquitoAlive(swarm, i)) {
+            grid.cellOf[i] = UINT32_MAX;
+            continue;
+        }
+        uint32_t cell = steeringRow(grid, swarm.y[i]) * grid.columns + steeringColumn(grid, swarm.x[i]);
+        grid.cellOf[i] = cell;
+        start[cell + 1]++;
+    }
+    for(size_t c = 1; c < start.size(); c++) {
+        start[c] += start[c - 1];
+    }
+    grid.count = start.back();
+
+    std::copy(start.begin(), start.end() - 1, grid.cursor.begin());
+    for(size_t i = 0; i < swarm.count; i++) {
+        uint32_t cell = grid.cellOf[i];
+        if(cell == UINT32_MAX) continue;
+        uint32_t k = grid.cursor[cell]++;
+        grid.index[k] = static_cast<uint32_t>(i);
+        grid.x[k] = swarm.x[i];
+        grid.y[k] = swarm.y[i];
+        grid.vx[k] = swarm.vx[i];
+        grid.vy[k] = swarm.vy[i];
+    }
+}
+
+// Steer toward the nearest target within the seek radius at cruising speed,
+// until it is within the arrival radius
+inline void addSeekForce(const SteeringParams& params, const SteeringTarget* targets, size_t count,
+                         float weight, float x, float y, float vx, float vy, float& fx, float& fy) {
+    if(weight == 0.0f) return;
+    const SteeringTarget* nearest = NULL;
+    float nearestSq = params.seekRadius * params.seekRadius;
+    for(size_t t = 0; t < count; t++) {
+        float dx = targets[t].x - x, dy = targets[t].y - y;
+        float d = dx * dx + dy * dy;
+        if(d < nearestSq) {
+            nearestSq = d;
+            nearest = &targets[t];
+        }
+    }
+    if(!nearest || nearestSq < params.arriveRadius * params.arriveRadius) return;
+    float scale = params.cruiseSpeed / std::sqrt(nearestSq);
+    fx += weight * ((nearest->x - x) * scale - vx);
+    fy += weight * ((nearest->y - y) * scale - vy);
+}
+
+// New velocity of sorted mosquito k, from the velocities before this tick
+inline void steerMosquito(const SteeringGrid& grid, const SteeringParams& params, uint32_t k,
+                          float& newVX, float& newVY) {
+    float x = grid.x[k], y = grid.y[k];
+    float vx = grid.vx[k], vy = grid.vy[k];
+    float radiusSq = params.neighborRadius * params.neighborRadius;
+    float separationSq = params.separationRadius * params.separationRadius;
+    float pushX = 0.0f, pushY = 0.0f;
+    float sumVX = 0.0f, sumVY = 0.0f, sumX = 0.0f, sumY = 0.0f;
+    int seen = 0;
+
+    // True once maxNeighbors flockmates were weighed
+    auto visit = [&](uint32_t j) {
+        float dx = x - grid.x[j], dy = y - grid.y[j];
+        float d = dx * dx + dy * dy;
+        // Coincident mosquitoes give no direction to push in
+        if(d >= radiusSq || d == 0.0f) return false;
+        if(d < separationSq) {
+            float inv = 1.0f / d;
+            pushX += dx * inv;
+            pushY += dy * inv;
+        }
+        sumVX += grid.vx[j];
+        sumVY += grid.vy[j];
+        sumX += grid.x[j];
+        sumY += grid.y[j];
+        return ++seen >= params.maxNeighbors;
+    };
+
+    int c = steeringColumn(grid, x), r = steeringRow(grid, y);
+    int c0 = std::max(0, c - 1), c1 = std::min(grid.columns - 1, c + 1);
+    const std::vector<uint32_t>& start = grid.cellStart;
+
+    // Own row first, outward from this mosquito, so the cap does not favour a side
+    uint32_t begin = start[r * grid.columns + c0], end = start[r * grid.columns + c1 + 1];
+    bool full = false;
+    for(uint32_t lo = k, hi = k + 1; !full && (lo > begin || hi < end);) {
+        if(lo > begin) full = visit(--lo);
+        if(!full && hi < end) full = visit(hi++);
+    }
+    // Then the rows below and above, alternately
+    uint32_t below = 0, belowEnd = 0, above = 0, aboveEnd = 0;
+    if(r > 0) {
+        below = start[(r - 1) * grid.columns + c0];
+        belowEnd = start[(r - 1) * grid.columns + c1 + 1];
+    }
+    if(r + 1 < grid.rows) {
+        above = start[(r + 1) * grid.columns + c0];
+        aboveEnd = start[(r + 1) * grid.columns + c1 + 1];
+    }
+    while(!full && (below < belowEnd || above < aboveEnd)) {
+        if(below < belowEnd) full = visit(below++);
+        if(!full && above < aboveEnd) full = visit(above++);
+    }
+
+    float fx = params.separation * pushX, fy = params.separation * pushY;
+    if(seen > 0) {
+        float inv = 1.0f / seen;
+        fx += params.alignment * (sumVX * inv - vx) + params.cohesion * (sumX * inv - x);
+        fy += params.alignment * (sumVY * inv - vy) + params.cohesion * (sumY * inv - y);
+    }
+    addSeekForce(params, params.hosts, params.hostCount, params.seekHost, x, y, vx, vy, fx, fy);
+    addSeekForce(params, params.breedingSites, params.breedingSiteCount, params.seekWater, x, y, vx, vy, fx, fy);
+
+    float forceSq = fx * fx + fy * fy;
+    if(forceSq > params.maxForce * params.maxForce) {
+        float scale = params.maxForce / std::sqrt(forceSq);
+        fx *= scale;
+        fy *= scale;
+    }
+    newVX = vx + fx * params.step;
+    newVY = vy + fy * params.step;
+}
+
+// Steer every mosquito sorted into the grid. Forces only read the sorted
+// copies, so blocks can run on any thread in any order with the same result.
+inline void applySteering(MosquitoSwarm& swarm, const SteeringGrid& grid, const SteeringParams& params,
+                          WorkerPool& pool) {
+    size_t blocks = (grid.count + STEERING_BLOCK - 1) / STEERING_BLOCK;
+    parallelFor(pool, blocks, [&](size_t block) {
+        size_t end = std::min(grid.count, (block + 1) * STEERING_BLOCK);
+        for(size_t k = block * STEERING_BLOCK; k < end; k++) {
+            uint32_t i = grid.index[k];
+            steerMosquito(grid, params, static_cast<uint32_t>(k), swarm.vx[i], swarm.vy[i]);
+        }
+    });
+}
+
+// Rebuild the grid from the swarm and steer it
+inline void steerSwarm(MosquitoSwarm& swarm, SteeringGrid& grid, const SteeringParams& params, WorkerPool& pool) {
+    buildSteeringGrid(grid, swarm);
+    applySteering(swarm, grid, params, pool);
+}
+
+#endif
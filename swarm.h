@@ -0,0 +1,411 @@
+/*
+ * Structure-of-arrays mosquito swarm
+ * Positions, velocities and wing phases live in separate float arrays with a
+ * packed alive bitmask, so one update kernel can move thousands of insects per
+ * call. The SSE2 and AVX2 kernels give bit-identical results to the scalar one.
+ */
+
+#ifndef DENGUE_SWARM_H
+#define DENGUE_SWARM_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SWARM_HAS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// Keep a*b+c as two roundings in every kernel, otherwise a compiler allowed to
+// fuse them into FMA would make the scalar and SIMD results drift apart
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// Lanes are padded to this many floats so the widest kernel never reads past the end
+const size_t SWARM_LANE_PAD = 8;
+
+struct MosquitoSwarm {
+    size_t count;      // Slots in use, alive or dying
+    size_t capacity;   // Slots allocated (multiple of SWARM_LANE_PAD)
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;   // Position at the previous tick
+    std::vector<float> vx, vy;
+    std::vector<float> wing;
+    std::vector<float> jitterX, jitterY; // Random velocity kick for the next tick
+    std::vector<uint64_t> aliveMask;   // Bit i set while mosquito i is alive
+};
+
+// Per-tick constants shared by every kernel
+struct SwarmStepParams {
+    float step;          // Tick length relative to a 60 Hz frame
+    float wingStep;      // Wing angle increment per tick
+    float minX, maxX;
+    float minY, maxY;
+    float bounceDamping; // Speed kept after hitting a wall
+    float maxSpeed;
+};
+
+enum SwarmKernel {
+    SWARM_KERNEL_AUTO = 0,
+    SWARM_KERNEL_SCALAR,
+    SWARM_KERNEL_SSE2,
+    SWARM_KERNEL_AVX2
+};
+
+inline const char* swarmKernelName(SwarmKernel kernel) {
+    switch(kernel) {
+        case SWARM_KERNEL_SCALAR: return "scalar";
+        case SWARM_KERNEL_SSE2: return "sse2";
+        case SWARM_KERNEL_AVX2: return "avx2";
+        default: return "auto";
+    }
+}
+
+inline void resizeSwarm(MosquitoSwarm& swarm, size_t capacity) {
+    capacity = (capacity + SWARM_LANE_PAD - 1) / SWARM_LANE_PAD * SWARM_LANE_PAD;
+    if(capacity == 0) capacity = SWARM_LANE_PAD;
+    swarm.capacity = capacity;
+    swarm.x.resize(capacity, 0.0f);
+    swarm.y.resize(capacity, 0.0f);
+    swarm.prevX.resize(capacity, 0.0f);
+    swarm.prevY.resize(capacity, 0.0f);
+    swarm.vx.resize(capacity, 0.0f);
+    swarm.vy.resize(capacity, 0.0f);
+    swarm.wing.resize(capacity, 0.0f);
+    swarm.jitterX.resize(capacity, 0.0f);
+    swarm.jitterY.resize(capacity, 0.0f);
+    swarm.aliveMask.resize((capacity + 63) / 64, 0);
+}
+
+inline void initSwarm(MosquitoSwarm& swarm, size_t capacity) {
+    swarm.count = 0;
+    swarm.x.clear(); swarm.y.clear();
+    swarm.prevX.clear(); swarm.prevY.clear();
+    swarm.vx.clear(); swarm.vy.clear();
+    swarm.wing.clear();
+    swarm.jitterX.clear(); swarm.jitterY.clear();
+    swarm.aliveMask.clear();
+    resizeSwarm(swarm, capacity);
+}
+
+inline void clearSwarm(MosquitoSwarm& swarm) {
+    swarm.count = 0;
+    std::fill(swarm.aliveMask.begin(), swarm.aliveMask.end(), 0);
+}
+
+inline bool isMosquitoAlive(const MosquitoSwarm& swarm, size_t i) {
+    return (swarm.aliveMask[i >> 6] >> (i & 63)) & 1;
+}
+
+inline void killMosquito(MosquitoSwarm& swarm, size_t i) {
+    swarm.aliveMask[i >> 6] &= ~(uint64_t(1) << (i & 63));
+}
+
+// Add a live mosquito, returns false when the swarm is full
+inline bool addMosquito(MosquitoSwarm& swarm, float x, float y, float vx, float vy) {
+    if(swarm.count >= swarm.capacity) return false;
+    size_t i = swarm.count++;
+    swarm.x[i] = x;
+    swarm.y[i] = y;
+    swarm.prevX[i] = x;
+    swarm.prevY[i] = y;
+    swarm.vx[i] = vx;
+    swarm.vy[i] = vy;
+    swarm.wing[i] = 0.0f;
+    swarm.jitterX[i] = 0.0f;
+    swarm.jitterY[i] = 0.0f;
+    swarm.aliveMask[i >> 6] |= uint64_t(1) << (i & 63);
+    return true;
+}
+
+// Starting positions and velocities of a swarm, copied in by resetSwarm()
+struct SwarmLayout {
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+};
+
+inline void addLayoutMosquito(SwarmLayout& layout, float x, float y, float vx, float vy) {
+    layout.x.push_back(x);
+    layout.y.push_back(y);
+    layout.vx.push_back(vx);
+    layout.vy.push_back(vy);
+}
+
+// Replace every mosquito with the live ones of a layout, as many as fit;
+// copies into the allocated slots only, so nothing is allocated
+inline void resetSwarm(MosquitoSwarm& swarm, const SwarmLayout& layout) {
+    size_t count = std::min(layout.x.size(), swarm.capacity);
+    size_t bytes = count * sizeof(float);
+    if(count > 0) {
+        memcpy(swarm.x.data(), layout.x.data(), bytes);
+        memcpy(swarm.y.data(), layout.y.data(), bytes);
+        memcpy(swarm.prevX.data(), layout.x.data(), bytes);
+        memcpy(swarm.prevY.data(), layout.y.data(), bytes);
+        memcpy(swarm.vx.data(), layout.vx.data(), bytes);
+        memcpy(swarm.vy.data(), layout.vy.data(), bytes);
+    }
+    std::fill(swarm.wing.begin(), swarm.wing.begin() + count, 0.0f);
+    std::fill(swarm.jitterX.begin(), swarm.jitterX.begin() + count, 0.0f);
+    std::fill(swarm.jitterY.begin(), swarm.jitterY.begin() + count, 0.0f);
+    for(size_t w = 0; w < swarm.aliveMask.size(); w++) {
+        size_t first = w * 64;
+        if(first + 64 <= count) swarm.aliveMask[w] = ~uint64_t(0);
+        else if(first < count) swarm.aliveMask[w] = (uint64_t(1) << (count - first)) - 1;
+        else swarm.aliveMask[w] = 0;
+    }
+    swarm.count = count;
+}
+
+inline size_t countAliveMosquitoes(const MosquitoSwarm& swarm) {
+    size_t alive = 0;
+    for(uint64_t word : swarm.aliveMask) {
+        alive += __builtin_popcountll(word);
+    }
+    return alive;
+}
+
+// First alive mosquito at or after index start, or -1
+inline long findAliveMosquito(const MosquitoSwarm& swarm, size_t start) {
+    for(size_t w = start >> 6; w < swarm.aliveMask.size(); w++) {
+        uint64_t word = swarm.aliveMask[w];
+        if(w == (start >> 6)) word &= ~uint64_t(0) << (start & 63);
+        if(word) {
+            size_t i = w * 64 + __builtin_ctzll(word);
+            return i < swarm.count ? static_cast<long>(i) : -1;
+        }
+    }
+    return -1;
+}
+
+// Drop dead mosquitoes, keeping the order of the survivors
+inline void compactSwarm(MosquitoSwarm& swarm) {
+    size_t out = 0;
+    for(size_t i = 0; i < swarm.count; i++) {
+        if(!isMosquitoAlive(swarm, i)) continue;
+        if(out != i) {
+            swarm.x[out] = swarm.x[i];
+            swarm.y[out] = swarm.y[i];
+            swarm.prevX[out] = swarm.prevX[i];
+            swarm.prevY[out] = swarm.prevY[i];
+            swarm.vx[out] = swarm.vx[i];
+            swarm.vy[out] = swarm.vy[i];
+            swarm.wing[out] = swarm.wing[i];
+            swarm.jitterX[out] = swarm.jitterX[i];
+            swarm.jitterY[out] = swarm.jitterY[i];
+        }
+        out++;
+    }
+    swarm.count = out;
+    std::fill(swarm.aliveMask.begin(), swarm.aliveMask.end(), 0);
+    for(size_t w = 0; w < out / 64; w++) swarm.aliveMask[w] = ~uint64_t(0);
+    if(out & 63) swarm.aliveMask[out / 64] = (uint64_t(1) << (out & 63)) - 1;
+}
+
+// Copy the current positions into the previous-tick arrays
+inline void saveSwarmState(MosquitoSwarm& swarm) {
+    memcpy(swarm.prevX.data(), swarm.x.data(), swarm.count * sizeof(float));
+    memcpy(swarm.prevY.data(), swarm.y.data(), swarm.count * sizeof(float));
+}
+
+// Scalar reference kernel: integrate, bounce, jitter and clamp lanes [begin, end)
+inline void updateSwarmScalar(MosquitoSwarm& swarm, const SwarmStepParams& p,
+                              size_t begin, size_t end) {
+    for(size_t i = begin; i < end; i++) {
+        if(!isMosquitoAlive(swarm, i)) continue;
+
+        float x = swarm.x[i] + swarm.vx[i] * p.step;
+        float y = swarm.y[i] + swarm.vy[i] * p.step;
+        float vx = swarm.vx[i];
+        float vy = swarm.vy[i];
+        swarm.wing[i] += p.wingStep;
+
+        // Bounce off boundaries with smooth deceleration
+        if(x < p.minX || x > p.maxX) {
+            vx = -vx * p.bounceDamping;
+            x = x < p.minX ? p.minX : p.maxX;
+        }
+        if(y < p.minY || y > p.maxY) {
+            vy = -vy * p.bounceDamping;
+            y = y < p.minY ? p.minY : p.maxY;
+        }
+
+        vx += swarm.jitterX[i];
+        vy += swarm.jitterY[i];
+
+        // Limit maximum speed
+        float speed = sqrtf(vx * vx + vy * vy);
+        if(speed > p.maxSpeed) {
+            vx = (vx / speed) * p.maxSpeed;
+            vy = (vy / speed) * p.maxSpeed;
+        }
+
+        swarm.x[i] = x;
+        swarm.y[i] = y;
+        swarm.vx[i] = vx;
+        swarm.vy[i] = vy;
+    }
+}
+
+#ifdef SWARM_HAS_X86_KERNELS
+
+__attribute__((target("sse2")))
+inline __m128 swarmSelect4(__m128 mask, __m128 a, __m128 b) {
+    // mask ? b : a
+    return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+inline void updateSwarmSSE2(MosquitoSwarm& swarm, const SwarmStepParams& p,
+                            size_t begin, size_t end) {
+    const __m128 step = _mm_set1_ps(p.step);
+    const __m128 wingStep = _mm_set1_ps(p.wingStep);
+    const __m128 minX = _mm_set1_ps(p.minX), maxX = _mm_set1_ps(p.maxX);
+    const __m128 minY = _mm_set1_ps(p.minY), maxY = _mm_set1_ps(p.maxY);
+    const __m128 damping = _mm_set1_ps(p.bounceDamping);
+    const __m128 maxSpeed = _mm_set1_ps(p.maxSpeed);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128i laneBits = _mm_set_epi32(8, 4, 2, 1);
+
+    for(size_t i = begin; i < end; i += 4) {
+        unsigned bits = (swarm.aliveMask[i >> 6] >> (i & 63)) & 0xF;
+        if(!bits) continue;
+        __m128 alive = _mm_castsi128_ps(_mm_cmpeq_epi32(
+            _mm_and_si128(_mm_set1_epi32(bits), laneBits), laneBits));
+
+        __m128 x0 = _mm_loadu_ps(&swarm.x[i]);
+        __m128 y0 = _mm_loadu_ps(&swarm.y[i]);
+        __m128 vx0 = _mm_loadu_ps(&swarm.vx[i]);
+        __m128 vy0 = _mm_loadu_ps(&swarm.vy[i]);
+        __m128 wing0 = _mm_loadu_ps(&swarm.wing[i]);
+
+        __m128 x = _mm_add_ps(x0, _mm_mul_ps(vx0, step));
+        __m128 y = _mm_add_ps(y0, _mm_mul_ps(vy0, step));
+        __m128 wing = _mm_add_ps(wing0, wingStep);
+
+        __m128 belowX = _mm_cmplt_ps(x, minX);
+        __m128 outX = _mm_or_ps(belowX, _mm_cmpgt_ps(x, maxX));
+        __m128 vx = swarmSelect4(outX, vx0, _mm_mul_ps(_mm_xor_ps(vx0, signBit), damping));
+        x = swarmSelect4(outX, x, swarmSelect4(belowX, maxX, minX));
+
+        __m128 belowY = _mm_cmplt_ps(y, minY);
+        __m128 outY = _mm_or_ps(belowY, _mm_cmpgt_ps(y, maxY));
+        __m128 vy = swarmSelect4(outY, vy0, _mm_mul_ps(_mm_xor_ps(vy0, signBit), damping));
+        y = swarmSelect4(outY, y, swarmSelect4(belowY, maxY, minY));
+
+        vx = _mm_add_ps(vx, _mm_loadu_ps(&swarm.jitterX[i]));
+        vy = _mm_add_ps(vy, _mm_loadu_ps(&swarm.jitterY[i]));
+
+        __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+        __m128 tooFast = _mm_cmpgt_ps(speed, maxSpeed);
+        vx = swarmSelect4(tooFast, vx, _mm_mul_ps(_mm_div_ps(vx, speed), maxSpeed));
+        vy = swarmSelect4(tooFast, vy, _mm_mul_ps(_mm_div_ps(vy, speed), maxSpeed));
+
+        _mm_storeu_ps(&swarm.x[i], swarmSelect4(alive, x0, x));
+        _mm_storeu_ps(&swarm.y[i], swarmSelect4(alive, y0, y));
+        _mm_storeu_ps(&swarm.vx[i], swarmSelect4(alive, vx0, vx));
+        _mm_storeu_ps(&swarm.vy[i], swarmSelect4(alive, vy0, vy));
+        _mm_storeu_ps(&swarm.wing[i], swarmSelect4(alive, wing0, wing));
+    }
+}
+
+__attribute__((target("avx2")))
+inline void updateSwarmAVX2(MosquitoSwarm& swarm, const SwarmStepParams& p,
+                            size_t begin, size_t end) {
+    const __m256 step = _mm256_set1_ps(p.step);
+    const __m256 wingStep = _mm256_set1_ps(p.wingStep);
+    const __m256 minX = _mm256_set1_ps(p.minX), maxX = _mm256_set1_ps(p.maxX);
+    const __m256 minY = _mm256_set1_ps(p.minY), maxY = _mm256_set1_ps(p.maxY);
+    const __m256 damping = _mm256_set1_ps(p.bounceDamping);
+    const __m256 maxSpeed = _mm256_set1_ps(p.maxSpeed);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256i laneBits = _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+
+    for(size_t i = begin; i < end; i += 8) {
+        unsigned bits = (swarm.aliveMask[i >> 6] >> (i & 63)) & 0xFF;
+        if(!bits) continue;
+        __m256 alive = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+            _mm256_and_si256(_mm256_set1_epi32(bits), laneBits), laneBits));
+
+        __m256 x0 = _mm256_loadu_ps(&swarm.x[i]);
+        __m256 y0 = _mm256_loadu_ps(&swarm.y[i]);
+        __m256 vx0 = _mm256_loadu_ps(&swarm.vx[i]);
+        __m256 vy0 = _mm256_loadu_ps(&swarm.vy[i]);
+        __m256 wing0 = _mm256_loadu_ps(&swarm.wing[i]);
+
+        __m256 x = _mm256_add_ps(x0, _mm256_mul_ps(vx0, step));
+        __m256 y = _mm256_add_ps(y0, _mm256_mul_ps(vy0, step));
+        __m256 wing = _mm256_add_ps(wing0, wingStep);
+
+        __m256 belowX = _mm256_cmp_ps(x, minX, _CMP_LT_OQ);
+        __m256 outX = _mm256_or_ps(belowX, _mm256_cmp_ps(x, maxX, _CMP_GT_OQ));
+        __m256 vx = _mm256_blendv_ps(vx0, _mm256_mul_ps(_mm256_xor_ps(vx0, signBit), damping), outX);
+        x = _mm256_blendv_ps(x, _mm256_blendv_ps(maxX, minX, belowX), outX);
+
+        __m256 belowY = _mm256_cmp_ps(y, minY, _CMP_LT_OQ);
+        __m256 outY = _mm256_or_ps(belowY, _mm256_cmp_ps(y, maxY, _CMP_GT_OQ));
+        __m256 vy = _mm256_blendv_ps(vy0, _mm256_mul_ps(_mm256_xor_ps(vy0, signBit), damping), outY);
+        y = _mm256_blendv_ps(y, _mm256_blendv_ps(maxY, minY, belowY), outY);
+
+        vx = _mm256_add_ps(vx, _mm256_loadu_ps(&swarm.jitterX[i]));
+        vy = _mm256_add_ps(vy, _mm256_loadu_ps(&swarm.jitterY[i]));
+
+        __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+        __m256 tooFast = _mm256_cmp_ps(speed, maxSpeed, _CMP_GT_OQ);
+        vx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_div_ps(vx, speed), maxSpeed), tooFast);
+        vy = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_div_ps(vy, speed), maxSpeed), tooFast);
+
+        _mm256_storeu_ps(&swarm.x[i], _mm256_blendv_ps(x0, x, alive));
+        _mm256_storeu_ps(&swarm.y[i], _mm256_blendv_ps(y0, y, alive));
+        _mm256_storeu_ps(&swarm.vx[i], _mm256_blendv_ps(vx0, vx, alive));
+        _mm256_storeu_ps(&swarm.vy[i], _mm256_blendv_ps(vy0, vy, alive));
+        _mm256_storeu_ps(&swarm.wing[i], _mm256_blendv_ps(wing0, wing, alive));
+    }
+}
+
+#endif
+
+// Best kernel the CPU supports, or the requested one if it is available
+inline SwarmKernel resolveSwarmKernel(SwarmKernel requested) {
+#ifdef SWARM_HAS_X86_KERNELS
+    bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if(requested == SWARM_KERNEL_AVX2 && !hasAVX2) requested = SWARM_KERNEL_AUTO;
+    if(requested != SWARM_KERNEL_AUTO) return requested;
+    return hasAVX2 ? SWARM_KERNEL_AVX2 : SWARM_KERNEL_SSE2;
+#else
+    (void)requested;
+    return SWARM_KERNEL_SCALAR;
+#endif
+}
+
+// Advance every slot of the swarm by one tick with the given kernel
+inline void updateSwarm(MosquitoSwarm& swarm, const SwarmStepParams& params, SwarmKernel kernel) {
+    // Slots are padded, so the SIMD kernels can run over whole lane groups
+    size_t end = (swarm.count + SWARM_LANE_PAD - 1) / SWARM_LANE_PAD * SWARM_LANE_PAD;
+    switch(kernel) {
+#ifdef SWARM_HAS_X86_KERNELS
+        case SWARM_KERNEL_AVX2:
+            updateSwarmAVX2(swarm, params, 0, end);
+            break;
+        case SWARM_KERNEL_SSE2:
+            updateSwarmSSE2(swarm, params, 0, end);
+            break;
+#endif
+        default:
+            updateSwarmScalar(swarm, params, 0, swarm.count);
+            break;
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,272 @@
+/*
+ * Glyph atlas text renderer
+ * Each embedded bitmap font is rasterized once into a shared coverage texture. Strings
+ * are laid out into glyph quads the first time they are seen and cached, and
+ * all text queued during a frame is drawn with a single textured draw call.
+ */
+
+#ifndef DENGUE_TEXT_ATLAS_H
+#define DENGUE_TEXT_ATLAS_H
+
+#include <stdint.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "bitmap_fonts.h"
+#include "renderer.h"
+
+enum TextFont {
+    FONT_HELVETICA_12 = 0,
+    FONT_HELVETICA_18,
+    FONT_COUNT
+};
+
+const int GLYPH_FIRST = 32;
+const int GLYPH_LAST = 126;
+const int TEXT_ATLAS_WIDTH = 256;
+const GLint TEXT_ATLAS_R8 = 0x8229; // GL_R8
+const size_t TEXT_SCRATCH_CHARS = 256;  // Longest uncached string laid out without allocating
+const size_t TEXT_BATCH_GLYPHS = 2048;  // Glyphs queued per frame without allocating
+
+struct Glyph {
+    int atlasX, atlasY; // Lower-left corner of the glyph cell in the atlas
+    int advance;        // Pen advance in pixels, also the cell width
+};
+
+struct FontFace {
+    const BitmapFont* bitmaps;
+    int cellHeight;     // Twice the font height, with the baseline in the middle
+    int baseline;       // Baseline offset from the bottom of the cell
+    Glyph glyphs[GLYPH_LAST + 1];
+};
+
+// A string laid out in pixels relative to its raster position
+struct TextLayout {
+    std::string text;
+    TextFont font;
+    int width;
+    std::vector<float> quads; // Per glyph: x0, y0, x1, y1, u0, v0, u1, v1
+};
+
+struct TextAtlas {
+    bool ready;
+    GLuint texture;
+    int width, height;
+    FontFace fonts[FONT_COUNT];
+    std::unordered_map<uint64_t, TextLayout> layouts;
+    TextLayout scratch;       // Reused for strings that are not cached
+    std::vector<float> batch; // Glyph triangles, RENDER_STRIDE floats per vertex
+    // World to pixel mapping for the current frame
+    float left, bottom;
+    float unitsPerPixelX, unitsPerPixelY;
+};
+
+inline const BitmapFont& bitmapFontFor(TextFont font) {
+    return font == FONT_HELVETICA_18 ? BITMAP_HELVETICA_18 : BITMAP_HELVETICA_12;
+}
+
+// Pen advance of a character, unprintable ones drawn as '?'
+inline int glyphAdvance(const BitmapFont& font, int code) {
+    if(code < GLYPH_FIRST || code > GLYPH_LAST) code = '?';
+    return font.glyphs[code - BITMAP_GLYPH_FIRST].width;
+}
+
+// Line height of the Helvetica fonts, as GLUT spaces them
+inline int fontLineHeight(TextFont font) {
+    return font == FONT_HELVETICA_18 ? 22 : 15;
+}
+
+// Lay out every glyph in rows of TEXT_ATLAS_WIDTH pixels, returns the atlas height
+inline int layoutGlyphCells(TextAtlas& atlas) {
+    int x = 0, y = 0;
+    for(int f = 0; f < FONT_COUNT; f++) {
+        FontFace& face = atlas.fonts[f];
+        face.bitmaps = &bitmapFontFor(static_cast<TextFont>(f));
+        face.cellHeight = fontLineHeight(static_cast<TextFont>(f)) * 2;
+        face.baseline = face.cellHeight / 4;
+        if(x > 0) { x = 0; y += atlas.fonts[f - 1].cellHeight; }
+        for(int c = GLYPH_FIRST; c <= GLYPH_LAST; c++) {
+            Glyph& glyph = face.glyphs[c];
+            glyph.advance = glyphAdvance(*face.bitmaps, c);
+            if(x + glyph.advance + 1 > TEXT_ATLAS_WIDTH) { x = 0; y += face.cellHeight; }
+            glyph.atlasX = x;
+            glyph.atlasY = y;
+            x += glyph.advance + 1;
+        }
+    }
+    return y + atlas.fonts[FONT_COUNT - 1].cellHeight;
+}
+
+// Rasterize the embedded fonts into a coverage texture, each glyph with its
+// baseline at the cell's baseline as glBitmap would place it. Needs no display
+// connection and no fixed-function state, so it works in every context.
+inline void buildTextAtlas(TextAtlas& atlas, const Renderer& renderer) {
+    atlas.width = TEXT_ATLAS_WIDTH;
+    int used = layoutGlyphCells(atlas);
+    atlas.height = 1;
+    while(atlas.height < used) atlas.height *= 2;
+
+    std::vector<unsigned char> pixels(atlas.width * atlas.height, 0);
+    for(int f = 0; f < FONT_COUNT; f++) {
+        const FontFace& face = atlas.fonts[f];
+        const BitmapFont& font = *face.bitmaps;
+        for(int c = GLYPH_FIRST; c <= GLYPH_LAST; c++) {
+            const Glyph& glyph = face.glyphs[c];
+            const BitmapGlyph& bitmap = font.glyphs[c - BITMAP_GLYPH_FIRST];
+            int bottom = glyph.atlasY + face.baseline - font.descent;
+            for(int y = 0; y < font.height; y++) {
+                int row = bottom + y;
+                if(row < glyph.atlasY || row >= glyph.atlasY + face.cellHeight) continue;
+                for(int x = 0; x < bitmap.width; x++) {
+                    if(bitmapGlyphPixel(font, bitmap, x, y)) pixels[row * atlas.width + glyph.atlasX + x] = 255;
+                }
+            }
+        }
+    }
+
+    if(!atlas.texture) glGenTextures(1, &atlas.texture);
+    glBindTexture(GL_TEXTURE_2D, atlas.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // Core profiles have no alpha textures, so the shaders read coverage from red
+    GLint internalFormat = renderer.backend == RENDER_GL33 ? TEXT_ATLAS_R8 : GL_ALPHA;
+    GLenum format = renderer.backend == RENDER_GL33 ? GL_RED : GL_ALPHA;
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, atlas.width, atlas.height, 0,
+                 format, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Uncached strings change every frame, so their buffers are sized up front
+    atlas.scratch.text.reserve(TEXT_SCRATCH_CHARS);
+    atlas.scratch.quads.reserve(TEXT_SCRATCH_CHARS * 8);
+    atlas.batch.reserve(TEXT_BATCH_GLYPHS * 6 * RENDER_STRIDE);
+    atlas.layouts.clear();
+    atlas.ready = true;
+}
+
+// Set the mapping from world coordinates to window pixels for this frame
+inline void beginTextFrame(TextAtlas& atlas, float left, float right, float bottom, float top,
+                           int windowWidth, int windowHeight) {
+    atlas.left = left;
+    atlas.bottom = bottom;
+    atlas.unitsPerPixelX = (right - left) / windowWidth;
+    atlas.unitsPerPixelY = (top - bottom) / windowHeight;
+    atlas.batch.clear();
+}
+
+inline uint64_t hashText(TextFont font, const char* text) {
+    uint64_t hash = 14695981039346656037ULL ^ static_cast<uint64_t>(font);
+    for(const char* c = text; *c; ++c) {
+        hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Lay out a string into glyph quads
+inline void buildTextLayout(TextAtlas& atlas, TextLayout& layout, TextFont font, const char* text) {
+    layout.text = text;
+    layout.font = font;
+    layout.quads.clear();
+    const FontFace& face = atlas.fonts[font];
+    float invW = 1.0f / atlas.width, invH = 1.0f / atlas.height;
+    int pen = 0;
+    for(const char* c = text; *c; ++c) {
+        int code = static_cast<unsigned char>(*c);
+        if(code < GLYPH_FIRST || code > GLYPH_LAST) code = '?';
+        const Glyph& glyph = face.glyphs[code];
+        float quad[8] = {
+            static_cast<float>(pen), static_cast<float>(-face.baseline),
+            static_cast<float>(pen + glyph.advance), static_cast<float>(face.cellHeight - face.baseline),
+            glyph.atlasX * invW, glyph.atlasY * invH,
+            (glyph.atlasX + glyph.advance) * invW, (glyph.atlasY + face.cellHeight) * invH
+        };
+        layout.quads.insert(layout.quads.end(), quad, quad + 8);
+        pen += glyph.advance;
+    }
+    layout.width = pen;
+}
+
+// Cached layout for a string, built on first use
+inline const TextLayout& layoutText(TextAtlas& atlas, TextFont font, const char* text) {
+    uint64_t key = hashText(font, text);
+    auto it = atlas.layouts.find(key);
+    if(it != atlas.layouts.end() && it->second.font == font && it->second.text == text) {
+        return it->second;
+    }
+
+    TextLayout& layout = atlas.layouts[key];
+    buildTextLayout(atlas, layout, font, text);
+    return layout;
+}
+
+// Width of a string in world units
+inline float measureText(TextAtlas& atlas, TextFont font, const char* text) {
+    if(!atlas.ready) {
+        // Before the atlas exists the advances come straight from the font
+        int width = 0;
+        for(const char* c = text; *c; ++c) {
+            width += glyphAdvance(bitmapFontFor(font), static_cast<unsigned char>(*c));
+        }
+        return width * atlas.unitsPerPixelX;
+    }
+    return layoutText(atlas, font, text).width * atlas.unitsPerPixelX;
+}
+
+// Append the glyph quads of a laid out string at raster position (x, y), as two triangles each
+inline void queueTextLayout(TextAtlas& atlas, const TextLayout& layout, float x, float y,
+                            float r, float g, float b) {
+    // Snap the origin to a whole pixel, as glBitmap does, so glyphs map 1:1
+    float px = floorf((x - atlas.left) / atlas.unitsPerPixelX);
+    float py = floorf((y - atlas.bottom) / atlas.unitsPerPixelY);
+    for(size_t i = 0; i < layout.quads.size(); i += 8) {
+        const float* q = &layout.quads[i];
+        float x0 = atlas.left + (px + q[0]) * atlas.unitsPerPixelX;
+        float y0 = atlas.bottom + (py + q[1]) * atlas.unitsPerPixelY;
+        float x1 = atlas.left + (px + q[2]) * atlas.unitsPerPixelX;
+        float y1 = atlas.bottom + (py + q[3]) * atlas.unitsPerPixelY;
+        float corners[6][4] = {
+            {x0, y0, q[4], q[5]}, {x1, y0, q[6], q[5]}, {x1, y1, q[6], q[7]},
+            {x0, y0, q[4], q[5]}, {x1, y1, q[6], q[7]}, {x0, y1, q[4], q[7]}
+        };
+        for(int v = 0; v < 6; v++) {
+            float vertex[RENDER_STRIDE] = {corners[v][0], corners[v][1], corners[v][2], corners[v][3],
+                                           r, g, b, 1.0f};
+            atlas.batch.insert(atlas.batch.end(), vertex, vertex + RENDER_STRIDE);
+        }
+    }
+}
+
+// Queue a string with its baseline starting at (x, y), like glRasterPos2f
+inline void drawText(TextAtlas& atlas, TextFont font, float x, float y, const char* text,
+                     float r, float g, float b) {
+    if(!atlas.ready) return;
+    queueTextLayout(atlas, layoutText(atlas, font, text), x, y, r, g, b);
+}
+
+// Like drawText, for strings that change every frame (counters, timings) and
+// would otherwise fill the layout cache
+inline void drawTextUncached(TextAtlas& atlas, TextFont font, float x, float y, const char* text,
+                             float r, float g, float b) {
+    if(!atlas.ready) return;
+    buildTextLayout(atlas, atlas.scratch, font, text);
+    queueTextLayout(atlas, atlas.scratch, x, y, r, g, b);
+}
+
+// Draw the text queued after the first floats of the batch, keeping what came before
+inline void flushTextFrom(TextAtlas& atlas, Renderer& renderer, size_t first) {
+    if(!atlas.ready || atlas.batch.size() <= first) return;
+    setRenderTexture(renderer, atlas.texture, RENDER_COVERAGE);
+    drawRenderVertices(renderer, GL_TRIANGLES, atlas.batch.data() + first,
+                       (atlas.batch.size() - first) / RENDER_STRIDE);
+    setRenderTexture(renderer, 0, RENDER_UNTEXTURED);
+    atlas.batch.resize(first);
+}
+
+// Draw all text queued this frame in one call
+inline void flushText(TextAtlas& atlas, Renderer& renderer) {
+    flushTextFrom(atlas, renderer, 0);
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Asset packer
+ * Converts PNG (when built with libpng) and binary PPM images into one asset
+ * archive of mipmapped textures that the application maps at startup. Each
+ * image is named after its file, without the directory and extension.
+ *
+ * Usage: asset_packer [--compress] <archive> <image>...
+ *   --compress  store opaque images as BC1 blocks, an eighth of their RGBA size
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifdef DENGUE_HAS_PNG
+#include <png.h>
+#endif
+
+#include "../asset_archive.h"
+
+// File name without its directory and extension
+static std::string assetName(const char* path) {
+    std::string name = path;
+    size_t slash = name.find_last_of("/\\");
+    if(slash != std::string::npos) name = name.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if(dot != std::string::npos && dot > 0) name = name.substr(0, dot);
+    return name;
+}
+
+// Next whitespace-separated number of a PPM header, skipping comments
+static bool readPpmNumber(FILE* file, int& value) {
+    int c = fgetc(file);
+    while(c == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        if(c == '#') {
+            while(c != '\n' && c != EOF) c = fgetc(file);
+        }
+        c = fgetc(file);
+    }
+    if(c < '0' || c > '9') return false;
+    value = 0;
+    while(c >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+        if(value > 65536) return false;
+        c = fgetc(file);
+    }
+    return true; // The single whitespace after the number is consumed
+}
+
+static bool loadPpm(const char* path, AssetImage& image) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+    int maxValue = 0;
+    bool ok = fgetc(file) == 'P' && fgetc(file) == '6' && readPpmNumber(file, image.width) &&
+              readPpmNumber(file, image.height) && readPpmNumber(file, maxValue) && maxValue == 255 &&
+              image.width > 0 && image.height > 0;
+    if(ok) {
+        size_t texels = static_cast<size_t>(image.width) * image.height;
+        std::vector<unsigned char> rgb(texels * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+        image.rgba.resize(texels * 4);
+        for(size_t i = 0; ok && i < texels; i++) {
+            memcpy(&image.rgba[i * 4], &rgb[i * 3], 3);
+            image.rgba[i * 4 + 3] = 255;
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+#ifdef DENGUE_HAS_PNG
+static bool loadPng(const char* path, AssetImage& image) {
+    png_image png;
+    memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+    if(!png_image_begin_read_from_file(&png, path)) return false;
+    png.format = PNG_FORMAT_RGBA;
+    image.width = static_cast<int>(png.width);
+    image.height = static_cast<int>(png.height);
+    image.rgba.resize(PNG_IMAGE_SIZE(png));
+    // Bottom row first, as OpenGL expects
+    bool ok = png_image_finish_read(&png, NULL, image.rgba.data(), -static_cast<png_int_32>(PNG_IMAGE_ROW_STRIDE(png)),
+                                    NULL) != 0;
+    png_image_free(&png);
+    return ok;
+}
+#endif
+
+static bool loadImage(const char* path, AssetImage& image) {
+    image.name = assetName(path);
+    size_t length = strlen(path);
+    if(length > 4 && strcmp(path + length - 4, ".png") == 0) {
+#ifdef DENGUE_HAS_PNG
+        return loadPng(path, image);
+#else
+        fprintf(stderr, "asset_packer: built without libpng, convert %s to PPM\n", path);
+        return false;
+#endif
+    }
+    if(!loadPpm(path, image)) return false;
+
+    // PPM rows run top to bottom, OpenGL's bottom to top
+    size_t rowBytes = static_cast<size_t>(image.width) * 4;
+    std::vector<unsigned char> row(rowBytes);
+    for(int y = 0; y < image.height / 2; y++) {
+        unsigned char* top = &image.rgba[y * rowBytes];
+        unsigned char* bottom = &image.rgba[(image.height - 1 - y) * rowBytes];
+        memcpy(row.data(), top, rowBytes);
+        memcpy(top, bottom, rowBytes);
+        memcpy(bottom, row.data(), rowBytes);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    bool compress = false;
+    int first = 1;
+    if(first < argc && strcmp(argv[first], "--compress") == 0) {
+        compress = true;
+        first++;
+    }
+    if(argc - first < 2) {
+        fprintf(stderr, "usage: %s [--compress] <archive> <image>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char* archivePath = argv[first];
+    std::vector<AssetImage> images(argc - first - 1);
+    for(int i = first + 1; i < argc; i++) {
+        AssetImage& image = images[i - first - 1];
+        if(!loadImage(argv[i], image)) {
+            fprintf(stderr, "asset_packer: cannot read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(!writeAssetArchive(archivePath, images, compress)) return EXIT_FAILURE;
+
+    AssetArchive archive;
+    if(!openAssetArchive(archive, archivePath)) return EXIT_FAILURE;
+    for(uint32_t i = 0; i < archive.count; i++) {
+        const AssetEntry& entry = archive.entries[i];
+        printf("%-24s %4ux%-4u %2u levels  %-5s %8llu bytes\n", entry.name, entry.width, entry.height, entry.levels,
+               entry.format == ASSET_BC1 ? "BC1" : "RGBA8", static_cast<unsigned long long>(entry.size));
+    }
+    printf("%s: %u images, %zu bytes\n", archivePath, archive.count, archive.file.size);
+    closeAssetArchive(archive);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/*
+ * Fixed pool of worker threads for data-parallel loops
+ * parallelFor hands out task indices from an atomic counter to the workers and
+ * the calling thread, and returns once every task has run. Workers sleep on a
+ * condition variable between loops, so an idle pool costs nothing.
+ */
+
+#ifndef DENGUE_WORKER_POOL_H
+#define DENGUE_WORKER_POOL_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct WorkerPool {
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;  // A new loop started, or the pool is stopping
+    std::condition_variable done;  // The last worker left the current loop
+    void (*run)(void* context, size_t task);
+    void* context;
+    size_t taskCount;
+    std::atomic<size_t> nextTask;
+    size_t activeWorkers;          // Workers still inside the current loop
+    unsigned long long generation; // Loops started so far
+    bool stopping;
+};
+
+// Claim and run tasks of the current loop until none are left
+inline void runPoolTasks(WorkerPool& pool) {
+    size_t task;
+    while((task = pool.nextTask.fetch_add(1, std::memory_order_relaxed)) < pool.taskCount) {
+        pool.run(pool.context, task);
+    }
+}
+
+inline void workerPoolThread(WorkerPool* pool) {
+    unsigned long long seen = 0;
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->wake.wait(lock, [&] { return pool->stopping || pool->generation != seen; });
+            if(pool->stopping) return;
+            seen = pool->generation;
+        }
+        runPoolTasks(*pool);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if(--pool->activeWorkers == 0) pool->done.notify_one();
+    }
+}
+
+// Start workers; loops also run on the calling thread, so 0 workers is serial
+inline void startWorkerPool(WorkerPool& pool, unsigned workers) {
+    pool.run = NULL;
+    pool.context = NULL;
+    pool.taskCount = 0;
+    pool.nextTask.store(0);
+    pool.activeWorkers = 0;
+    pool.generation = 0;
+    pool.stopping = false;
+    for(unsigned i = 0; i < workers; i++) {
+        pool.threads.push_back(std::thread(workerPoolThread, &pool));
+    }
+}
+
+inline void stopWorkerPool(WorkerPool& pool) {
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stopping = true;
+    }
+    pool.wake.notify_all();
+    for(std::thread& thread : pool.threads) thread.join();
+    pool.threads.clear();
+}
+
+// Worker count that leaves one hardware thread for the caller
+inline unsigned defaultWorkerCount() {
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+template<typename Body>
+void runPoolBody(void* context, size_t task) {
+    (*static_cast<const Body*>(context))(task);
+}
+
+// Call body(i) for every i in [0, count) across the pool, in no particular order
+template<typename Body>
+void parallelFor(WorkerPool& pool, size_t count, const Body& body) {
+    if(pool.threads.empty() || count <= 1) {
+        for(size_t i = 0; i < count; i++) body(i);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.run = runPoolBody<Body>;
+        pool.context = const_cast<Body*>(&body);
+        pool.taskCount = count;
+        pool.nextTask.store(0, std::memory_order_relaxed);
+        pool.activeWorkers = pool.threads.size();
+        pool.generation++;
+    }
+    pool.wake.notify_all();
+    runPoolTasks(pool);
+
+    // Workers may still be finishing a task that references body
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.done.wait(lock, [&] { return pool.activeWorkers == 0; });
+}
+
+#endif